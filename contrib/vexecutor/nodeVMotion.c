@@ -319,11 +319,17 @@ TupleTableSlot *execVMotionUnsortedReceiver(MotionState * node)
 
     /* store it in our result slot and return this. */
     slot = node->ps.ps_ResultTupleSlot;
-    bool succ = tbDeserialization(((MemTuple)tuple)->PRIVATE_mt_bits,&slot->PRIVATE_tb);
+    unsigned char *buffer = tbDecompress((MemTuple)tuple);
+    bool succ = tbDeserialization(buffer,&slot->PRIVATE_tb);
 
     if(!succ)
         elog(ERROR,"Deserialization process Failed");
 
+    /* the columns are copied into the TupleBatch of the slot */
+    if (buffer != ((MemTuple)tuple)->PRIVATE_mt_bits)
+        pfree(buffer);
+    pfree(tuple);
+
     TupSetVirtualTupleNValid(slot, ((TupleBatch)slot->PRIVATE_tb)->ncols);
     return slot;
 }
@@ -358,6 +364,18 @@ SendTupleBatch(MotionLayerState *mlStates,
 
     MemTuple tuple = tbSerialization(tuplebatch);
 
+    /* column blocks of a batch usually compress well, trade cpu for network */
+    if (vmotion_compress_enable)
+    {
+        MemTuple compressed = tbCompress(tuple);
+
+        if (compressed)
+        {
+            pfree(tuple);
+            tuple = compressed;
+        }
+    }
+
     if (targetRoute != BROADCAST_SEGIDX)
     {
         struct directTransportBuffer b;
@@ -372,6 +390,7 @@ SendTupleBatch(MotionLayerState *mlStates,
             if (sent > 0)
             {
                 putTransportDirectBuffer(transportStates, motNodeID, targetRoute, sent);
+                pfree(tuple);
 
                 tcList.num_chunks = 1;
                 tcList.serialized_data_length = sent;
@@ -35,6 +35,9 @@
 #include "utils/tuplesort_mk.h"
 #include "utils/memutils.h"
 
+/* compress the TupleBatches sent by motions with LZ4 */
+extern bool vmotion_compress_enable;
+
 extern TupleTableSlot *ExecVMotionVirtualLayer(MotionState *node);
 #endif
 
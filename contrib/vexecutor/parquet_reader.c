@@ -90,7 +90,8 @@ parquet_vgetnext(ParquetScanDesc scan, ScanDirection direction, TupleTableSlot *
 /*
  * Get next tuple batch from current row group into slot.
  *
- * Return the number of tuples fetch out.
+ * Return the number of tuples fetch out, which may be less than the batch
+ * size as a batch stops at the data page boundaries of the columns.
  */
 static int
 ParquetRowGroupReader_ScanNextTupleBatch(
@@ -102,29 +103,11 @@ ParquetRowGroupReader_ScanNextTupleBatch(
 {
 	Assert(slot);
 
-	if (rowGroupReader->rowRead >= rowGroupReader->rowCount)
-	{
-		ParquetRowGroupReader_FinishedScanRowGroup(rowGroupReader);
-		return 0;
-	}
-
-	/*
-	 * get the next item (tuple) from the row group
-	 */
 	int ncol = slot->tts_tupleDescriptor->natts;
 	TupleBatch tb = (TupleBatch )slot->PRIVATE_tb;
+	Datum **values = (Datum **) palloc0(tb->ncols * sizeof(Datum *));
+	bool **nulls = (bool **) palloc0(tb->ncols * sizeof(bool *));
 
-	tb->nrows = 0;
-	if (rowGroupReader->rowRead + tb->batchsize > rowGroupReader->rowCount) {
-		tb->nrows = rowGroupReader->rowCount-rowGroupReader->rowRead;
-		rowGroupReader->rowRead = rowGroupReader->rowCount;
-	}
-	else {
-		tb->nrows = tb->batchsize ;
-		rowGroupReader->rowRead += tb->batchsize;
-	}
-
-	int colReaderIndex = 0;
 	for(int i = 0; i < tb->ncols ; i++)
 	{
 		if(projs[i] == false)
@@ -134,59 +117,29 @@ ParquetRowGroupReader_ScanNextTupleBatch(
 		if(!tb->datagroup[i])
 			tbCreateColumn(tb,i,hawqTypeID);
 
+		values[i] = tb->datagroup[i]->values;
+		nulls[i] = tb->datagroup[i]->isnull;
+	}
 
-		vtype* vt = tb->datagroup[i];
-		vt->dim = tb->nrows;
-
-
-		ParquetColumnReader *nextReader =
-			&rowGroupReader->columnReaders[colReaderIndex];
-
-		for(int j = 0;j < tb->nrows; j++)
-		{
-
-			if(hawqAttrToParquetColNum[i] == 1)
-			{
-				ParquetColumnReader_readValue(nextReader, vt->values + j , vt->isnull + j, hawqTypeID);
-			}
-			else
-			{
-				/*
-				 * Because there are some memory reused inside the whole column reader, so need
-				 * to switch the context from PerTupleContext to rowgroup->context
-				 */
-				MemoryContext oldContext = MemoryContextSwitchTo(rowGroupReader->memoryContext);
-
-				switch(hawqTypeID)
-				{
-					case HAWQ_TYPE_POINT:
-						ParquetColumnReader_readPoint(nextReader, vt->values + j, vt->isnull + j);
-						break;
-					case HAWQ_TYPE_PATH:
-						ParquetColumnReader_readPATH(nextReader, vt->values + j, vt->isnull + j);
-						break;
-					case HAWQ_TYPE_LSEG:
-						ParquetColumnReader_readLSEG(nextReader, vt->values + j, vt->isnull + j);
-						break;
-					case HAWQ_TYPE_BOX:
-						ParquetColumnReader_readBOX(nextReader, vt->values + j, vt->isnull + j);
-						break;
-					case HAWQ_TYPE_CIRCLE:
-						ParquetColumnReader_readCIRCLE(nextReader, vt->values + j, vt->isnull + j);
-						break;
-					case HAWQ_TYPE_POLYGON:
-						ParquetColumnReader_readPOLYGON(nextReader, vt->values + j, vt->isnull + j);
-						break;
-					default:
-						Insist(false);
-						break;
-				}
-
-				MemoryContextSwitchTo(oldContext);
-			}
-		}
+	/* decode column arrays of the batch straight into the vtypes */
+	tb->nrows = ParquetRowGroupReader_ScanNextBatch(tupDesc,
+													rowGroupReader,
+													hawqAttrToParquetColNum,
+													projs,
+													tb->ncols,
+													tb->batchsize,
+													values,
+													nulls);
+	pfree(values);
+	pfree(nulls);
+	if (tb->nrows == 0)
+		return 0;
 
-		colReaderIndex += hawqAttrToParquetColNum[i];
+	for(int i = 0; i < tb->ncols ; i++)
+	{
+		if(projs[i] == false)
+			continue;
+		tb->datagroup[i]->dim = tb->nrows;
 	}
 
 	/*construct tuple, and return back*/
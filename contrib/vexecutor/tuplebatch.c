@@ -17,8 +17,16 @@
  * under the License.
  */
 #include "postgres.h"
+#include <lz4.h>
 #include "tuplebatch.h"
 
+/*
+ * A compressed TupleBatch starts with the length of the serialized
+ * TupleBatch, with this bit set, and the length of the compressed data.
+ */
+#define TB_COMPRESSED_FLAG ((size_t) 1 << (sizeof(size_t) * 8 - 1))
+#define TB_COMPRESSED_HDRSZ (sizeof(size_t) + sizeof(int))
+
 TupleBatch tbGenerate(int colnum,int batchsize)
 {
     Assert(colnum > 0 && batchsize > 0);
@@ -106,8 +114,9 @@ tbSerialization(TupleBatch tb )
     size_t tmplen = 0;
     //calculate total size for TupleBatch
     size_t size = tbSerializationSize(tb);
-    //makes buffer length about 8-bytes alignment for motion
-    size = (size + 0x8) & (~0x7);
+    //makes buffer length about 8-bytes alignment for motion,
+    //the serialized data starts after the length of the MemTuple
+    size = (size + offsetof(MemTupleData, PRIVATE_mt_bits) + 0x8) & (~0x7);
 
     ret = palloc0(size);
     unsigned char *buffer = ret->PRIVATE_mt_bits;
@@ -191,11 +200,11 @@ bool tbDeserialization(unsigned char *buffer,TupleBatch* pTB )
     {
         int colid;
         tmplen = sizeof(vtype*) * tb->ncols;
-        //the buffer length is 8-bytes alignment, 
-        //so we need align the current length before comparing.
+        //the buffer length is 8-bytes alignment,
+        //so the padding after the last column is smaller than a column.
         if(!tb->datagroup)
             tb->datagroup = palloc0(tmplen);
-        while (((len + 0x8) & (~0x7)) < buflen)
+        while (len + sizeof(int) + VTYPESIZE(tb->nrows) <= buflen - offsetof(MemTupleData, PRIVATE_mt_bits))
         {
             memcpy(&colid,buffer + len,sizeof(int));
             len += sizeof(int);
@@ -217,3 +226,66 @@ bool tbDeserialization(unsigned char *buffer,TupleBatch* pTB )
     *pTB = tb;
     return true;
 }
+
+/*
+ * Compress a serialized TupleBatch with LZ4. Returns NULL if it does not
+ * get smaller.
+ */
+MemTuple
+tbCompress(MemTuple serialized)
+{
+    MemTuple ret;
+    unsigned char *buffer;
+    int rawlen = memtuple_get_size(serialized, NULL) - offsetof(MemTupleData, PRIVATE_mt_bits);
+    int bound = LZ4_compressBound(rawlen);
+    size_t size = offsetof(MemTupleData, PRIVATE_mt_bits) + TB_COMPRESSED_HDRSZ + bound;
+    size_t flaglen = TB_COMPRESSED_FLAG | rawlen;
+    int complen;
+
+    ret = palloc0((size + 0x8) & (~0x7));
+    buffer = ret->PRIVATE_mt_bits;
+
+    complen = LZ4_compress_default((const char *) serialized->PRIVATE_mt_bits,
+                                   (char *) buffer + TB_COMPRESSED_HDRSZ, rawlen, bound);
+    if (complen <= 0 || TB_COMPRESSED_HDRSZ + complen >= rawlen)
+    {
+        pfree(ret);
+        return NULL;
+    }
+
+    memcpy(buffer, &flaglen, sizeof(size_t));
+    memcpy(buffer + sizeof(size_t), &complen, sizeof(int));
+
+    //keep the 8-bytes alignment of the uncompressed TupleBatch
+    size = (offsetof(MemTupleData, PRIVATE_mt_bits) + TB_COMPRESSED_HDRSZ + complen + 0x8) & (~0x7);
+    memtuple_set_size(ret, NULL, size);
+    return ret;
+}
+
+/*
+ * Get the serialized TupleBatch from a received MemTuple, decompressing it
+ * into a new buffer if it was compressed by tbCompress.
+ */
+unsigned char *
+tbDecompress(MemTuple tuple)
+{
+    unsigned char *buffer = tuple->PRIVATE_mt_bits;
+    unsigned char *ret;
+    size_t flaglen;
+    int rawlen;
+    int complen;
+
+    memcpy(&flaglen, buffer, sizeof(size_t));
+    if (!(flaglen & TB_COMPRESSED_FLAG))
+        return buffer;
+
+    rawlen = flaglen & ~TB_COMPRESSED_FLAG;
+    memcpy(&complen, buffer + sizeof(size_t), sizeof(int));
+
+    ret = palloc(rawlen);
+    if (LZ4_decompress_safe((const char *) buffer + TB_COMPRESSED_HDRSZ, (char *) ret,
+                            complen, rawlen) != rawlen)
+        elog(ERROR, "TupleBatch decompression failed");
+
+    return ret;
+}
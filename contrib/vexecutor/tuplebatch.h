@@ -78,5 +78,9 @@ void tbfreeColumn(vtype** vh,int colid);
 MemTuple tbSerialization(TupleBatch tb);
 /* TupleBatch deserialization function */
 bool tbDeserialization(unsigned char *buffer,TupleBatch* pTB);
+/* compress a serialized TupleBatch, NULL if it does not get smaller */
+MemTuple tbCompress(MemTuple serialized);
+/* get the serialized TupleBatch from a received tuple, decompressing it if needed */
+unsigned char *tbDecompress(MemTuple tuple);
 
 #endif
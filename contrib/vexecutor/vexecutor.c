@@ -39,6 +39,7 @@ PG_MODULE_MAGIC;
 int BATCHSIZE = 1024;
 static int MINBATCHSIZE = 1;
 static int MAXBATCHSIZE = 4096;
+bool vmotion_compress_enable = false;
 /*
  * hook function
  */
@@ -80,6 +81,13 @@ _PG_init(void)
                             MINBATCHSIZE,MAXBATCHSIZE,
 							PGC_USERSET,
 							NULL,NULL);
+
+	DefineCustomBoolVariable("vectorized_motion_compress",
+	                         gettext_noop("compress the tuple batches sent by vectorized motions with LZ4"),
+	                         NULL,
+	                         &vmotion_compress_enable,
+	                         PGC_USERSET,
+	                         NULL,NULL);
 }
 
 /*
@@ -297,7 +297,7 @@ class TimestampVector : public Vector {
     Timestamp value;
 
     if (!null) {
-      value = TimestampType::fromString(strValue);
+      value = TimestampType::fromBuffer(strValue.data(), strValue.size());
     }
 
     append(reinterpret_cast<char *>(&value), sizeof(int64_t) + sizeof(int64_t),
@@ -21,8 +21,8 @@
 
 #include <algorithm>
 #include <string>
-#include <tuple>
 #include <utility>
+#include <vector>
 
 #include "dbcommon/common/vector-transformer.h"
 #include "dbcommon/common/vector.h"
@@ -280,6 +280,164 @@ double inline timestamp_extract(Timestamp *timestamp, const char *strVal,
   return ret;
 }
 
+// Civil fields of all the rows in a timestamp vector, decomposed once per
+// batch by the vectorized TimestampType::extract{Date,Time}Batch and shared
+// by every EXTRACT, DATE_PART and DATE_TRUNC unit below
+struct TimestampFields {
+  TimestampFields(const TimestampVectorRawData &ts, bool withDate,
+                  bool withTime) {
+    if (withDate) {
+      year.resize(ts.plainSize);
+      month.resize(ts.plainSize);
+      day.resize(ts.plainSize);
+      TimestampType::extractDateBatch(ts.seconds, ts.plainSize, year.data(),
+                                      month.data(), day.data());
+    }
+    if (withTime) {
+      hour.resize(ts.plainSize);
+      minute.resize(ts.plainSize);
+      second.resize(ts.plainSize);
+      TimestampType::extractTimeBatch(ts.seconds, ts.plainSize, hour.data(),
+                                      minute.data(), second.data());
+    }
+  }
+
+  static bool needDate(DatetimeKind kind) {
+    return kind != EPOCH && kind < HOUR;
+  }
+
+  static bool needTime(DatetimeKind kind) { return kind >= HOUR; }
+
+  double extract(DatetimeKind kind, uint64_t i, int64_t seconds,
+                 int64_t nanosecond) const {
+    switch (kind) {
+      case EPOCH:
+        return TimestampType::extractEpoch(seconds, nanosecond);
+      case MILLENNIUM:
+        return year[i] > 0 ? (year[i] + 999) / 1000
+                           : -((999 - (year[i] - 1)) / 1000);
+      case CENTURY:
+        return year[i] > 0 ? (year[i] + 99) / 100
+                           : -((99 - (year[i] - 1)) / 100);
+      case DECADE:
+        return year[i] >= 0 ? year[i] / 10 : -((8 - (year[i] - 1)) / 10);
+      case YEAR:
+        return year[i] <= 0 ? year[i] - 1 : year[i];
+      case QUARTER:
+        return (month[i] - 1) / 3 + 1;
+      case MONTH:
+        return month[i];
+      case WEEK:
+        return TimestampType::countWeek(year[i], month[i], day[i]);
+      case DAY:
+        return day[i];
+      case DOW:
+        return (TimestampType::date2j(year[i], month[i], day[i]) + 1) % 7;
+      case DOY:
+        return TimestampType::date2j(year[i], month[i], day[i]) -
+               TimestampType::date2j(year[i], 1, 1) + 1;
+      case HOUR:
+        return hour[i];
+      case MINUTE:
+        return minute[i];
+      case SECOND:
+        return static_cast<double>(second[i]) +
+               static_cast<double>(nanosecond) / 1000000000.0;
+      case MILLISEC:
+        return static_cast<double>(second[i]) * 1000 +
+               static_cast<double>(nanosecond) / 1000000.0;
+      default:
+        assert(kind == MICROSEC);
+        return static_cast<double>(second[i]) * 1000000 +
+               static_cast<double>(nanosecond) / 1000.0;
+    }
+  }
+
+  Timestamp trunc(DatetimeKind kind, uint64_t i, int64_t nanosecond) const {
+    Timestamp ret;
+    int32_t y = year[i];
+    switch (kind) {
+      case MILLENNIUM:
+        y = y > 0 ? ((y + 999) / 1000) * 1000 - 999
+                  : -((999 - (y - 1)) / 1000) * 1000 + 1;
+        TimestampType::timestamp_trunc(&ret, y, 1, 1, 0, 0, 0, 0);
+        break;
+      case CENTURY:
+        y = y > 0 ? ((y + 99) / 100) * 100 - 99
+                  : -((99 - (y - 1)) / 100) * 100 + 1;
+        TimestampType::timestamp_trunc(&ret, y, 1, 1, 0, 0, 0, 0);
+        break;
+      case DECADE:
+        y = y > 0 ? (y / 10) * 10 : -((8 - (y - 1)) / 10) * 10;
+        TimestampType::timestamp_trunc(&ret, y, 1, 1, 0, 0, 0, 0);
+        break;
+      case YEAR:
+        TimestampType::timestamp_trunc(&ret, y, 1, 1, 0, 0, 0, 0);
+        break;
+      case QUARTER:
+        TimestampType::timestamp_trunc(&ret, y, (3 * ((month[i] - 1) / 3)) + 1,
+                                       1, 0, 0, 0, 0);
+        break;
+      case MONTH:
+        TimestampType::timestamp_trunc(&ret, y, month[i], 1, 0, 0, 0, 0);
+        break;
+      case WEEK: {
+        int32_t m = month[i], d = day[i];
+        int32_t woy = static_cast<int32_t>(TimestampType::countWeek(y, m, d));
+        if (woy >= 52 && m == 1) --y;
+        if (woy <= 1 && m == 12) ++y;
+        TimestampType::isoweek2date(woy, &y, &m, &d);
+        TimestampType::timestamp_trunc(&ret, y, m, d, 0, 0, 0, 0);
+        break;
+      }
+      case DAY:
+        TimestampType::timestamp_trunc(&ret, y, month[i], day[i], 0, 0, 0, 0);
+        break;
+      case HOUR:
+        TimestampType::timestamp_trunc(&ret, y, month[i], day[i], hour[i], 0,
+                                       0, 0);
+        break;
+      case MINUTE:
+        TimestampType::timestamp_trunc(&ret, y, month[i], day[i], hour[i],
+                                       minute[i], 0, 0);
+        break;
+      case SECOND:
+        TimestampType::timestamp_trunc(&ret, y, month[i], day[i], hour[i],
+                                       minute[i], second[i], 0);
+        break;
+      case MILLISEC:
+        TimestampType::timestamp_trunc(&ret, y, month[i], day[i], hour[i],
+                                       minute[i], second[i],
+                                       (nanosecond / 1000000) * 1000000);
+        break;
+      default:
+        assert(kind == MICROSEC);
+        TimestampType::timestamp_trunc(&ret, y, month[i], day[i], hour[i],
+                                       minute[i], second[i],
+                                       (nanosecond / 1000) * 1000);
+    }
+    return ret;
+  }
+
+  std::vector<int32_t> year, month, day;
+  std::vector<int32_t> hour, minute, second;
+};
+
+// @return The unit named by strVal, raise an error when it is unknown or,
+// for DATE_TRUNC, cannot be truncated to
+inline DatetimeKind getDatetimeKind(const char *strVal, uint32_t length,
+                                    bool forTrunc) {
+  uint32_t validLen =
+      length <= TIMESTAMP_FIELD_MAXLEN ? length : TIMESTAMP_FIELD_MAXLEN;
+  std::string field(strVal, validLen);
+  DatetimeKind kind = DatetimeTable::getDatetimeKindByName(field);
+  if (kind == UNDEFINED ||
+      (forTrunc && (kind == EPOCH || kind == DOW || kind == DOY)))
+    LOG_ERROR(ERRCODE_FEATURE_NOT_SUPPORTED,
+              "timestamp units \"%s\" not recognized", field.c_str());
+  return kind;
+}
+
 Datum extract_subfield_vec_timestamp_vec(Datum *params, uint64_t size) {
   Vector *retVector = params[0];
   Vector *subfieldVector = params[1];
@@ -292,11 +450,13 @@ Datum extract_subfield_vec_timestamp_vec(Datum *params, uint64_t size) {
                     subfield.nulls);
   FixedSizeTypeVectorRawData<double> ret(retVector);
 
-  uint64_t bufferSize = 0;
+  TimestampFields fields(timestamp, true, true);
   auto extract = [&](uint64_t plainIdx) {
-    Timestamp ts(timestamp.seconds[plainIdx], timestamp.nanoseconds[plainIdx]);
-    ret.values[plainIdx] = timestamp_extract(&ts, subfield.valptrs[plainIdx],
-                                             subfield.lengths[plainIdx]);
+    DatetimeKind kind = getDatetimeKind(subfield.valptrs[plainIdx],
+                                        subfield.lengths[plainIdx], false);
+    ret.values[plainIdx] =
+        fields.extract(kind, plainIdx, timestamp.seconds[plainIdx],
+                       timestamp.nanoseconds[plainIdx]);
   };
   dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, extract);
 
@@ -338,212 +498,17 @@ Datum extract_subfield_val_timestamp_vec(Datum *params, uint64_t size) {
   retVector->resize(timestamp.plainSize, timestamp.sel, timestamp.nulls);
   FixedSizeTypeVectorRawData<double> ret(retVector);
 
-  uint32_t validLen = subfieldScalar->length <= TIMESTAMP_FIELD_MAXLEN
-                          ? subfieldScalar->length
-                          : TIMESTAMP_FIELD_MAXLEN;
-  std::string field =
-      std::string(DatumGetValue<const char *>(subfieldScalar->value), validLen);
-
-  switch (DatetimeTable::getDatetimeKindByName(field)) {
-    case EPOCH: {
-      auto doExtractEpoch = [&](uint64_t plainIdx) {
-        ret.values[plainIdx] = TimestampType::extractEpoch(
-            timestamp.seconds[plainIdx], timestamp.nanoseconds[plainIdx]);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractEpoch);
-      break;
-    }
-    case MILLENNIUM: {
-      auto doExtractMillennium = [&](uint64_t plainIdx) {
-        int32_t year, month, day, millennium;
-        TimestampType::extractDate(timestamp.seconds[plainIdx], &year, &month,
-                                   &day);
-        if (year > 0)
-          millennium = (year + 999) / 1000;
-        else
-          millennium = -((999 - (year - 1)) / 1000);
-        ret.values[plainIdx] = static_cast<double>(millennium);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractMillennium);
-      break;
-    }
-    case CENTURY: {
-      auto doExtractCentury = [&](uint64_t plainIdx) {
-        int32_t year, month, day, century;
-        TimestampType::extractDate(timestamp.seconds[plainIdx], &year, &month,
-                                   &day);
-        if (year > 0)
-          century = (year + 99) / 100;
-        else
-          century = -((99 - (year - 1)) / 100);
-        ret.values[plainIdx] = static_cast<double>(century);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractCentury);
-      break;
-    }
-    case DECADE: {
-      auto doExtractDecade = [&](uint64_t plainIdx) {
-        int32_t year, month, day, decade;
-        TimestampType::extractDate(timestamp.seconds[plainIdx], &year, &month,
-                                   &day);
-        if (year >= 0)
-          decade = year / 10;
-        else
-          decade = -((8 - (year - 1)) / 10);
-        ret.values[plainIdx] = static_cast<double>(decade);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractDecade);
-      break;
-    }
-    case YEAR: {
-      auto doExtractYear = [&](uint64_t plainIdx) {
-        int32_t year, month, day;
-        TimestampType::extractDate(timestamp.seconds[plainIdx], &year, &month,
-                                   &day);
-        if (year <= 0) year--;
-        ret.values[plainIdx] = static_cast<double>(year);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractYear);
-      break;
-    }
-    case QUARTER: {
-      auto doExtractQuarter = [&](uint64_t plainIdx) {
-        int32_t year, month, day, quarter;
-        TimestampType::extractDate(timestamp.seconds[plainIdx], &year, &month,
-                                   &day);
-        quarter = (month - 1) / 3 + 1;
-        ret.values[plainIdx] = static_cast<double>(quarter);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractQuarter);
-      break;
-    }
-    case MONTH: {
-      auto doExtractMonth = [&](uint64_t plainIdx) {
-        int32_t year, month, day;
-        TimestampType::extractDate(timestamp.seconds[plainIdx], &year, &month,
-                                   &day);
-        ret.values[plainIdx] = static_cast<double>(month);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractMonth);
-      break;
-    }
-    case WEEK: {
-      auto doExtractWeek = [&](uint64_t plainIdx) {
-        int32_t year, month, day;
-        TimestampType::extractDate(timestamp.seconds[plainIdx], &year, &month,
-                                   &day);
-        if (year <= 0) year--;
-        double week = TimestampType::countWeek(year, month, day);
-        ret.values[plainIdx] = static_cast<double>(week);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractWeek);
-      break;
-    }
-    case DAY: {
-      auto doExtractDay = [&](uint64_t plainIdx) {
-        int32_t year, month, day;
-        TimestampType::extractDate(timestamp.seconds[plainIdx], &year, &month,
-                                   &day);
-        ret.values[plainIdx] = static_cast<double>(day);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractDay);
-      break;
-    }
-    case DOW: {
-      auto doExtractDow = [&](uint64_t plainIdx) {
-        ret.values[plainIdx] =
-            TimestampType::extractDow(timestamp.seconds[plainIdx]);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractDow);
-      break;
-    }
-    case DOY: {
-      auto doExtractDoy = [&](uint64_t plainIdx) {
-        ret.values[plainIdx] =
-            TimestampType::extractDoy(timestamp.seconds[plainIdx]);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractDoy);
-      break;
-    }
-    case HOUR: {
-      auto doExtractHour = [&](uint64_t plainIdx) {
-        int32_t hour2, minute2, second2;
-        TimestampType::extractTime(timestamp.seconds[plainIdx], &hour2,
-                                   &minute2, &second2);
-        ret.values[plainIdx] = static_cast<double>(hour2);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractHour);
-      break;
-    }
-    case MINUTE: {
-      auto doExtractMinute = [&](uint64_t plainIdx) {
-        int32_t hour2, minute2, second2;
-        TimestampType::extractTime(timestamp.seconds[plainIdx], &hour2,
-                                   &minute2, &second2);
-        ret.values[plainIdx] = static_cast<double>(minute2);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractMinute);
-      break;
-    }
-    case SECOND: {
-      auto doExtractSecond = [&](uint64_t plainIdx) {
-        int32_t hour2, minute2, second2;
-        TimestampType::extractTime(timestamp.seconds[plainIdx], &hour2,
-                                   &minute2, &second2);
-        double second_new =
-            static_cast<double>(second2) +
-            static_cast<double>(timestamp.nanoseconds[plainIdx]) / 1000000000.0;
-        ret.values[plainIdx] = static_cast<double>(second_new);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractSecond);
-      break;
-    }
-    case MILLISEC: {
-      auto doExtractMillisec = [&](uint64_t plainIdx) {
-        int32_t hour2, minute2, second2;
-        TimestampType::extractTime(timestamp.seconds[plainIdx], &hour2,
-                                   &minute2, &second2);
-        double milliseconds =
-            static_cast<double>(second2) * 1000 +
-            static_cast<double>(timestamp.nanoseconds[plainIdx]) / 1000000.0;
-        ret.values[plainIdx] = static_cast<double>(milliseconds);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractMillisec);
-      break;
-    }
-    case MICROSEC: {
-      auto doExtractMicrosec = [&](uint64_t plainIdx) {
-        int32_t hour2, minute2, second2;
-        TimestampType::extractTime(timestamp.seconds[plainIdx], &hour2,
-                                   &minute2, &second2);
-        double microseconds =
-            static_cast<double>(second2) * 1000000 +
-            static_cast<double>(timestamp.nanoseconds[plainIdx]) / 1000.0;
-        ret.values[plainIdx] = static_cast<double>(microseconds);
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls,
-                                doExtractMicrosec);
-      break;
-    }
-    default:
-      LOG_ERROR(ERRCODE_FEATURE_NOT_SUPPORTED,
-                "timestamp units \"%s\" not recognized", field.c_str());
-  }
+  DatetimeKind kind =
+      getDatetimeKind(DatumGetValue<const char *>(subfieldScalar->value),
+                      subfieldScalar->length, false);
+  TimestampFields fields(timestamp, TimestampFields::needDate(kind),
+                         TimestampFields::needTime(kind));
+  auto extract = [&](uint64_t plainIdx) {
+    ret.values[plainIdx] =
+        fields.extract(kind, plainIdx, timestamp.seconds[plainIdx],
+                       timestamp.nanoseconds[plainIdx]);
+  };
+  dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, extract);
 
   return params[0];
 }
@@ -627,108 +592,6 @@ Timestamp inline timestamp_trunc(Timestamp *timestamp, const char *strVal,
   }
   return ret;
 }
-inline int32_t truncYear(int64_t second) {
-  int32_t days = (int32_t)(second / SECONDS_PER_DAY);
-  if (second < 0) days -= 1;
-  int32_t jd = days + UNIX_EPOCH_JDATE;
-  uint32_t julian;
-  uint32_t quad;
-  uint32_t extra;
-  int32_t y, year;
-
-  julian = jd;
-  julian += 32044;
-  quad = julian / 146097;
-  extra = (julian - quad * 146097) * 4 + 3;
-  julian += 60 + quad * 3 + extra / 146097;
-  quad = julian / 1461;
-  julian -= quad * 1461;
-  y = julian * 4 / 1461;
-  julian = ((y != 0) ? ((julian + 305) % 365) : ((julian + 306) % 366)) + 123;
-  y += quad * 4;
-  year = y - 4800;
-  return year;
-}
-
-inline std::tuple<int32_t, int32_t> truncMonth(int64_t second) {
-  int32_t days = (int32_t)(second / SECONDS_PER_DAY);
-  if (second < 0) days -= 1;
-  int32_t jd = days + UNIX_EPOCH_JDATE;
-  uint32_t julian;
-  uint32_t quad;
-  uint32_t extra;
-  int32_t y, year, month;
-
-  julian = jd;
-  julian += 32044;
-  quad = julian / 146097;
-  extra = (julian - quad * 146097) * 4 + 3;
-  julian += 60 + quad * 3 + extra / 146097;
-  quad = julian / 1461;
-  julian -= quad * 1461;
-  y = julian * 4 / 1461;
-  julian = ((y != 0) ? ((julian + 305) % 365) : ((julian + 306) % 366)) + 123;
-  y += quad * 4;
-  year = y - 4800;
-  quad = julian * 2141 / 65536;
-  month = (quad + 10) % 12 + 1;
-  return std::make_tuple(year, month);
-}
-inline std::tuple<int32_t, int32_t, int32_t> truncDay(int64_t second) {
-  int32_t days = (int32_t)(second / SECONDS_PER_DAY);
-  if (second < 0) days -= 1;
-  int32_t jd = days + UNIX_EPOCH_JDATE;
-  uint32_t julian;
-  uint32_t quad;
-  uint32_t extra;
-  int32_t y, year, month, day;
-
-  julian = jd;
-  julian += 32044;
-  quad = julian / 146097;
-  extra = (julian - quad * 146097) * 4 + 3;
-  julian += 60 + quad * 3 + extra / 146097;
-  quad = julian / 1461;
-  julian -= quad * 1461;
-  y = julian * 4 / 1461;
-  julian = ((y != 0) ? ((julian + 305) % 365) : ((julian + 306) % 366)) + 123;
-  y += quad * 4;
-  year = y - 4800;
-  quad = julian * 2141 / 65536;
-  month = (quad + 10) % 12 + 1;
-  day = julian - 7834 * quad / 256;
-  return std::make_tuple(year, month, day);
-}
-inline int32_t truncHour(int64_t second) {
-  int32_t hour;
-  int32_t second_rest = (int32_t)(second % SECONDS_PER_DAY);
-  hour = second_rest / 3600;
-  if (hour < 0) hour += 23;
-  return hour;
-}
-
-inline std::tuple<int32_t, int32_t> truncMinute(int64_t second) {
-  int32_t hour, minute;
-  int32_t second_rest = (int32_t)(second % SECONDS_PER_DAY);
-  hour = second_rest / 3600;
-  minute = (second_rest - (hour)*3600) / 60;
-  if (minute < 0) minute += 59;
-  if (hour < 0) hour += 23;
-  return std::make_tuple(hour, minute);
-}
-
-inline std::tuple<int32_t, int32_t, int32_t> truncSecond(int64_t second) {
-  int32_t hour, minute, second2;
-  int32_t second_rest = (int32_t)(second % SECONDS_PER_DAY);
-  hour = second_rest / 3600;
-  minute = (second_rest - (hour)*3600) / 60;
-  second2 = second_rest - (hour)*3600 - (minute)*60;
-  if (minute < 0) minute += 59;
-  if (hour < 0) hour += 23;
-  if (second2 < 0) second2 += 60;
-  return std::make_tuple(hour, minute, second2);
-}
-
 Datum trunc_subfield_vec_timestamp_vec(Datum *params, uint64_t size) {
   Vector *retVector = params[0];
   Vector *subfieldVector = params[1];
@@ -741,11 +604,12 @@ Datum trunc_subfield_vec_timestamp_vec(Datum *params, uint64_t size) {
                     subfield.nulls);
   TimestampVectorRawData ret(retVector);
 
-  uint64_t bufferSize = 0;
+  TimestampFields fields(timestamp, true, true);
   auto trunc = [&](uint64_t plainIdx) {
-    Timestamp ts(timestamp.seconds[plainIdx], timestamp.nanoseconds[plainIdx]);
-    Timestamp result = timestamp_trunc(&ts, subfield.valptrs[plainIdx],
-                                       subfield.lengths[plainIdx]);
+    DatetimeKind kind = getDatetimeKind(subfield.valptrs[plainIdx],
+                                        subfield.lengths[plainIdx], true);
+    Timestamp result =
+        fields.trunc(kind, plainIdx, timestamp.nanoseconds[plainIdx]);
     ret.seconds[plainIdx] = result.second;
     ret.nanoseconds[plainIdx] = result.nanosecond;
   };
@@ -791,203 +655,21 @@ Datum trunc_subfield_val_timestamp_vec(Datum *params, uint64_t size) {
   retVector->resize(timestamp.plainSize, timestamp.sel, timestamp.nulls);
   TimestampVectorRawData ret(retVector);
 
-  uint32_t validLen = subfieldScalar->length <= TIMESTAMP_FIELD_MAXLEN
-                          ? subfieldScalar->length
-                          : TIMESTAMP_FIELD_MAXLEN;
-  std::string field =
-      std::string(DatumGetValue<const char *>(subfieldScalar->value), validLen);
+  DatetimeKind kind =
+      getDatetimeKind(DatumGetValue<const char *>(subfieldScalar->value),
+                      subfieldScalar->length, true);
+  TimestampFields fields(timestamp, true, TimestampFields::needTime(kind));
+  auto trunc = [&](uint64_t plainIdx) {
+    Timestamp result =
+        fields.trunc(kind, plainIdx, timestamp.nanoseconds[plainIdx]);
+    ret.seconds[plainIdx] = result.second;
+    ret.nanoseconds[plainIdx] = result.nanosecond;
+  };
+  dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
 
-  switch (DatetimeTable::getDatetimeKindByName(field)) {
-    case MILLENNIUM: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year;
-        Timestamp result;
-        year = truncYear(timestamp.seconds[plainIdx]);
-        if (year > 0)
-          year = ((year + 999) / 1000) * 1000 - 999;
-        else
-          year = -((999 - (year - 1)) / 1000) * 1000 + 1;
-        TimestampType::timestamp_trunc(&result, year, 1, 1, 0, 0, 0, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case CENTURY: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year;
-        Timestamp result;
-        year = truncYear(timestamp.seconds[plainIdx]);
-        if (year > 0)
-          year = ((year + 99) / 100) * 100 - 99;
-        else
-          year = -((99 - (year - 1)) / 100) * 100 + 1;
-        TimestampType::timestamp_trunc(&result, year, 1, 1, 0, 0, 0, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case DECADE: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year;
-        Timestamp result;
-        year = truncYear(timestamp.seconds[plainIdx]);
-        if (year > 0)
-          year = (year / 10) * 10;
-        else
-          year = -((8 - (year - 1)) / 10) * 10;
-        TimestampType::timestamp_trunc(&result, year, 1, 1, 0, 0, 0, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case YEAR: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year;
-        Timestamp result;
-        year = truncYear(timestamp.seconds[plainIdx]);
-        TimestampType::timestamp_trunc(&result, year, 1, 1, 0, 0, 0, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case QUARTER: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year, month;
-        Timestamp result;
-        std::tie(year, month) = truncMonth(timestamp.seconds[plainIdx]);
-        month = (3 * ((month - 1) / 3)) + 1;
-        TimestampType::timestamp_trunc(&result, year, month, 1, 0, 0, 0, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case MONTH: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year, month;
-        Timestamp result;
-        std::tie(year, month) = truncMonth(timestamp.seconds[plainIdx]);
-        TimestampType::timestamp_trunc(&result, year, month, 1, 0, 0, 0, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case WEEK: {
-      auto trunc = [&](uint64_t plainIdx) {
-        Timestamp result;
-        result = TimestampType::truncWeek(timestamp.seconds[plainIdx]);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case DAY: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year, month, day;
-        Timestamp result;
-        std::tie(year, month, day) = truncDay(timestamp.seconds[plainIdx]);
-        TimestampType::timestamp_trunc(&result, year, month, day, 0, 0, 0, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case HOUR: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year, month, day, hour2;
-        Timestamp result;
-        std::tie(year, month, day) = truncDay(timestamp.seconds[plainIdx]);
-        hour2 = truncHour(timestamp.seconds[plainIdx]);
-        TimestampType::timestamp_trunc(&result, year, month, day, hour2, 0, 0,
-                                       0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case MINUTE: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year, month, day, hour2, minute2;
-        Timestamp result;
-        std::tie(year, month, day) = truncDay(timestamp.seconds[plainIdx]);
-        std::tie(hour2, minute2) = truncMinute(timestamp.seconds[plainIdx]);
-        TimestampType::timestamp_trunc(&result, year, month, day, hour2,
-                                       minute2, 0, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case SECOND: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year, month, day, hour2, minute2, second2;
-        Timestamp result;
-        std::tie(year, month, day) = truncDay(timestamp.seconds[plainIdx]);
-        std::tie(hour2, minute2, second2) =
-            truncSecond(timestamp.seconds[plainIdx]);
-        TimestampType::timestamp_trunc(&result, year, month, day, hour2,
-                                       minute2, second2, 0);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case MILLISEC: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year, month, day, hour2, minute2, second2;
-        int64_t nano;
-        Timestamp result;
-        std::tie(year, month, day) = truncDay(timestamp.seconds[plainIdx]);
-        std::tie(hour2, minute2, second2) =
-            truncSecond(timestamp.seconds[plainIdx]);
-        nano = (timestamp.nanoseconds[plainIdx] / 1000000) * 1000000;
-        TimestampType::timestamp_trunc(&result, year, month, day, hour2,
-                                       minute2, second2, nano);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    case MICROSEC: {
-      auto trunc = [&](uint64_t plainIdx) {
-        int32_t year, month, day, hour2, minute2, second2;
-        int64_t nano;
-        Timestamp result;
-        std::tie(year, month, day) = truncDay(timestamp.seconds[plainIdx]);
-        std::tie(hour2, minute2, second2) =
-            truncSecond(timestamp.seconds[plainIdx]);
-        nano = (timestamp.nanoseconds[plainIdx] / 1000) * 1000;
-        TimestampType::timestamp_trunc(&result, year, month, day, hour2,
-                                       minute2, second2, nano);
-        ret.seconds[plainIdx] = result.second;
-        ret.nanoseconds[plainIdx] = result.nanosecond;
-      };
-      dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, trunc);
-      break;
-    }
-    default:
-      LOG_ERROR(ERRCODE_FEATURE_NOT_SUPPORTED,
-                "timestamp units \"%s\" not recognized", field.c_str());
-  }
   return params[0];
 }
+
 Datum trunc_subfield_val_timestamp_val(Datum *params, uint64_t size) {
   Scalar *retScalar = params[0];
   Scalar *subfieldScalar = params[1];
@@ -1028,13 +710,15 @@ Datum timestamp_to_text(Datum *params, uint64_t size) {
     VariableSizeTypeVectorRawData ret(retVector);
 
     auto retBuffer = retVector->getValueBuffer();
+    retBuffer->resize(src.plainSize * TIMESTAMP_TEXT_MAXLEN);
+    char *bufferPtr = retBuffer->data();
     auto text = [&](uint64_t plainIdx) {
-      std::string str = TimestampType::timestamp2string(
-          src.seconds[plainIdx], src.nanoseconds[plainIdx]);
-      ret.lengths[plainIdx] = str.length();
-      retBuffer->append(str.data(), ret.lengths[plainIdx]);
+      ret.lengths[plainIdx] = TimestampType::timestamp2buffer(
+          src.seconds[plainIdx], src.nanoseconds[plainIdx], bufferPtr);
+      bufferPtr += ret.lengths[plainIdx];
     };
     dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, text);
+    retBuffer->resize(bufferPtr - retBuffer->data());
     retVector->computeValPtrs();
   } else {
     Scalar *retScalar = params[0];
@@ -1044,11 +728,109 @@ Datum timestamp_to_text(Datum *params, uint64_t size) {
     } else {
       retScalar->isnull = false;
       Timestamp *src = srcScalar->value;
-      std::string str =
-          TimestampType::timestamp2string(src->second, src->nanosecond);
-      auto ret_length = str.length();
-      char *ret = retScalar->allocateValue(ret_length);
-      strncpy(ret, str.data(), ret_length);
+      char *ret = retScalar->allocateValue(TIMESTAMP_TEXT_MAXLEN);
+      retScalar->length =
+          TimestampType::timestamp2buffer(src->second, src->nanosecond, ret);
+    }
+  }
+  return params[0];
+}
+
+Datum date_to_text(Datum *params, uint64_t size) {
+  assert(size == 2);
+  Object *para = params[1];
+  if (dynamic_cast<Vector *>(para)) {
+    Vector *retVector = params[0];
+    Vector *srcVector = params[1];
+
+    FixedSizeTypeVectorRawData<int32_t> src(srcVector);
+    retVector->resize(src.plainSize, src.sel, src.nulls);
+    VariableSizeTypeVectorRawData ret(retVector);
+
+    auto retBuffer = retVector->getValueBuffer();
+    retBuffer->resize(src.plainSize * DATE_TEXT_MAXLEN);
+    char *bufferPtr = retBuffer->data();
+    auto text = [&](uint64_t plainIdx) {
+      ret.lengths[plainIdx] =
+          DateType::date2buffer(src.values[plainIdx], bufferPtr);
+      bufferPtr += ret.lengths[plainIdx];
+    };
+    dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, text);
+    retBuffer->resize(bufferPtr - retBuffer->data());
+    retVector->computeValPtrs();
+  } else {
+    Scalar *retScalar = params[0];
+    Scalar *srcScalar = params[1];
+    if (srcScalar->isnull) {
+      retScalar->isnull = true;
+    } else {
+      retScalar->isnull = false;
+      char *ret = retScalar->allocateValue(DATE_TEXT_MAXLEN);
+      retScalar->length =
+          DateType::date2buffer(DatumGetValue<int32_t>(srcScalar->value), ret);
+    }
+  }
+  return params[0];
+}
+
+Datum text_to_timestamp(Datum *params, uint64_t size) {
+  assert(size == 2);
+  Object *para = params[1];
+  if (dynamic_cast<Vector *>(para)) {
+    Vector *retVector = params[0];
+    Vector *srcVector = params[1];
+
+    VariableSizeTypeVectorRawData src(srcVector);
+    retVector->resize(src.plainSize, src.sel, src.nulls);
+    TimestampVectorRawData ret(retVector);
+
+    auto cast = [&](uint64_t plainIdx) {
+      Timestamp ts = TimestampType::fromBuffer(src.valptrs[plainIdx],
+                                               src.lengths[plainIdx]);
+      ret.seconds[plainIdx] = ts.second;
+      ret.nanoseconds[plainIdx] = ts.nanosecond;
+    };
+    dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, cast);
+  } else {
+    Scalar *retScalar = params[0];
+    Scalar *srcScalar = params[1];
+    if (srcScalar->isnull) {
+      retScalar->isnull = true;
+    } else {
+      retScalar->isnull = false;
+      Timestamp *ret = retScalar->allocateValue<Timestamp>();
+      *ret = TimestampType::fromBuffer(
+          DatumGetValue<const char *>(srcScalar->value), srcScalar->length);
+    }
+  }
+  return params[0];
+}
+
+Datum text_to_date(Datum *params, uint64_t size) {
+  assert(size == 2);
+  Object *para = params[1];
+  if (dynamic_cast<Vector *>(para)) {
+    Vector *retVector = params[0];
+    Vector *srcVector = params[1];
+
+    VariableSizeTypeVectorRawData src(srcVector);
+    retVector->resize(src.plainSize, src.sel, src.nulls);
+    FixedSizeTypeVectorRawData<int32_t> ret(retVector);
+
+    auto cast = [&](uint64_t plainIdx) {
+      ret.values[plainIdx] =
+          DateType::fromBuffer(src.valptrs[plainIdx], src.lengths[plainIdx]);
+    };
+    dbcommon::transformVector(ret.plainSize, ret.sel, ret.nulls, cast);
+  } else {
+    Scalar *retScalar = params[0];
+    Scalar *srcScalar = params[1];
+    if (srcScalar->isnull) {
+      retScalar->isnull = true;
+    } else {
+      retScalar->isnull = false;
+      retScalar->value = CreateDatum<int32_t>(DateType::fromBuffer(
+          DatumGetValue<const char *>(srcScalar->value), srcScalar->length));
     }
   }
   return params[0];
@@ -84,6 +84,12 @@ Datum timestamp_date_trunc(Datum *params, uint64_t size);
 
 Datum timestamp_to_text(Datum *params, uint64_t size);
 
+Datum date_to_text(Datum *params, uint64_t size);
+
+Datum text_to_timestamp(Datum *params, uint64_t size);
+
+Datum text_to_date(Datum *params, uint64_t size);
+
 Datum time_sub_time(Datum *params, uint64_t size);
 
 Datum timestamp_sub_timestamp(Datum *params, uint64_t size);
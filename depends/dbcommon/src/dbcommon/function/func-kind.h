@@ -342,6 +342,12 @@ generate_func_kind(ARITH_OP, INTERVAL_TYPE, INTERVAL_TYPE)
   // random()
   RANDOMF,
 
+  // date/time casts from and to text, appended so that the ids of the
+  // kinds above, which planners pass as integers, do not change
+  DATE_TO_TEXT,
+  TEXT_TO_TIMESTAMP,
+  TEXT_TO_DATE,
+
   // Do nothing
   DONOTHING,
 
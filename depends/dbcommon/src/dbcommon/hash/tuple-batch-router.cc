@@ -0,0 +1,90 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include "dbcommon/hash/tuple-batch-router.h"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+
+namespace dbcommon {
+
+TupleBatchRouter::TupleBatchRouter(const TupleDesc &inputTupleDesc,
+                                   const std::vector<uint64_t> &keys,
+                                   int32_t segsNum)
+    : hasher_(inputTupleDesc, keys), segsNum_(segsNum) {
+  assert(segsNum > 0 && "invalid input");
+  hasher_.setSegsNum(segsNum);
+  counts_.resize(segsNum);
+  sels_.resize(segsNum);
+  capacities_.resize(segsNum, DEFAULT_NUMBER_TUPLES_PER_BATCH + 2);
+}
+
+const std::vector<uint64_t> &TupleBatchRouter::route(const TupleBatch *batch) {
+  return hasher_.cdbhash(batch);
+}
+
+const std::vector<SelectList> &TupleBatchRouter::partition(
+    const TupleBatch *batch) {
+  const std::vector<uint64_t> &targets = route(batch);
+  size_t size = targets.size();
+  size_t plainSize = batch->getNumOfRowsPlain();
+  const SelectList *selected = batch->getSelected();
+
+  // Counting sort: histogram the targets, then size each SelectList exactly
+  // and scatter the row indexes into it.
+  std::fill(counts_.begin(), counts_.end(), 0);
+  for (size_t i = 0; i < size; ++i) counts_[targets[i]]++;
+
+  for (int32_t t = 0; t < segsNum_; ++t) {
+    SelectList &sel = sels_[t];
+    if (counts_[t] > capacities_[t]) {
+      sel.reserve(counts_[t]);
+      capacities_[t] = counts_[t];
+    }
+    sel.clear();
+    sel.setPlainSize(plainSize);
+  }
+
+  if (selected) {
+    for (size_t i = 0; i < size; ++i)
+      sels_[targets[i]].push_back((*selected)[i]);
+  } else {
+    for (size_t i = 0; i < size; ++i)
+      sels_[targets[i]].push_back(static_cast<SelectList::value_type>(i));
+  }
+
+  return sels_;
+}
+
+std::vector<std::unique_ptr<TupleBatch>> TupleBatchRouter::redistribute(
+    const TupleBatch *batch) {
+  const std::vector<SelectList> &sels = partition(batch);
+
+  std::vector<std::unique_ptr<TupleBatch>> retval(segsNum_);
+  for (int32_t t = 0; t < segsNum_; ++t) {
+    // cloneSelected() treats an empty SelectList as "all rows"
+    if (sels[t].empty()) continue;
+    retval[t] = batch->cloneSelected(&sels[t]);
+  }
+
+  return std::move(retval);
+}
+
+}  // namespace dbcommon
@@ -0,0 +1,77 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef DBCOMMON_SRC_DBCOMMON_HASH_TUPLE_BATCH_ROUTER_H_
+#define DBCOMMON_SRC_DBCOMMON_HASH_TUPLE_BATCH_ROUTER_H_
+
+#include <memory>
+#include <vector>
+
+#include "dbcommon/common/tuple-batch.h"
+#include "dbcommon/hash/tuple-batch-hasher.h"
+#include "dbcommon/nodes/select-list.h"
+
+namespace dbcommon {
+
+// TupleBatchRouter is the vectorized counterpart of routing tuples one at a
+// time by cdbhash in a redistribute motion. It computes the target segment of
+// every tuple in a batch, groups the tuple indexes by target with a counting
+// sort, and cuts the batch into one sub-batch per destination.
+//
+// Targets are computed by TupleBatchHasher::cdbhash(), so a tuple lands on the
+// same segment as it would through cdbhash in hash/cdb-hash.h.
+class TupleBatchRouter {
+ public:
+  // @param inputTupleDesc tuple desc of the batches to route
+  // @param keys column indexes (1 based) of hash key
+  // @param segsNum number of destination segments
+  TupleBatchRouter(const TupleDesc &inputTupleDesc,
+                   const std::vector<uint64_t> &keys, int32_t segsNum);
+
+  int32_t getSegsNum() const { return segsNum_; }
+
+  // Calculate the target segment for each tuple in the batch.
+  // @param batch given tuple batch
+  // @return a vector of target segment for each tuple in the batch
+  const std::vector<uint64_t> &route(const TupleBatch *batch);
+
+  // Group tuples of the batch by target segment in one pass.
+  // @param batch given tuple batch
+  // @return one SelectList of plain row indexes per target segment, a target
+  // receiving no tuple gets an empty SelectList
+  const std::vector<SelectList> &partition(const TupleBatch *batch);
+
+  // Cut the batch into per-destination sub-batches.
+  // @param batch given tuple batch
+  // @return one sub-batch per target segment, nullptr for a target receiving
+  // no tuple
+  std::vector<std::unique_ptr<TupleBatch>> redistribute(
+      const TupleBatch *batch);
+
+ private:
+  TupleBatchHasher hasher_;
+  int32_t segsNum_;
+  std::vector<uint32_t> counts_;      // number of tuples per target
+  std::vector<SelectList> sels_;      // tuple indexes per target
+  std::vector<uint32_t> capacities_;  // allocated size of each SelectList
+};
+
+}  // namespace dbcommon
+
+#endif  // DBCOMMON_SRC_DBCOMMON_HASH_TUPLE_BATCH_ROUTER_H_
@@ -20,6 +20,7 @@
 #include "dbcommon/type/date.h"
 
 #include <cstdlib>
+#include <cstring>
 #include <limits>
 #include <memory>
 #include <utility>
@@ -30,15 +31,75 @@
 
 namespace dbcommon {
 
+// Split seconds since the unix epoch into whole days and the seconds left
+// in the day, rounding towards negative infinity without branching
+static inline void splitDays(int64_t second, int32_t *days, int32_t *rest) {
+  int64_t d = second / SECONDS_PER_DAY;
+  int64_t r = second % SECONDS_PER_DAY;
+  int64_t neg = r < 0;
+  *days = static_cast<int32_t>(d - neg);
+  *rest = static_cast<int32_t>(r + neg * SECONDS_PER_DAY);
+}
+
+// Neri-Schneider conversion from days since the unix epoch to the proleptic
+// gregorian calendar, the same result as j2date() but all on unsigned 32-bit
+// integers without branches, so that loops over it can be vectorized. The
+// days are shifted by kEras 400-year eras to keep them positive down to
+// julian day 0.
+static inline void days2date(int32_t days, int32_t *year, int32_t *month,
+                             int32_t *day) {
+  const int32_t kEras = 14;
+  const uint32_t kShift = 719468 + 146097 * kEras;  // 0000-03-01 as day 0
+
+  uint32_t n = static_cast<uint32_t>(days) + kShift;
+  uint32_t n1 = 4 * n + 3;
+  uint32_t c = n1 / 146097;
+  uint32_t n2 = (n1 % 146097) | 3;
+  uint64_t p2 = static_cast<uint64_t>(2939745) * n2;
+  uint32_t z = static_cast<uint32_t>(p2 >> 32);
+  uint32_t ny = static_cast<uint32_t>(p2) / 2939745 / 4;
+  uint32_t n3 = 2141 * ny + 197913;
+  uint32_t m = n3 >> 16;
+  uint32_t d = (n3 & 0xFFFF) / 2141;
+  uint32_t j = ny >= 306;
+  *year = static_cast<int32_t>(100 * c + z + j) - 400 * kEras;
+  *month = static_cast<int32_t>(m - 12 * j);
+  *day = static_cast<int32_t>(d + 1);
+}
+
 void TimestampType::extractDate(int64_t second, int32_t *year, int32_t *month,
                                 int32_t *day) {
-  int32_t days = (int32_t)(second / SECONDS_PER_DAY);
-  int64_t seconds = second % SECONDS_PER_DAY * 1000000;
-  if (seconds < 0) {
-    days -= 1;
-    seconds += SECONDS_PER_DAY * 1000000;
+  int32_t days, rest;
+  splitDays(second, &days, &rest);
+  days2date(days, year, month, day);
+}
+
+void TimestampType::extractDateBatch(const int64_t *seconds, uint64_t size,
+                                     int32_t *year, int32_t *month,
+                                     int32_t *day) {
+  // 64-bit division does not vectorize, so split off the days first and run
+  // the 32-bit calendar arithmetic as a separate loop, using day as scratch
+  for (uint64_t i = 0; i < size; ++i) {
+    int32_t rest;
+    splitDays(seconds[i], &day[i], &rest);
+  }
+  for (uint64_t i = 0; i < size; ++i)
+    days2date(day[i], &year[i], &month[i], &day[i]);
+}
+
+void TimestampType::extractTimeBatch(const int64_t *seconds, uint64_t size,
+                                     int32_t *hour2, int32_t *minute2,
+                                     int32_t *second2) {
+  for (uint64_t i = 0; i < size; ++i) {
+    int32_t days;
+    splitDays(seconds[i], &days, &second2[i]);
+  }
+  for (uint64_t i = 0; i < size; ++i) {
+    int32_t rest = second2[i];
+    hour2[i] = rest / 3600;
+    minute2[i] = rest % 3600 / 60;
+    second2[i] = rest % 60;
   }
-  j2date(days + UNIX_EPOCH_JDATE, year, month, day);
 }
 
 double TimestampType::extractYear(int64_t second) {
@@ -106,13 +167,11 @@ double TimestampType::extractEpoch(int64_t second, int64_t nanosecond) {
 
 void TimestampType::extractTime(int64_t second, int32_t *hour2,
                                 int32_t *minute2, int32_t *second2) {
-  int32_t second_rest = (int32_t)(second % SECONDS_PER_DAY);
-  *hour2 = (int32_t)(second_rest / 3600);
-  *minute2 = (int32_t)((second_rest - (*hour2) * 3600) / 60);
-  *second2 = (int32_t)(second_rest - (*hour2) * 3600 - (*minute2) * 60);
-  if (*hour2 < 0) *hour2 += 23;
-  if (*minute2 < 0) *minute2 += 59;
-  if (*second2 < 0) *second2 += 60;
+  int32_t days, rest;
+  splitDays(second, &days, &rest);
+  *hour2 = rest / 3600;
+  *minute2 = rest % 3600 / 60;
+  *second2 = rest % 60;
 }
 
 double TimestampType::extractHour(int64_t second) {
@@ -328,93 +387,162 @@ Timestamp TimestampType::truncWeek(int64_t second) {
   timestamp_trunc(&ret, year, month, day, 0, 0, 0, 0);
   return ret;
 }
-template <typename T>
-void TimestampType::int2string(T value, char *string, int32_t *length) {
-  char data[11] = "0123456789";
-  char a[10] = {0};
-  char *str = string;
-  T sum = value;
-  int32_t i = 0;
-  while (sum > 0) {
-    a[i++] = data[sum % 10];
-    sum /= 10;
+
+std::string TimestampType::timestamp2string(int64_t second,
+                                            int64_t nanosecond) {
+  char result[TIMESTAMP_TEXT_MAXLEN];
+  uint32_t length = timestamp2buffer(second, nanosecond, result);
+  return std::string(result, length);
+}
+
+// Write val in decimal with at least width digits, zero padded
+// @return The end of written digits
+static inline char *writePaddedDigits(char *buf, uint32_t val, int32_t width) {
+  int32_t numOfDigits = 1;
+  for (uint32_t v = val; v >= 10; v /= 10) numOfDigits++;
+  if (numOfDigits < width) numOfDigits = width;
+  char *end = buf + numOfDigits;
+  for (char *p = end; p != buf; val /= 10) *--p = '0' + val % 10;
+  return end;
+}
+
+// Parse exactly width decimal digits
+// @return false if any of them is not a digit
+static inline bool readDigits(const char *str, int32_t width, int32_t *val) {
+  int32_t ret = 0;
+  for (int32_t i = 0; i < width; i++) {
+    uint32_t digit = static_cast<uint8_t>(str[i]) - '0';
+    if (digit > 9) return false;
+    ret = ret * 10 + digit;
   }
-  for (int32_t j = i - 1; j >= 0; j--) {
-    *str++ = a[j];
-    (*length)++;
+  *val = ret;
+  return true;
+}
+
+static inline bool isBCSuffix(const char *str) {
+  return str[0] == ' ' && str[1] == 'B' && str[2] == 'C';
+}
+
+// Parse yyyy-mm-dd into days since unix epoch
+static inline bool readIsoDate(const char *str, bool isBC, int32_t *days) {
+  int32_t year, month, day;
+  if (str[4] != '-' || str[7] != '-' || !readDigits(str, 4, &year) ||
+      !readDigits(str + 5, 2, &month) || !readDigits(str + 8, 2, &day))
+    return false;
+  if (isBC) year = -year + 1;
+  *days = DateType::date2j(year, month, day) - UNIX_EPOCH_JDATE;
+  return true;
+}
+
+int32_t DateType::fromBuffer(const char *str, uint64_t len) {
+  int32_t days;
+  if ((len == 10 || (len == 13 && isBCSuffix(str + 10))) &&
+      readIsoDate(str, len == 13, &days))
+    return days;
+  return fromString(std::string(str, len));
+}
+
+uint32_t DateType::date2buffer(int32_t dateval, char *buf) {
+  int32_t year, month, day;
+  j2date(dateval + UNIX_EPOCH_JDATE, &year, &month, &day);
+  bool isBC = dateval + AD_EPOCH_JDATE < 0;
+  if (isBC) year = -year + 1;
+
+  char *p = writePaddedDigits(buf, year, 4);
+  *p++ = '-';
+  p = writePaddedDigits(p, month, 2);
+  *p++ = '-';
+  p = writePaddedDigits(p, day, 2);
+  if (isBC) {
+    memcpy(p, " BC", 3);
+    p += 3;
   }
+  return p - buf;
 }
-std::string TimestampType::timestamp2string(int64_t second,
-                                            int64_t nanosecond) {
+
+uint32_t TimestampType::timestamp2buffer(int64_t second, int64_t nanosecond,
+                                         char *buf) {
   int64_t val = (second - TIMESTAMP_EPOCH_JDATE) * 1000000 + nanosecond / 1000;
-  if (val == TIMESTAMP_INFINITY) return "infinity";
-  if (val == TIMESTAMP_NEG_INFINITY) return "-infinity";
+  if (val == TIMESTAMP_INFINITY) {
+    memcpy(buf, "infinity", 8);
+    return 8;
+  }
+  if (val == TIMESTAMP_NEG_INFINITY) {
+    memcpy(buf, "-infinity", 9);
+    return 9;
+  }
+
+  if (nanosecond < 0) {
+    second -= 1;
+    nanosecond += 1000000000;
+  }
   int32_t days = (int32_t)(second / SECONDS_PER_DAY);
   int64_t seconds = second % SECONDS_PER_DAY;
   if (seconds < 0) {
     days -= 1;
     seconds += SECONDS_PER_DAY;
   }
-  if (nanosecond < 0) {
-    seconds -= 1000000;
-    nanosecond += 1000000000;
-  }
-  char result[30];
-  int32_t length = 0;
-  int32_t year, month, day;
-  bool is_bc = false;
-  int32_t second_real = seconds % 60;
-  seconds /= 60;
-  int32_t minute = seconds % 60;
-  int32_t hour = seconds / 60;
-  int32_t nano_length = 1;
 
+  int32_t year, month, day;
   j2date(days + UNIX_EPOCH_JDATE, &year, &month, &day);
-  if (days + AD_EPOCH_JDATE < 0) {
-    year = -year + 1;
-    is_bc = true;
-  }
+  bool isBC = days + AD_EPOCH_JDATE < 0;
+  if (isBC) year = -year + 1;
 
-  if (year < 1000) result[length++] = '0';
-  if (year < 100) result[length++] = '0';
-  if (year < 10) result[length++] = '0';
-  int2string(year, &result[length], &length);
-  result[length++] = '-';
-  if (month < 10) result[length++] = '0';
-  int2string(month, &result[length], &length);
-  result[length++] = '-';
-  if (day < 10) result[length++] = '0';
-  int2string(day, &result[length], &length);
-  result[length++] = ' ';
-
-  if (hour < 10) result[length++] = '0';
-  int2string(hour, &result[length], &length);
-  result[length++] = ':';
-  if (minute < 10) result[length++] = '0';
-  int2string(minute, &result[length], &length);
-  result[length++] = ':';
-  if (second_real < 10) result[length++] = '0';
-  int2string(second_real, &result[length], &length);
+  char *p = writePaddedDigits(buf, year, 4);
+  *p++ = '-';
+  p = writePaddedDigits(p, month, 2);
+  *p++ = '-';
+  p = writePaddedDigits(p, day, 2);
+  *p++ = ' ';
+  p = writePaddedDigits(p, seconds / SECONDS_PER_HOUR, 2);
+  *p++ = ':';
+  p = writePaddedDigits(p, seconds / 60 % 60, 2);
+  *p++ = ':';
+  p = writePaddedDigits(p, seconds % 60, 2);
 
   if (nanosecond > 0) {
-    result[length++] = '.';
-    for (int64_t i = nanosecond; i != 0; i /= 10)
-      if (i / 10 != 0) nano_length++;
-    for (int32_t i = 0; i < 9 - nano_length; i++) result[length++] = '0';
+    *p++ = '.';
+    p = writePaddedDigits(p, nanosecond, 9);
+    while (p[-1] == '0') --p;
+  }
+  if (isBC) {
+    memcpy(p, " BC", 3);
+    p += 3;
+  }
+  return p - buf;
+}
 
-    while (nanosecond % 10 == 0) {
-      nanosecond /= 10;
+Timestamp TimestampType::fromBuffer(const char *str, uint64_t len) {
+  const uint64_t kSecondEnd = 19;  // length of "yyyy-mm-dd hh:mm:ss"
+  if (len >= kSecondEnd && str[10] == ' ' && str[13] == ':' &&
+      str[16] == ':') {
+    bool isBC = len >= kSecondEnd + 3 && isBCSuffix(str + len - 3);
+    uint64_t end = isBC ? len - 3 : len;
+    int32_t days, hour, minute, sec;
+    int32_t nanoDigits = end > kSecondEnd ? end - kSecondEnd - 1 : 0;
+    int64_t nanosecond = 0;
+    bool valid = readIsoDate(str, isBC, &days) &&
+                 readDigits(str + 11, 2, &hour) &&
+                 readDigits(str + 14, 2, &minute) &&
+                 readDigits(str + 17, 2, &sec);
+    if (valid && end > kSecondEnd) {
+      valid = str[kSecondEnd] == '.' && nanoDigits > 0 && nanoDigits <= 9;
+      for (uint64_t i = kSecondEnd + 1; valid && i < end; i++) {
+        uint32_t digit = static_cast<uint8_t>(str[i]) - '0';
+        valid = digit <= 9;
+        nanosecond = nanosecond * 10 + digit;
+      }
+      for (int32_t i = nanoDigits; i < 9; i++) nanosecond *= 10;
+    }
+    if (valid) {
+      Timestamp result;
+      result.second = static_cast<int64_t>(days) * SECONDS_PER_DAY +
+                      (hour * 60 + minute) * 60 + sec;
+      result.nanosecond = nanosecond;
+      return result;
     }
-    int2string(nanosecond, &result[length], &length);
-  }
-  if (is_bc) {
-    result[length++] = ' ';
-    result[length++] = 'B';
-    result[length++] = 'C';
   }
-  result[length] = '\0';
-  std::string str(result, length);
-  return str;
+  return fromString(std::string(str, len));
 }
 
 }  // namespace dbcommon
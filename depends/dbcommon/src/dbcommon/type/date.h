@@ -55,6 +55,10 @@ const int64_t TIMESTAMP_EPOCH_JDATE = PG_UNIX_EPOCH_JDATE * SECONDS_PER_DAY;
 const int64_t TIMESTAMP_INFINITY = 0x7fffffffffffffff;
 const int64_t TIMESTAMP_NEG_INFINITY = -(0x7fffffffffffffff) - 1;
 const int32_t TIMESTAMP_FIELD_MAXLEN = 10;
+// Upper bound of the text form length, e.g. "294276-12-31 BC" and
+// "294276-12-31 23:59:59.999999999 BC"
+const int32_t DATE_TEXT_MAXLEN = 16;
+const int32_t TIMESTAMP_TEXT_MAXLEN = 40;
 
 /*
  * Date/Time Configuration
@@ -357,6 +361,15 @@ class DateType : public DateTypeBase<int32_t> {
     return val;
   }
 
+  // Parse the date in the fixed layout yyyy-mm-dd[ BC] without building a
+  // temporary string, other formats fall back to fromString()
+  static int32_t fromBuffer(const char *str, uint64_t len);
+
+  // Write the text form of a date into buf, which must hold at least
+  // DATE_TEXT_MAXLEN bytes
+  // @return The length of the text
+  static uint32_t date2buffer(int32_t dateval, char *buf);
+
   static inline std::string toString(int32_t dateval) {
     int32_t year;
     int32_t month;
@@ -722,6 +735,16 @@ class TimestampType : public DateTypeBase<int64_t> {
                           int32_t *day);
   static void extractTime(int64_t second, int32_t *hour2, int32_t *minute2,
                           int32_t *second2);
+
+  // Decompose seconds[0, size) into civil dates once per batch. The loop has
+  // no branches and no table lookups so it vectorizes, rows hidden by the
+  // selection or nulls are decomposed too and simply ignored by the caller
+  static void extractDateBatch(const int64_t *seconds, uint64_t size,
+                               int32_t *year, int32_t *month, int32_t *day);
+  static void extractTimeBatch(const int64_t *seconds, uint64_t size,
+                               int32_t *hour2, int32_t *minute2,
+                               int32_t *second2);
+
   static void timestamp_trunc(Timestamp *ret, int32_t year, int32_t month,
                               int32_t day, int32_t hour, int32_t minute,
                               int32_t second, int64_t nanosecond);
@@ -758,8 +781,17 @@ class TimestampType : public DateTypeBase<int64_t> {
   static Timestamp truncMilliseconds(int64_t second, int64_t nanosecond);
   static Timestamp truncMicroseconds(int64_t second, int64_t nanosecond);
   static std::string timestamp2string(int64_t second, int64_t nanosecond);
-  template <typename T>
-  static void int2string(T value, char *string, int32_t *length);
+
+  // Write the text form of a timestamp into buf, which must hold at least
+  // TIMESTAMP_TEXT_MAXLEN bytes
+  // @return The length of the text
+  static uint32_t timestamp2buffer(int64_t second, int64_t nanosecond,
+                                   char *buf);
+
+  // Parse the timestamp in the fixed layout yyyy-mm-dd hh:mm:ss[.n][ BC]
+  // without building temporary strings, other formats fall back to
+  // fromString()
+  static Timestamp fromBuffer(const char *str, uint64_t len);
 };
 
 class TimestamptzType : public TimestampType {
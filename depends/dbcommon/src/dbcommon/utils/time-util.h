@@ -39,6 +39,13 @@ class TimeUtil {
 
   static uint64_t currentTimeMilliSec() { return currentTime() / 1000LL; }
 
+  // Monotonic clock in nanoseconds, suitable for measuring short intervals
+  static uint64_t currentTimeNanoSec() {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1000000000LL + ts.tv_nsec;
+  }
+
   static std::string currentTimestampWithTimezone() {
     struct timeval tv;
     struct tm* tm;
@@ -21,6 +21,7 @@
 
 #include "gtest/gtest.h"
 
+#include "dbcommon/function/func.h"
 #include "dbcommon/testutil/function-utils.h"
 #include "dbcommon/testutil/scalar-utils.h"
 #include "dbcommon/testutil/vector-utils.h"
@@ -431,6 +432,42 @@ TEST(TestFunction, TestDate_Trunc) {
   }
 }
 
+TEST(TestFunction, TestDate_PartBeforeEpoch) {
+  VectorUtility vuText(TypeKind::STRINGID);
+  VectorUtility vuTimestamp(TypeKind::TIMESTAMPID);
+  VectorUtility vuDate_part(TypeKind::DOUBLEID);
+  ScalarUtility suString(TypeKind::STRINGID);
+
+  auto timestamp = vuTimestamp.generateVector(
+      "1969-12-31 23:10:05 1900-03-01 00:00:00 1066-10-14 09:30:59 NULL");
+  {
+    FunctionUtility fu(FuncKind::TIMESTAMP_DATE_PART);
+    auto ret = Vector::BuildVector(TypeKind::DOUBLEID, true);
+    auto text = vuText.generateVector("hour day minute year");
+    auto datep = vuDate_part.generateVector("23 1 30 NULL");
+    std::vector<Datum> params{CreateDatum(ret.get()), CreateDatum(text.get()),
+                              CreateDatum(timestamp.get())};
+    fu.test(params.data(), params.size(), CreateDatum(datep.get()));
+
+    auto unit = suString.generateScalar("second");
+    auto second = vuDate_part.generateVector("5 0 59 NULL");
+    params = {CreateDatum(ret.get()), CreateDatum(&unit),
+              CreateDatum(timestamp.get())};
+    fu.test(params.data(), params.size(), CreateDatum(second.get()));
+  }
+  {
+    FunctionUtility fu(FuncKind::TIMESTAMP_DATE_TRUNC);
+    VectorUtility vuDate_trunc(TypeKind::TIMESTAMPID);
+    auto ret = Vector::BuildVector(TypeKind::TIMESTAMPID, true);
+    auto unit = suString.generateScalar("hour");
+    auto datep = vuDate_trunc.generateVector(
+        "1969-12-31 23:00:00 1900-03-01 00:00:00 1066-10-14 09:00:00 NULL");
+    std::vector<Datum> params{CreateDatum(ret.get()), CreateDatum(&unit),
+                              CreateDatum(timestamp.get())};
+    fu.test(params.data(), params.size(), CreateDatum(datep.get()));
+  }
+}
+
 TEST(TestFunction, TestTimestampToText) {
   FunctionUtility fu(FuncKind::TIMESTAMP_TO_TEXT);
   VectorUtility vuTimestemp(TypeKind::TIMESTAMPID);
@@ -446,4 +483,80 @@ TEST(TestFunction, TestTimestampToText) {
 
   fu.test(params.data(), params.size(), CreateDatum(text.get()));
 }
+
+TEST(TestFunction, TestTimestampToTextZeroTime) {
+  FunctionUtility fu(FuncKind::TIMESTAMP_TO_TEXT);
+  VectorUtility vuTimestemp(TypeKind::TIMESTAMPID);
+  VectorUtility vuText(TypeKind::STRINGID);
+
+  auto ret = Vector::BuildVector(TypeKind::STRINGID, true);
+  auto timestamp = vuTimestemp.generateVector(
+      "2020-02-29 00:00:00 1969-12-31 23:59:59.5");
+  auto text = vuText.generateVector(
+      "2020-02-29 00:00:00,1969-12-31 23:59:59.5", ',');
+  std::vector<Datum> params{CreateDatum(ret.get()),
+                            CreateDatum(timestamp.get())};
+
+  fu.test(params.data(), params.size(), CreateDatum(text.get()));
+}
+
+TEST(TestFunction, TestTextToTimestamp) {
+  FunctionUtility fu(FuncKind::TEXT_TO_TIMESTAMP);
+  VectorUtility vuText(TypeKind::STRINGID);
+  VectorUtility vuTimestemp(TypeKind::TIMESTAMPID);
+
+  auto ret = Vector::BuildVector(TypeKind::TIMESTAMPID, true);
+  auto text = vuText.generateVector(
+      "1270-01-01 13:40:25.1234,1969-12-31 23:59:59.999999999,NULL", ',');
+  auto timestamp = vuTimestemp.generateVector(
+      "1270-01-01 13:40:25.1234 1969-12-31 23:59:59.999999999 NULL");
+  std::vector<Datum> params{CreateDatum(ret.get()), CreateDatum(text.get())};
+
+  fu.test(params.data(), params.size(), CreateDatum(timestamp.get()));
+}
+
+TEST(TestFunction, TestDateToText) {
+  FunctionUtility fu(FuncKind::DATE_TO_TEXT);
+  VectorUtility vuDate(TypeKind::DATEID);
+  VectorUtility vuText(TypeKind::STRINGID);
+
+  auto ret = Vector::BuildVector(TypeKind::STRINGID, true);
+  auto date = vuDate.generateVector("1970-01-01 2020-02-29 NULL");
+  auto text = vuText.generateVector("1970-01-01 2020-02-29 NULL");
+  std::vector<Datum> params{CreateDatum(ret.get()), CreateDatum(date.get())};
+
+  fu.test(params.data(), params.size(), CreateDatum(text.get()));
+}
+
+TEST(TestFunction, TestTextToDate) {
+  FunctionUtility fu(FuncKind::TEXT_TO_DATE);
+  VectorUtility vuText(TypeKind::STRINGID);
+  VectorUtility vuDate(TypeKind::DATEID);
+
+  auto ret = Vector::BuildVector(TypeKind::DATEID, true);
+  auto text = vuText.generateVector("1970-01-01,0044-03-15 BC,NULL", ',');
+  auto date = vuDate.generateVector("1970-01-01,0044-03-15 BC,NULL", ',');
+  std::vector<Datum> params{CreateDatum(ret.get()), CreateDatum(text.get())};
+
+  fu.test(params.data(), params.size(), CreateDatum(date.get()));
+}
+
+TEST(TestFunction, TestDateTextCastEntries) {
+  // appended after the existing kinds, whose ids must not change
+  EXPECT_EQ(FuncKind::RANDOMF + 1, FuncKind::DATE_TO_TEXT);
+
+  struct {
+    FuncKind kind;
+    const char *name;
+  } casts[] = {{FuncKind::DATE_TO_TEXT, "date_to_text"},
+               {FuncKind::TEXT_TO_TIMESTAMP, "text_to_timestamp"},
+               {FuncKind::TEXT_TO_DATE, "text_to_date"}};
+  for (auto &cast : casts) {
+    ASSERT_TRUE(Func::instance()->hasFuncEntryById(cast.kind)) << cast.name;
+    const FuncEntry *entry = Func::instance()->getFuncEntryByName(cast.name);
+    ASSERT_NE(nullptr, entry) << cast.name;
+    EXPECT_EQ(cast.kind, entry->funcId);
+    EXPECT_EQ(cast.name, Func::instance()->getFuncEntryById(cast.kind)->funcName);
+  }
+}
 }  // namespace dbcommon
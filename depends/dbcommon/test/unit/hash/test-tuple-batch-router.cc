@@ -0,0 +1,93 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <memory>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dbcommon/hash/cdb-hash.h"
+#include "dbcommon/hash/tuple-batch-router.h"
+#include "dbcommon/testutil/tuple-batch-utils.h"
+
+namespace dbcommon {
+
+// The target segment cdbhash gives to a single int key
+static uint64_t expectedTarget(int32_t key, int32_t segsNum) {
+  int64_t value = key;
+  uint64_t hval = cdbhash(&value, sizeof(value), cdbhash_init());
+  if ((segsNum & (segsNum - 1)) == 0)
+    return FASTMOD(static_cast<uint32_t>(hval), static_cast<uint32_t>(segsNum));
+  return hval % segsNum;
+}
+
+TEST(TestTupleBatchRouter, TestPartition) {
+  TupleBatchUtility tbu;
+  TupleDesc::uptr desc = tbu.generateTupleDesc("is");
+  TupleBatch::uptr batch = tbu.generateTupleBatch(*desc, 0, 1000);
+
+  TupleBatchRouter router(*desc, {1}, 4);
+  const std::vector<SelectList> &sels = router.partition(batch.get());
+  ASSERT_EQ(4, sels.size());
+
+  size_t total = 0;
+  for (int32_t t = 0; t < 4; ++t) {
+    uint16_t last = 0;
+    for (size_t i = 0; i < sels[t].size(); ++i) {
+      EXPECT_EQ(t, expectedTarget(sels[t][i], 4));
+      // the counting sort keeps the input order within a target
+      if (i > 0) EXPECT_LT(last, sels[t][i]);
+      last = sels[t][i];
+    }
+    total += sels[t].size();
+  }
+  EXPECT_EQ(1000, total);
+}
+
+TEST(TestTupleBatchRouter, TestRedistribute) {
+  TupleBatchUtility tbu;
+  TupleDesc::uptr desc = tbu.generateTupleDesc("is");
+  TupleBatch::uptr batch = tbu.generateTupleBatch(*desc, 0, 100);
+
+  SelectList sel;
+  for (int i = 0; i < 100; i += 2) sel.push_back(i);
+  batch->setSelected(sel);
+
+  TupleBatchRouter router(*desc, {1}, 3);
+  std::vector<std::unique_ptr<TupleBatch>> subs =
+      router.redistribute(batch.get());
+  ASSERT_EQ(3, subs.size());
+
+  size_t total = 0;
+  for (int32_t t = 0; t < 3; ++t) {
+    if (!subs[t]) continue;
+    const TupleBatchReader &reader = subs[t]->getTupleBatchReader();
+    for (uint32_t i = 0; i < subs[t]->getNumOfRows(); ++i) {
+      bool null;
+      int32_t key = std::stoi(reader[0]->read(i, &null));
+      EXPECT_EQ(0, key % 2);
+      EXPECT_EQ(t, expectedTarget(key, 3));
+      EXPECT_EQ(std::to_string(key), reader[1]->read(i, &null));
+    }
+    total += subs[t]->getNumOfRows();
+  }
+  EXPECT_EQ(50, total);
+}
+
+}  // namespace dbcommon
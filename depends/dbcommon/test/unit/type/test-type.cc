@@ -18,6 +18,7 @@
  */
 
 #include "dbcommon/common/vector.h"
+#include "dbcommon/type/date.h"
 #include "dbcommon/type/decimal.h"
 #include "dbcommon/type/type-util.h"
 #include "dbcommon/type/typebase.h"
@@ -451,4 +452,48 @@ TEST_F(TestType, unsupported) {
                  TransactionAbortException);
   }
 }
+
+TEST_F(TestType, extractDateBatch) {
+  // days from 4713 BC to the end of the timestamp range in 294276 AD
+  std::vector<int64_t> seconds;
+  for (int32_t jd = 0; jd < 109203489; jd += 97)
+    seconds.push_back((static_cast<int64_t>(jd) - UNIX_EPOCH_JDATE) *
+                          SECONDS_PER_DAY +
+                      jd % SECONDS_PER_DAY);
+  std::vector<int32_t> year(seconds.size()), month(seconds.size()),
+      day(seconds.size());
+  TimestampType::extractDateBatch(seconds.data(), seconds.size(), year.data(),
+                                  month.data(), day.data());
+  for (size_t i = 0; i < seconds.size(); ++i) {
+    int32_t y, m, d;
+    TimestampType::j2date(seconds[i] / SECONDS_PER_DAY + UNIX_EPOCH_JDATE -
+                              (seconds[i] % SECONDS_PER_DAY < 0),
+                          &y, &m, &d);
+    ASSERT_EQ(y, year[i]);
+    ASSERT_EQ(m, month[i]);
+    ASSERT_EQ(d, day[i]);
+  }
+}
+
+TEST_F(TestType, extractTimeBatch) {
+  std::vector<int64_t> seconds = {0, 45296, 86399, -1, -3600, -86400, -86401};
+  std::vector<int32_t> hour(7), minute(7), second(7), year(7), month(7),
+      day(7);
+  TimestampType::extractTimeBatch(seconds.data(), seconds.size(), hour.data(),
+                                  minute.data(), second.data());
+  TimestampType::extractDateBatch(seconds.data(), seconds.size(), year.data(),
+                                  month.data(), day.data());
+  EXPECT_EQ(std::vector<int32_t>({0, 12, 23, 23, 23, 0, 23}), hour);
+  EXPECT_EQ(std::vector<int32_t>({0, 34, 59, 59, 0, 0, 59}), minute);
+  EXPECT_EQ(std::vector<int32_t>({0, 56, 59, 59, 0, 0, 59}), second);
+  EXPECT_EQ(std::vector<int32_t>({1, 1, 1, 31, 31, 31, 30}), day);
+  for (size_t i = 0; i < seconds.size(); ++i) {
+    int32_t h, m, s;
+    TimestampType::extractTime(seconds[i], &h, &m, &s);
+    EXPECT_EQ(hour[i], h);
+    EXPECT_EQ(minute[i], m);
+    EXPECT_EQ(second[i], s);
+  }
+}
+
 }  // namespace dbcommon
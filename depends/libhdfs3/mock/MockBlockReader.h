@@ -0,0 +1,42 @@
+/********************************************************************
+ * 2014 - 
+ * open source under Apache License Version 2.0
+ ********************************************************************/
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _HDFS_LIBHDFS3_MOCK_MOCKBLOCKREADER_H_
+#define _HDFS_LIBHDFS3_MOCK_MOCKBLOCKREADER_H_
+
+#include "gmock/gmock.h"
+#include "client/BlockReader.h"
+
+namespace Hdfs {
+namespace Mock {
+
+class MockBlockReader: public Hdfs::Internal::BlockReader {
+public:
+	MOCK_METHOD0(available, int64_t());
+	MOCK_METHOD2(read, int32_t(char * buf, int32_t size));
+	MOCK_METHOD1(skip, void(int64_t len));
+	MOCK_METHOD1(poll, bool(int timeout));
+};
+
+}
+}
+
+#endif /* _HDFS_LIBHDFS3_MOCK_MOCKBLOCKREADER_H_ */
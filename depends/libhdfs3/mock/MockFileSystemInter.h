@@ -93,6 +93,8 @@ public:
   MOCK_CONST_METHOD0(getConf, const Hdfs::Internal::SessionConfig &());
   MOCK_CONST_METHOD0(getUserInfo, const Hdfs::Internal::UserInfo &());
   MOCK_METHOD4(getBlockLocations, void(const std::string & src, int64_t offset, int64_t length, Hdfs::Internal::LocatedBlocks & lbs));
+  MOCK_METHOD6(getCachedBlockLocations, void(const std::string & src, int64_t offset, int64_t length, int64_t fileLength, int64_t mtime, Hdfs::Internal::LocatedBlocks & lbs));
+  MOCK_METHOD1(invalidateBlockLocations, void(const std::string & src));
   MOCK_METHOD4(getListing, bool(const std::string & src, const std::string & , bool needLocation, std::vector<Hdfs::FileStatus> &));
   MOCK_METHOD2(listDirectory, Hdfs::DirectoryIterator(const char *, bool));
   MOCK_METHOD0(renewLease, bool());
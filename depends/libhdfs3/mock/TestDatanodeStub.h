@@ -23,6 +23,7 @@
 #define _HDFS_LIBHDFS3_MOCK_TESTDATANODESTUB_H_
 
 #include "MockDatanode.h"
+#include "client/BlockReader.h"
 
 namespace Hdfs {
 
@@ -34,6 +35,8 @@ public:
     }
 
     virtual shared_ptr<MockDatanode> getDatanode() = 0;
+
+    virtual shared_ptr<Hdfs::Internal::BlockReader> getBlockReader() = 0;
 };
 
 }
@@ -0,0 +1,112 @@
+/********************************************************************
+ * 2014 -
+ * open source under Apache License Version 2.0
+ ********************************************************************/
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "BlockLocationCache.h"
+#include "Logger.h"
+
+#include <inttypes.h>
+
+namespace Hdfs {
+namespace Internal {
+
+BlockLocationCache::BlockLocationCache(const SessionConfig & conf) :
+    capacity(conf.getBlockLocationCacheCapacity()),
+    expireTimeInterval(conf.getBlockLocationCacheExpiry()), hits(0), misses(0) {
+    map.setMaxSize(capacity > 0 ? capacity : 0);
+}
+
+bool BlockLocationCache::get(const std::string & src, int64_t offset, int64_t length,
+                             int64_t fileLength, int64_t mtime, LocatedBlocks & lbs) {
+    if (!isEnabled()) {
+        return false;
+    }
+
+    shared_ptr<Entry> entry;
+
+    if (!map.find(src, &entry)) {
+        ++misses;
+        LOG(DEBUG1, "BlockLocationCache miss for file %s.", src.c_str());
+        return false;
+    }
+
+    if (entry->fileLength != fileLength || entry->mtime != mtime) {
+        map.erase(src);
+        ++misses;
+        LOG(DEBUG1, "BlockLocationCache stale for file %s, file has been modified.", src.c_str());
+        return false;
+    }
+
+    if (ToMilliSeconds(entry->fetched, steady_clock::now()) > expireTimeInterval) {
+        map.erase(src);
+        ++misses;
+        LOG(DEBUG1, "BlockLocationCache expire for file %s.", src.c_str());
+        return false;
+    }
+
+    /*
+     * the cached blocks cover the range if they start before it and
+     * reach either the end of the range or the end of the file.
+     */
+    int64_t end = entry->offset + entry->length;
+
+    if (offset < entry->offset || (offset + length > end && end < fileLength)) {
+        ++misses;
+        LOG(DEBUG1, "BlockLocationCache miss for file %s at offset %" PRId64 ".", src.c_str(), offset);
+        return false;
+    }
+
+    ++hits;
+    LOG(DEBUG1, "BlockLocationCache hit for file %s at offset %" PRId64 ".", src.c_str(), offset);
+    lbs.setFileLength(entry->fileLength);
+    lbs.setIsLastBlockComplete(true);
+    lbs.setUnderConstruction(false);
+    lbs.setLastBlock(shared_ptr<LocatedBlock>());
+    lbs.getBlocks() = entry->blocks;
+    return true;
+}
+
+void BlockLocationCache::put(const std::string & src, int64_t offset, int64_t length,
+                             int64_t fileLength, int64_t mtime, LocatedBlocks & lbs) {
+    /*
+     * do not cache the blocks of a file being written,
+     * or if the file has been modified since its status is got.
+     */
+    if (!isEnabled() || !lbs.isLastBlockComplete() || lbs.isUnderConstruction()
+            || lbs.getFileLength() != fileLength) {
+        return;
+    }
+
+    shared_ptr<Entry> entry(new Entry);
+    entry->offset = offset;
+    entry->length = length;
+    entry->fileLength = fileLength;
+    entry->mtime = mtime;
+    entry->fetched = steady_clock::now();
+    entry->blocks = lbs.getBlocks();
+    map.insert(src, entry);
+}
+
+void BlockLocationCache::invalidate(const std::string & src) {
+    map.erase(src);
+}
+
+}
+}
@@ -0,0 +1,113 @@
+/********************************************************************
+ * 2014 -
+ * open source under Apache License Version 2.0
+ ********************************************************************/
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef _HDFS_LIBHDFS3_CLIENT_BLOCKLOCATIONCACHE_H_
+#define _HDFS_LIBHDFS3_CLIENT_BLOCKLOCATIONCACHE_H_
+
+#include "Atomic.h"
+#include "DateTime.h"
+#include "LruMap.h"
+#include "Memory.h"
+#include "server/LocatedBlocks.h"
+#include "SessionConfig.h"
+
+#include <string>
+
+namespace Hdfs {
+namespace Internal {
+
+/*
+ * A cache of the located blocks of files, shared by all the input streams of a file system.
+ *
+ * A cached entry is only used for the same version of the file, identified by
+ * its length and modification time, and expires after a configured interval,
+ * so that the locations of replicas do not become too stale.
+ * Only the blocks of completed files are cached.
+ */
+class BlockLocationCache {
+public:
+    BlockLocationCache(const SessionConfig & conf);
+
+    /**
+     * Get the cached blocks of a file.
+     * @param src the file path.
+     * @param offset range start offset.
+     * @param length range length.
+     * @param fileLength the length of the file.
+     * @param mtime the modification time of the file.
+     * @param lbs output the cached blocks.
+     * @return return true if the cached blocks cover the given range.
+     */
+    bool get(const std::string & src, int64_t offset, int64_t length,
+             int64_t fileLength, int64_t mtime, LocatedBlocks & lbs);
+
+    /**
+     * Cache the blocks of a file returned by namenode.
+     * @param src the file path.
+     * @param offset range start offset.
+     * @param length range length.
+     * @param fileLength the length of the file.
+     * @param mtime the modification time of the file.
+     * @param lbs the blocks to be cached.
+     */
+    void put(const std::string & src, int64_t offset, int64_t length,
+             int64_t fileLength, int64_t mtime, LocatedBlocks & lbs);
+
+    /**
+     * Remove the cached blocks of a file.
+     * @param src the file path.
+     */
+    void invalidate(const std::string & src);
+
+    bool isEnabled() const {
+        return capacity > 0;
+    }
+
+    int64_t getHits() const {
+        return hits;
+    }
+
+    int64_t getMisses() const {
+        return misses;
+    }
+
+private:
+    struct Entry {
+        int64_t offset;
+        int64_t length;
+        int64_t fileLength;
+        int64_t mtime;
+        steady_clock::time_point fetched;
+        std::vector<LocatedBlock> blocks;
+    };
+
+private:
+    const int capacity;
+    int64_t expireTimeInterval; //milliseconds
+    atomic<int64_t> hits;
+    atomic<int64_t> misses;
+    LruMap<std::string, shared_ptr<Entry> > map;
+};
+
+}
+}
+
+#endif /* _HDFS_LIBHDFS3_CLIENT_BLOCKLOCATIONCACHE_H_ */
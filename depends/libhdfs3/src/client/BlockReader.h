@@ -52,6 +52,13 @@ public:
      * @param len The number of bytes to skip.
      */
     virtual void skip(int64_t len) = 0;
+
+    /**
+     * Wait until data can be read without blocking.
+     * @param timeout the time to wait in millisecond.
+     * @return return true if data can be read without blocking.
+     */
+    virtual bool poll(int timeout) = 0;
 };
 
 }
@@ -111,6 +111,7 @@ FileSystemImpl::FileSystemImpl(const FileSystemKey& key, const Config& c)
        << getpid() << "_tid_" << pthread_self();
     clientName = ss.str();
     workingDir = std::string("/user/") + user.getEffectiveUser();
+    blockLocationCache = shared_ptr<BlockLocationCache>(new BlockLocationCache(sconf));
     peerCache = shared_ptr<PeerCache>(new PeerCache(sconf));
 #ifdef MOCK
     stub = NULL;
@@ -630,6 +631,24 @@ void FileSystemImpl::getBlockLocations(const std::string & src, int64_t offset,
     nn->getBlockLocations(src, offset, length, lbs);
 }
 
+void FileSystemImpl::getCachedBlockLocations(const std::string & src, int64_t offset,
+        int64_t length, int64_t fileLength, int64_t mtime, LocatedBlocks & lbs) {
+    if (!nn) {
+        THROW(HdfsIOException, "FileSystemImpl: not connected.");
+    }
+
+    if (blockLocationCache->get(src, offset, length, fileLength, mtime, lbs)) {
+        return;
+    }
+
+    nn->getBlockLocations(src, offset, length, lbs);
+    blockLocationCache->put(src, offset, length, fileLength, mtime, lbs);
+}
+
+void FileSystemImpl::invalidateBlockLocations(const std::string & src) {
+    blockLocationCache->invalidate(src);
+}
+
 void FileSystemImpl::create(const std::string & src, const Permission & masked,
                             int flag, bool createParent, short replication, int64_t blockSize) {
     if (!nn) {
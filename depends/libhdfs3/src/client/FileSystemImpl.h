@@ -23,6 +23,7 @@
 #define _HDFS_LIBHDFS3_CLIENT_FILESYSTEMIMPL_H_
 
 #include "BlockLocation.h"
+#include "BlockLocationCache.h"
 #include "DirectoryIterator.h"
 #include "EncryptionZoneIterator.h"
 #include "FileStatus.h"
@@ -294,6 +295,28 @@ public:
     void getBlockLocations(const std::string & src, int64_t offset,
                            int64_t length, LocatedBlocks & lbs);
 
+    /**
+     * Get locations of the blocks of the specified file within the specified range,
+     * from the located block cache if they have been got for the same version of the file.
+     *
+     * @param src file name
+     * @param offset range start offset
+     * @param length range length
+     * @param fileLength the length of the file
+     * @param mtime the modification time of the file
+     * @param lbs output the returned blocks
+     */
+    void getCachedBlockLocations(const std::string & src, int64_t offset,
+                                 int64_t length, int64_t fileLength, int64_t mtime,
+                                 LocatedBlocks & lbs);
+
+    /**
+     * Remove the cached block locations of the specified file.
+     *
+     * @param src file name
+     */
+    void invalidateBlockLocations(const std::string & src);
+
     /**
      * Create a new file entry in the namespace.
      *
@@ -479,6 +502,15 @@ public:
         return *peerCache;
     }
 
+    /**
+     * Get the located block cache.
+     *
+     * @return return the located block cache.
+     */
+    BlockLocationCache& getBlockLocationCache() {
+        return *blockLocationCache;
+    }
+
     /**
      * Create encryption zone for the directory with specific key name
      * @param path the directory path which is to be created.
@@ -524,6 +556,7 @@ private:
     mutex mutWorkingDir;
     Namenode * nn;
     SessionConfig sconf;
+    shared_ptr<BlockLocationCache> blockLocationCache;
     shared_ptr<PeerCache> peerCache;
     std::string clientName;
     std::string tokenService;
@@ -299,6 +299,29 @@ public:
     virtual void getBlockLocations(const std::string & src, int64_t offset,
                                    int64_t length, LocatedBlocks & lbs) = 0;
 
+    /**
+     * Get locations of the blocks of the specified file within the specified range,
+     * from the located block cache if they have been got for the same version of the file.
+     *
+     * @param src file name
+     * @param offset range start offset
+     * @param length range length
+     * @param fileLength the length of the file
+     * @param mtime the modification time of the file
+     * @param lbs output the returned blocks
+     */
+    virtual void getCachedBlockLocations(const std::string & src, int64_t offset,
+                                         int64_t length, int64_t fileLength, int64_t mtime,
+                                         LocatedBlocks & lbs) = 0;
+
+    /**
+     * Remove the cached block locations of the specified file,
+     * the next getCachedBlockLocations will ask namenode.
+     *
+     * @param src file name
+     */
+    virtual void invalidateBlockLocations(const std::string & src) = 0;
+
     /**
      * Create a new file entry in the namespace.
      *
@@ -71,6 +71,16 @@ void InputStream::readFully(char * buf, int64_t size) {
     impl->readFully(buf, size);
 }
 
+/**
+ * To read data from hdfs without copying it into a caller buffer.
+ * @param buf output the address of the data, valid until the next operation.
+ * @param size the max number of bytes to be read.
+ * @return return the number of bytes available at buf, it may less than size.
+ */
+int32_t InputStream::readZeroCopy(const char ** buf, int32_t size) {
+    return impl->readZeroCopy(buf, size);
+}
+
 int64_t InputStream::available() {
     return impl->available();
 }
@@ -61,6 +61,15 @@ public:
      */
     void readFully(char * buf, int64_t size);
 
+    /**
+     * To read data from hdfs without copying it into a caller buffer.
+     * Reading from a memory mapped local replica returns the data in page cache.
+     * @param buf output the address of the data, it is valid until the next operation on this stream.
+     * @param size the max number of bytes to be read.
+     * @return return the number of bytes available at buf, it may less than size.
+     */
+    int32_t readZeroCopy(const char ** buf, int32_t size);
+
     /**
      * Get how many bytes can be read without blocking.
      * @return The number of bytes can be read without blocking.
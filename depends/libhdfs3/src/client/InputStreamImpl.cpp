@@ -19,6 +19,7 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include "DateTime.h"
 #include "Exception.h"
 #include "ExceptionInternal.h"
 #include "FileSystemInter.h"
@@ -120,8 +121,9 @@ unordered_set<std::string> BuildLocalAddrSet() {
 
 InputStreamImpl::InputStreamImpl() :
     closed(true), localRead(true), readFromUnderConstructedBlock(false), verify(
-        true), maxGetBlockInfoRetry(3), cursor(0), endOfCurBlock(0), lastBlockBeingWrittenLength(
-            0), prefetchSize(0), peerCache(NULL) {
+        true), maxGetBlockInfoRetry(3), hedgedReadThreshold(0), cursor(0), endOfCurBlock(0),
+        hedgedReadOps(0), hedgedReadWins(0), lastBlockBeingWrittenLength(0), prefetchSize(0),
+        peerCache(NULL) {
 #ifdef MOCK
     stub = NULL;
 #endif
@@ -212,7 +214,9 @@ void InputStreamImpl::updateBlockInfos() {
                 lbs = shared_ptr < LocatedBlocksImpl > (new LocatedBlocksImpl);
             }
 
-            filesystem->getBlockLocations(path, cursor, prefetchSize, *lbs);
+            filesystem->getCachedBlockLocations(path, cursor, prefetchSize,
+                                                fileStatus.getLength(),
+                                                fileStatus.getModificationTime(), *lbs);
 
             if (lbs->isLastBlockComplete()) {
                 lastBlockBeingWrittenLength = 0;
@@ -358,8 +362,13 @@ void InputStreamImpl::setupBlockReader(bool temporaryDisableLocalRead) {
                     }
 
                     assert(info->isValid());
+                    /*
+                     * The datanode verified the checksum when it cached the replica,
+                     * so skip verifying it again.
+                     */
                     blockReader = shared_ptr<BlockReader>(
-                        new LocalBlockReader(info, *curBlock, offset, verify,
+                        new LocalBlockReader(info, *curBlock, offset,
+                                             verify && !curBlock->isCachedOn(curNode),
                                              *conf, localReaderBuffer));
                 } catch (...) {
                     if (info) {
@@ -429,11 +438,15 @@ void InputStreamImpl::openInternal(shared_ptr<FileSystemInter> fs, const char *
         prefetchSize = conf->getDefaultBlockSize() * conf->getPrefetchSize();
         localRead = conf->isReadFromLocal();
         maxGetBlockInfoRetry = conf->getMaxGetBlockInfoRetry();
+        hedgedReadThreshold = conf->getHedgedReadThreshold();
         peerCache = &fs->getPeerCache();
+        /*
+         * the file status identifies the version of the file in the located block cache.
+         */
+        fileStatus = fs->getFileStatus(this->path.c_str());
         updateBlockInfos();
         closed = false;
         /* If file is encrypted , then initialize CryptoCodec. */
-        fileStatus = fs->getFileStatus(this->path.c_str());
         FileEncryptionInfo *fileEnInfo = fileStatus.getFileEncryption();
         if (fileStatus.isFileEncrypted()) {
             if (cryptoCodec == NULL) {
@@ -478,7 +491,131 @@ int32_t InputStreamImpl::read(char * buf, int32_t size) {
     }
 }
 
-int32_t InputStreamImpl::readOneBlock(char * buf, int32_t size, bool shouldUpdateMetadataOnFailure) {
+int32_t InputStreamImpl::readZeroCopy(const char ** buf, int32_t size) {
+    checkStatus();
+
+    try {
+        int64_t prvious = cursor;
+        int32_t done;
+
+        if (fileStatus.isFileEncrypted()) {
+            /*
+             * Encrypted data has to be decrypted into a buffer.
+             */
+            zeroCopyBuffer.resize(size);
+            done = readInternal(&zeroCopyBuffer[0], size);
+            *buf = &zeroCopyBuffer[0];
+        } else {
+            done = readInternal(NULL, size, buf);
+        }
+
+        LOG(DEBUG3, "%p zero copy read file %s size is %d, offset %" PRId64 " done %d, next pos %" PRId64, this,
+            path.c_str(), size, prvious, done, cursor);
+        return done;
+    } catch (const HdfsEndOfStream & e) {
+        throw;
+    } catch (...) {
+        lastError = current_exception();
+        throw;
+    }
+}
+
+/**
+ * Setup a block reader on another replica of the current block,
+ * starting from the current position.
+ * @param node the datanode the returned block reader refers to.
+ * @return the block reader or null if no other replica can be read.
+ */
+shared_ptr<BlockReader> InputStreamImpl::setupHedgedBlockReader(shared_ptr<DatanodeInfo> & node) {
+    const std::vector<DatanodeInfo> & nodes = curBlock->getLocations();
+    int64_t offset = cursor - curBlock->getOffset();
+    int64_t len = curBlock->getNumBytes() - offset;
+    assert(offset >= 0 && len > 0);
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        if (nodes[i] == curNode
+                || std::binary_search(failedNodes.begin(), failedNodes.end(), nodes[i])) {
+            continue;
+        }
+
+        try {
+            node = shared_ptr<DatanodeInfo>(new DatanodeInfo(nodes[i]));
+#ifdef MOCK
+
+            if (stub) {
+                return stub->getBlockReader();
+            }
+
+#endif
+            return shared_ptr<BlockReader>(new RemoteBlockReader(
+                *curBlock, *node, *peerCache, offset, len,
+                curBlock->getToken(), filesystem->getClientName(), verify, *conf));
+        } catch (const HdfsIOException & e) {
+            std::string buffer;
+            LOG(LOG_ERROR,
+                "cannot setup hedged block reader for Block: %s file %s on Datanode: %s.\n%s\ntry another node",
+                curBlock->toString().c_str(), path.c_str(),
+                nodes[i].formatAddress().c_str(), GetExceptionDetail(e, buffer));
+            failedNodes.push_back(nodes[i]);
+            std::sort(failedNodes.begin(), failedNodes.end());
+        }
+    }
+
+    node.reset();
+    return shared_ptr<BlockReader>();
+}
+
+/**
+ * Read from the current block reader. If hedged read is enabled and the
+ * datanode does not respond within the threshold, read the same range from
+ * another replica as well and continue with whichever datanode responds first.
+ */
+int32_t InputStreamImpl::readWithHedging(char * buf, int32_t size) {
+    shared_ptr<BlockReader> primary = blockReader;
+
+    if (hedgedReadThreshold <= 0 || readFromUnderConstructedBlock
+            || primary->poll(hedgedReadThreshold)) {
+        return blockReader->read(buf, size);
+    }
+
+    shared_ptr<DatanodeInfo> node;
+    shared_ptr<BlockReader> hedge = setupHedgedBlockReader(node);
+
+    if (!hedge) {
+        return blockReader->read(buf, size);
+    }
+
+    ++hedgedReadOps;
+    LOG(DEBUG1, "InputStreamImpl: Datanode %s did not respond in %d ms for Block: %s file %s, "
+        "hedged read from Datanode %s.", curNode.formatAddress().c_str(), hedgedReadThreshold,
+        curBlock->toString().c_str(), path.c_str(), node->formatAddress().c_str());
+    int interval = hedgedReadThreshold < 10 ? hedgedReadThreshold : 10;
+    int readTimeout = conf->getInputReadTimeout();
+    steady_clock::time_point start = steady_clock::now();
+
+    /*
+     * The slow reader is dropped without sending the read status,
+     * so its connection is closed instead of returning to the peer cache.
+     */
+    while (!primary->poll(interval)) {
+        if (hedge->poll(interval)) {
+            ++hedgedReadWins;
+            blockReader = hedge;
+            hedgedNode = node;
+            curNode = *node;
+            return blockReader->read(buf, size);
+        }
+
+        if (ToMilliSeconds(start, steady_clock::now()) >= readTimeout) {
+            break;
+        }
+    }
+
+    return blockReader->read(buf, size);
+}
+
+int32_t InputStreamImpl::readOneBlock(char * buf, int32_t size, bool shouldUpdateMetadataOnFailure,
+                                      const char ** data) {
     bool temporaryDisableLocalRead = false;
     std::string buffer;
 
@@ -524,7 +661,18 @@ int32_t InputStreamImpl::readOneBlock(char * buf, int32_t size, bool shouldUpdat
             todo = todo < endOfCurBlock - cursor ?
                    todo : static_cast<int32_t>(endOfCurBlock - cursor);
             assert(blockReader);
-            todo = blockReader->read(buf, todo);
+            LocalBlockReader * local = NULL;
+
+            if (data && (local = dynamic_cast<LocalBlockReader *>(blockReader.get()))) {
+                todo = local->readZeroCopy(data, todo);
+            } else if (data) {
+                zeroCopyBuffer.resize(todo);
+                todo = readWithHedging(&zeroCopyBuffer[0], todo);
+                *data = &zeroCopyBuffer[0];
+            } else {
+                todo = readWithHedging(buf, todo);
+            }
+
             cursor += todo;
             /*
              * Exit the loop and function from here if success.
@@ -576,9 +724,10 @@ int32_t InputStreamImpl::readOneBlock(char * buf, int32_t size, bool shouldUpdat
  * To read data from hdfs.
  * @param buf the buffer used to filled.
  * @param size buffer size.
+ * @param data if not null, read without copying and output the address of the data instead of filling buf.
  * @return return the number of bytes filled in the buffer, it may less than size.
  */
-int32_t InputStreamImpl::readInternal(char * buf, int32_t size) {
+int32_t InputStreamImpl::readInternal(char * buf, int32_t size, const char ** data) {
     int updateMetadataOnFailure = conf->getMaxReadBlockRetry();
 
     try {
@@ -627,13 +776,14 @@ int32_t InputStreamImpl::readInternal(char * buf, int32_t size) {
                 seekToBlock(*lb);
             }
 
-            int32_t retval = readOneBlock(buf, size, updateMetadataOnFailure > 0);
+            int32_t retval = readOneBlock(buf, size, updateMetadataOnFailure > 0, data);
 
             /*
              * Now we have tried all replicas and failed.
              * We will update metadata once and try again.
              */
             if (retval < 0) {
+                filesystem->invalidateBlockLocations(path);
                 lbs.reset();
                 endOfCurBlock = 0;
                 --updateMetadataOnFailure;
@@ -814,6 +964,12 @@ int64_t InputStreamImpl::tell() {
  */
 void InputStreamImpl::close() {
     LOG(DEBUG2, "%p close file %s for read", this, path.c_str());
+
+    if (hedgedReadOps > 0) {
+        LOG(DEBUG1, "%p file %s issued %" PRId64 " hedged reads, %" PRId64 " of them won",
+            this, path.c_str(), hedgedReadOps, hedgedReadWins);
+    }
+
     closed = true;
     localRead = true;
     readFromUnderConstructedBlock = false;
@@ -824,6 +980,7 @@ void InputStreamImpl::close() {
     lastBlockBeingWrittenLength = 0;
     prefetchSize = 0;
     blockReader.reset();
+    hedgedNode.reset();
     curBlock.reset();
     lbs.reset();
     conf.reset();
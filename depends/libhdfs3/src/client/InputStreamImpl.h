@@ -78,6 +78,15 @@ public:
      */
     void readFully(char * buf, int64_t size);
 
+    /**
+     * To read data from hdfs without copying it into a caller buffer.
+     * Reading from a memory mapped local replica returns the data in page cache.
+     * @param buf output the address of the data, it is valid until the next operation on this stream.
+     * @param size the max number of bytes to be read.
+     * @return return the number of bytes available at buf, it may less than size.
+     */
+    int32_t readZeroCopy(const char ** buf, int32_t size);
+
     int64_t available();
 
     /**
@@ -124,11 +133,27 @@ public:
      */
     void setCryptoCodec(shared_ptr<CryptoCodec> cryptoCodec);
 
+    /**
+     * Get the number of hedged reads issued to another replica.
+     */
+    int64_t getHedgedReadOps() const {
+        return hedgedReadOps;
+    }
+
+    /**
+     * Get the number of hedged reads which returned before the original read.
+     */
+    int64_t getHedgedReadWins() const {
+        return hedgedReadWins;
+    }
+
 private:
     bool choseBestNode();
     bool isLocalNode();
-    int32_t readInternal(char * buf, int32_t size);
-    int32_t readOneBlock(char * buf, int32_t size, bool shouldUpdateMetadataOnFailure);
+    int32_t readInternal(char * buf, int32_t size, const char ** data = NULL);
+    int32_t readOneBlock(char * buf, int32_t size, bool shouldUpdateMetadataOnFailure,
+                         const char ** data);
+    int32_t readWithHedging(char * buf, int32_t size);
     int64_t getFileLength();
     int64_t readBlockLength(const LocatedBlock & b);
     void checkStatus();
@@ -138,6 +163,7 @@ private:
     void seekInternal(int64_t pos);
     void seekToBlock(const LocatedBlock & lb);
     void setupBlockReader(bool temporaryDisableLocalRead);
+    shared_ptr<BlockReader> setupHedgedBlockReader(shared_ptr<DatanodeInfo> & node);
     void updateBlockInfos();
 
 private:
@@ -149,13 +175,17 @@ private:
     exception_ptr lastError;
     FileStatus fileInfo;
     int maxGetBlockInfoRetry;
+    int hedgedReadThreshold;
     int64_t cursor;
     int64_t endOfCurBlock;
+    int64_t hedgedReadOps;
+    int64_t hedgedReadWins;
     int64_t lastBlockBeingWrittenLength;
     int64_t prefetchSize;
     PeerCache *peerCache;
     RpcAuth auth;
     shared_ptr<BlockReader> blockReader;
+    shared_ptr<DatanodeInfo> hedgedNode; //datanode referenced by the block reader of a won hedged read
     shared_ptr<FileSystemInter> filesystem;
     shared_ptr<LocatedBlock> curBlock;
     shared_ptr<LocatedBlocks> lbs;
@@ -163,6 +193,7 @@ private:
     std::string path;
     std::vector<DatanodeInfo> failedNodes;
     std::vector<char> localReaderBuffer;
+    std::vector<char> zeroCopyBuffer; //holds data returned by readZeroCopy if it cannot be read in place.
     shared_ptr<CryptoCodec> cryptoCodec;
     shared_ptr<KmsClientProvider> kcp;
     shared_ptr<RpcAuth> enAuth;
@@ -42,7 +42,7 @@ LocalBlockReader::LocalBlockReader(const shared_ptr<ReadShortCircuitInfo>& info,
                                    const ExtendedBlock& block, int64_t offset,
                                    bool verify, SessionConfig& conf,
                                    std::vector<char>& buffer)
-    : verify(verify),
+    : mapped(false), verify(verify),
       pbuffer(NULL),
       pMetaBuffer(NULL),
       block(block),
@@ -57,6 +57,7 @@ LocalBlockReader::LocalBlockReader(const shared_ptr<ReadShortCircuitInfo>& info,
     try {
         metaFd = info->getMetaFile();
         dataFd = info->getDataFile();
+        mapped = dynamic_cast<MappedFileWrapper *>(dataFd.get()) != NULL;
 
         std::vector<char> header;
         pMetaBuffer = metaFd->read(header, HEADER_SIZE);
@@ -132,23 +133,11 @@ void LocalBlockReader::readAndVerify(int32_t bufferSize) {
     pbuffer = dataFd->read(buffer, bufferSize);
     pMetaBuffer = metaFd->read(metaBuffer, chunks * checksumSize);
 
-    for (int i = 0; i < chunks; ++i) {
-        checksum->reset();
-        int chunk = chunkSize;
-
-        if (chunkSize * (i + 1) > bufferSize) {
-            chunk = bufferSize % chunkSize;
-        }
-
-        checksum->update(&pbuffer[i * chunkSize], chunk);
-        uint32_t target = ReadBigEndian32FromArray(
-                              &pMetaBuffer[i * checksumSize]);
-
-        if (target != checksum->getValue()) {
-            THROW(ChecksumException,
-                  "LocalBlockReader checksum not match for block: %s",
-                  block.toString().c_str());
-        }
+    if (checksum->verifyChunkedSums(pbuffer, bufferSize, chunkSize,
+                                    pMetaBuffer) >= 0) {
+        THROW(ChecksumException,
+              "LocalBlockReader checksum not match for block: %s",
+              block.toString().c_str());
     }
 }
 
@@ -185,9 +174,11 @@ int32_t LocalBlockReader::readInternal(char * buf, int32_t len) {
         return todo;
     }
 
-    /*
-     * fill buffer.
-     */
+    fillBuffer();
+    return readInternal(buf, todo);
+}
+
+void LocalBlockReader::fillBuffer() {
     int bufferSize = localBufferSize;
     bufferSize = bufferSize < length - cursor ? bufferSize : length - cursor;
     assert(bufferSize > 0);
@@ -201,7 +192,42 @@ int32_t LocalBlockReader::readInternal(char * buf, int32_t len) {
     position = 0;
     size = bufferSize;
     assert(position < size);
-    return readInternal(buf, todo);
+}
+
+int32_t LocalBlockReader::readZeroCopyInternal(const char ** data, int32_t len) {
+    int32_t todo = len;
+
+    /*
+     * return the data in buffer, with a mapped file it is the mapped region.
+     */
+    if (position < size) {
+        todo = todo < size - position ? todo : size - position;
+        *data = &pbuffer[position];
+        position += todo;
+        cursor += todo;
+        return todo;
+    }
+
+    /*
+     * end of block
+     */
+    todo = todo < length - cursor ? todo : length - cursor;
+
+    if (0 == todo) {
+        return 0;
+    }
+
+    /*
+     * nothing to verify, return the mapped region directly.
+     */
+    if (!verify && mapped) {
+        *data = dataFd->read(buffer, todo);
+        cursor += todo;
+        return todo;
+    }
+
+    fillBuffer();
+    return readZeroCopyInternal(data, todo);
 }
 
 int32_t LocalBlockReader::read(char * buf, int32_t size) {
@@ -220,6 +246,22 @@ int32_t LocalBlockReader::read(char * buf, int32_t size) {
     return 0;
 }
 
+int32_t LocalBlockReader::readZeroCopy(const char ** data, int32_t size) {
+    try {
+        return readZeroCopyInternal(data, size);
+    } catch (const HdfsCanceled & e) {
+        throw;
+    } catch (const HdfsException & e) {
+        info->setValid(false);
+        NESTED_THROW(HdfsIOException,
+                     "LocalBlockReader failed to read from position: %" PRId64 ", length: %d, block: %s.",
+                     cursor, size, block.toString().c_str());
+    }
+
+    assert(!"cannot reach here");
+    return 0;
+}
+
 void LocalBlockReader::skip(int64_t len) {
     assert(len < length - cursor);
 
@@ -65,15 +65,40 @@ public:
      */
     virtual void skip(int64_t len);
 
+    /**
+     * Local block files never block on a datanode.
+     * @param timeout the time to wait in millisecond.
+     * @return always true.
+     */
+    virtual bool poll(int timeout) {
+        return true;
+    }
+
+    /**
+     * To read data from block without copying it into a caller buffer.
+     * If the block file is memory mapped, the returned data points into
+     * the mapped region and the checksum is verified in place, otherwise
+     * it points into the reader's internal buffer.
+     * @param data output the address of the data, it is valid until the next
+     *  operation on this reader.
+     * @param size the max number of bytes to be read.
+     * @return return the number of bytes available at data,
+     *  it may less than size. Return 0 if reach the end of block.
+     */
+    int32_t readZeroCopy(const char ** data, int32_t size);
+
 private:
     /**
      * Fill buffer and verify checksum.
      * @param bufferSize The size of buffer.
      */
     void readAndVerify(int32_t bufferSize);
+    void fillBuffer();
     int32_t readInternal(char * buf, int32_t len);
+    int32_t readZeroCopyInternal(const char ** data, int32_t len);
 
 private:
+    bool mapped; //block files are memory mapped or not.
     bool verify; //verify checksum or not.
     const char * pbuffer;
     const char * pMetaBuffer;
@@ -40,9 +40,10 @@ namespace Hdfs {
 namespace Internal {
 
 OutputStreamImpl::OutputStreamImpl() :
-/*heartBeatStop(true),*/ closed(true), isAppend(false), syncBlock(false), checksumSize(0), chunkSize(
+/*heartBeatStop(true),*/ closed(true), isAppend(false), streamerBusy(false), streamerFailed(
+        false), streamerStop(false), syncBlock(false), checksumSize(0), chunkSize(
         0), chunksPerPacket(0), closeTimeout(0), heartBeatInterval(0), packetSize(0), position(
-            0), replication(0), blockSize(0), bytesWritten(0), cursor(0), lastFlushed(
+            0), replication(0), streamerQueueSize(0), blockSize(0), bytesWritten(0), cursor(0), lastFlushed(
                 0), nextSeqNo(0), packets(0), cryptoCodec(NULL), kcp(NULL) {
     if (HWCrc32c::available()) {
         checksum = shared_ptr < Checksum > (new HWCrc32c());
@@ -236,6 +237,7 @@ void OutputStreamImpl::openInternal(shared_ptr<FileSystemInter> fs, const char *
     packetSize = conf->getDefaultPacketSize();
     heartBeatInterval = conf->getHeartBeatInterval();
     closeTimeout = conf->getCloseFileTimeout();
+    streamerQueueSize = conf->getStreamerQueueSize();
 
     if (packetSize < chunkSize) {
         THROW(InvalidParameter,
@@ -346,10 +348,17 @@ void OutputStreamImpl::appendInternal(const char * buf, int64_t size) {
          * bypass buffer.
          */
         if (0 == position && todo >= static_cast<int64_t>(buffer.size())) {
-            checksum->update(buf + size - todo, batch);
-            appendChunkToPacket(buf + size - todo, batch);
+            int appended = appendChunksToPacket(buf + size - todo, todo);
+
+            if (appended > 0) {
+                batch = appended;
+            } else {
+                checksum->update(buf + size - todo, batch);
+                appendChunkToPacket(buf + size - todo, batch);
+                checksum->reset();
+            }
+
             bytesWritten += batch;
-            checksum->reset();
         } else {
             checksum->update(buf + size - todo, batch);
             memcpy(&buffer[position], buf + size - todo, batch);
@@ -367,7 +376,12 @@ void OutputStreamImpl::appendInternal(const char * buf, int64_t size) {
 
         if (currentPacket
                 && (currentPacket->isFull() || bytesWritten == blockSize)) {
-            sendPacket(currentPacket);
+            if (streamerQueueSize > 0) {
+                queuePacket(currentPacket, false);
+                currentPacket.reset();
+            } else {
+                sendPacket(currentPacket);
+            }
 
             if (isAppend) {
                 isAppend = false;
@@ -377,7 +391,11 @@ void OutputStreamImpl::appendInternal(const char * buf, int64_t size) {
             }
 
             if (bytesWritten == blockSize) {
-                closePipeline();
+                if (streamerQueueSize > 0) {
+                    queueEndOfBlock();
+                } else {
+                    closePipeline();
+                }
             }
         }
     }
@@ -398,24 +416,200 @@ void OutputStreamImpl::appendChunkToPacket(const char * buf, int size) {
     currentPacket->increaseNumChunks();
 }
 
+/**
+ * Append the whole chunks at the head of buf, up to the end of the current
+ * packet or block, checksumming them in one batch.
+ * @return The number of bytes appended.
+ */
+int OutputStreamImpl::appendChunksToPacket(const char * buf, int64_t size) {
+    assert(NULL != buf && size > 0);
+
+    if (!currentPacket) {
+        currentPacket = packets.getPacket(packetSize, chunksPerPacket, bytesWritten,
+                                          nextSeqNo++, checksumSize);
+    }
+
+    size = size < blockSize - bytesWritten ? size : blockSize - bytesWritten;
+    size = size < packetSize ? size : packetSize;
+    return currentPacket->addChunks(buf, static_cast<int>(size), buffer.size(),
+                                    *checksum);
+}
+
 void OutputStreamImpl::sendPacket(shared_ptr<Packet> packet) {
     if (!pipeline) {
-        setupPipeline();
+        setupPipeline(isAppend, *packet);
     }
 
-    pipeline->send(currentPacket);
+    pipeline->send(packet);
     currentPacket.reset();
     lastSend = steady_clock::now();
 }
 
-void OutputStreamImpl::setupPipeline() {
-    assert(currentPacket);
+/**
+ * Hand a packet over to the streamer thread, block while the queue is full.
+ * @param packet the packet to be sent.
+ * @param lastPacketInBlock close the pipeline with the given empty packet.
+ */
+void OutputStreamImpl::queuePacket(shared_ptr<Packet> packet, bool lastPacketInBlock) {
+    StreamerEntry entry;
+    entry.append = isAppend;
+    entry.lastPacketInBlock = lastPacketInBlock;
+    entry.packet = packet;
+
+    {
+        unique_lock<mutex> lock(streamerMut);
+
+        if (!streamer.joinable()) {
+            streamerStop = false;
+            CREATE_THREAD(streamer, bind(&OutputStreamImpl::streamerRoutine, this));
+        }
+
+        while (!streamerFailed
+                && static_cast<int>(streamerQueue.size()) >= streamerQueueSize) {
+            condStreamer.wait(lock);
+        }
+
+        if (!streamerFailed) {
+            streamerQueue.push_back(entry);
+            condStreamer.notify_all();
+            return;
+        }
+    }
+
+    /*
+     * the streamer thread failed, report its error.
+     */
+    checkStatus();
+}
+
+/**
+ * Queue the empty last packet of the current block,
+ * the streamer thread will close the pipeline when it is sent.
+ */
+void OutputStreamImpl::queueEndOfBlock() {
+    shared_ptr<Packet> lastPacket = packets.getPacket(packetSize, chunksPerPacket,
+                                    bytesWritten, nextSeqNo++, checksumSize);
+
+    if (syncBlock) {
+        lastPacket->setSyncFlag(syncBlock);
+    }
+
+    queuePacket(lastPacket, true);
+    bytesWritten = 0;
+}
+
+/**
+ * Wait until the streamer thread has sent all queued packets,
+ * after that the pipeline can be used by the calling thread.
+ * Rethrow the error if the streamer thread failed.
+ */
+void OutputStreamImpl::waitForStreamer() {
+    if (!streamer.joinable()) {
+        return;
+    }
+
+    bool failed;
+
+    {
+        unique_lock<mutex> lock(streamerMut);
+
+        while (!streamerFailed && (streamerBusy || !streamerQueue.empty())) {
+            condStreamer.wait(lock);
+        }
+
+        failed = streamerFailed;
+    }
+
+    if (failed) {
+        lock_guard < mutex > lock(mut);
+        assert(lastError);
+        rethrow_exception(lastError);
+    }
+}
+
+void OutputStreamImpl::stopStreamer() {
+    if (!streamer.joinable()) {
+        return;
+    }
+
+    {
+        lock_guard<mutex> lock(streamerMut);
+        streamerStop = true;
+        condStreamer.notify_all();
+    }
+
+    streamer.join();
+    streamerQueue.clear();
+    streamerBusy = false;
+    streamerFailed = false;
+    streamerStop = false;
+}
+
+/**
+ * Send the queued packets and close the pipeline at the end of each block,
+ * so that append() only needs to fill the packets.
+ * The pipeline is owned by this thread while it is running,
+ * flush, sync and close wait for the queue to be drained before using it.
+ */
+void OutputStreamImpl::streamerRoutine() {
+    while (true) {
+        StreamerEntry entry;
+
+        {
+            unique_lock<mutex> lock(streamerMut);
+
+            while (!streamerStop && streamerQueue.empty()) {
+                condStreamer.wait(lock);
+            }
+
+            if (streamerStop) {
+                return;
+            }
+
+            entry = streamerQueue.front();
+            streamerQueue.pop_front();
+            streamerBusy = true;
+            condStreamer.notify_all();
+        }
+
+        bool failed = false;
+
+        try {
+            if (entry.lastPacketInBlock) {
+                closeBlock(entry.packet);
+            } else {
+                if (!pipeline) {
+                    setupPipeline(entry.append, *entry.packet);
+                }
+
+                pipeline->send(entry.packet);
+            }
+        } catch (...) {
+            setError(current_exception());
+            failed = true;
+        }
+
+        {
+            lock_guard<mutex> lock(streamerMut);
+            streamerBusy = false;
+
+            if (failed) {
+                streamerFailed = true;
+                streamerQueue.clear();
+            }
+
+            condStreamer.notify_all();
+        }
+    }
+}
+
+void OutputStreamImpl::setupPipeline(bool append, const Packet & firstPacket) {
 #ifdef MOCK
     pipeline = stub->getPipeline();
 #else
-    pipeline = shared_ptr<Pipeline>(new PipelineImpl(isAppend, path.c_str(), *conf, filesystem,
+    pipeline = shared_ptr<Pipeline>(new PipelineImpl(append, path.c_str(), *conf, filesystem,
                                     CHECKSUM_TYPE_CRC32C, conf->getDefaultChunkSize(), replication,
-                                    currentPacket->getOffsetInBlock(), packets, lastBlock));
+                                    firstPacket.getOffsetInBlock(), packets, lastBlock));
 #endif
     lastSend = steady_clock::now();
     /*
@@ -454,6 +648,8 @@ void OutputStreamImpl::flushInternal(bool needSync) {
         lastFlushed = cursor;
     }
 
+    waitForStreamer();
+
     if (position > 0) {
         appendChunkToPacket(&buffer[0], position);
     }
@@ -567,12 +763,20 @@ void OutputStreamImpl::closePipeline() {
         currentPacket->setSyncFlag(syncBlock);
     }
 
-    lastBlock = pipeline->close(currentPacket);
-    assert(lastBlock);
+    closeBlock(currentPacket);
     currentPacket.reset();
+    bytesWritten = 0;
+}
+
+/**
+ * Send the empty last packet of the block and close the pipeline.
+ */
+void OutputStreamImpl::closeBlock(shared_ptr<Packet> lastPacket) {
+    assert(pipeline);
+    lastBlock = pipeline->close(lastPacket);
+    assert(lastBlock);
     pipeline.reset();
     filesystem->fsync(path);
-    bytesWritten = 0;
 }
 
 void OutputStreamImpl::close() {
@@ -583,6 +787,8 @@ void OutputStreamImpl::close() {
     }
 
     try {
+        waitForStreamer();
+
         //pipeline may be broken
         if (!lastError) {
             if (lastFlushed != cursor && position > 0) {
@@ -616,6 +822,7 @@ void OutputStreamImpl::close() {
 }
 
 void OutputStreamImpl::reset() {
+    stopStreamer();
     blockSize = 0;
     bytesWritten = 0;
     checksum->reset();
@@ -638,6 +845,7 @@ void OutputStreamImpl::reset() {
     pipeline.reset();
     position = 0;
     replication = 0;
+    streamerQueueSize = 0;
     syncBlock = false;
 }
 
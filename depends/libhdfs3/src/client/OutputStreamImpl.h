@@ -37,6 +37,9 @@
 #include "Thread.h"
 #include "CryptoCodec.h"
 #include "KmsClientProvider.h"
+
+#include <deque>
+
 #ifdef MOCK
 #include "PipelineStub.h"
 #endif
@@ -128,8 +131,10 @@ public:
 
 private:
     void appendChunkToPacket(const char * buf, int size);
+    int appendChunksToPacket(const char * buf, int64_t size);
     void appendInternal(const char * buf, int64_t size);
     void checkStatus();
+    void closeBlock(shared_ptr<Packet> lastPacket);
     void closePipeline();
     void completeFile(bool throwError);
     void computePacketChunkSize();
@@ -139,16 +144,35 @@ private:
     void openInternal(shared_ptr<FileSystemInter> fs, const char * path, int flag,
                       const Permission & permission, bool createParent, int replication,
                       int64_t blockSize);
+    void queueEndOfBlock();
+    void queuePacket(shared_ptr<Packet> packet, bool lastPacketInBlock);
     void reset();
     void sendPacket(shared_ptr<Packet> packet);
-    void setupPipeline();
+    void setupPipeline(bool append, const Packet & firstPacket);
+    void stopStreamer();
+    void streamerRoutine();
+    void waitForStreamer();
+
+private:
+    /*
+     * A packet handed over to the streamer thread.
+     */
+    struct StreamerEntry {
+        bool append; //setup the pipeline for append if it is not setup yet.
+        bool lastPacketInBlock; //close the pipeline with this empty packet.
+        shared_ptr<Packet> packet;
+    };
 
 private:
     //atomic<bool> heartBeatStop;
     bool closed;
     bool isAppend;
+    bool streamerBusy; //streamer thread is sending an entry.
+    bool streamerFailed; //streamer thread got an error and discards the queued packets.
+    bool streamerStop;
     bool syncBlock;
     //condition_variable condHeartBeatSender;
+    condition_variable condStreamer;
     exception_ptr lastError;
     int checksumSize;
     int chunkSize;
@@ -158,12 +182,14 @@ private:
     int packetSize;
     int position; //cursor in buffer
     int replication;
+    int streamerQueueSize; //max packets queued for the streamer thread, 0 if the streamer is disabled.
     int64_t blockSize; //max size of block
     int64_t bytesWritten; //the size of bytes has be written into packet (not include the data in chunk buffer).
     int64_t cursor; //cursor in file.
     int64_t lastFlushed; //the position last flushed
     int64_t nextSeqNo;
     mutex mut;
+    mutex streamerMut;
     PacketPool packets;
     shared_ptr<Checksum> checksum;
     shared_ptr<FileSystemInter> filesystem;
@@ -171,10 +197,12 @@ private:
     shared_ptr<Packet> currentPacket;
     shared_ptr<Pipeline> pipeline;
     shared_ptr<SessionConfig> conf;
+    std::deque<StreamerEntry> streamerQueue;
     std::string path;
     std::vector<char> buffer;
     steady_clock::time_point lastSend;
     //thread heartBeatSender;
+    thread streamer;
     FileStatus fileStatus;
     shared_ptr<CryptoCodec> cryptoCodec;
     shared_ptr<KmsClientProvider> kcp;
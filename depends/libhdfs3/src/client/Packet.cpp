@@ -85,6 +85,31 @@ void Packet::addData(const char * buf, int size) {
     assert(dataPos >= 0);
 }
 
+int Packet::addChunks(const char * buf, int size, int chunkSize, Checksum & checksum) {
+    assert(checksumSize == static_cast<int>(sizeof(uint32_t)));
+    int chunks = size / chunkSize;
+    chunks = chunks < maxChunks - numChunks ? chunks : maxChunks - numChunks;
+
+    if (chunks <= 0) {
+        return 0;
+    }
+
+    size = chunks * chunkSize;
+
+    if (checksumPos + chunks * checksumSize > dataStart
+            || size + dataPos > static_cast<int>(buffer.size())) {
+        THROW(HdfsIOException,
+              "Packet: failed add chunks to packet, packet size is too small");
+    }
+
+    checksum.calculateChunkedSums(buf, size, chunkSize, &buffer[checksumPos]);
+    checksumPos += chunks * checksumSize;
+    memcpy(&buffer[dataPos], buf, size);
+    dataPos += size;
+    numChunks += chunks;
+    return size;
+}
+
 void Packet::setSyncFlag(bool sync) {
     syncBlock = sync;
 }
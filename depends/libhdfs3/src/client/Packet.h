@@ -25,6 +25,8 @@
 #include <stdint.h>
 #include <vector>
 
+#include "Checksum.h"
+
 #define HEART_BEAT_SEQNO -1
 
 namespace Hdfs {
@@ -76,6 +78,17 @@ public:
 
     void addData(const char * buf, int size);
 
+    /**
+     * Append as many whole chunks of buf as the packet has room for,
+     * with their checksums calculated in one batch.
+     * @param buf The data to append.
+     * @param size The data size.
+     * @param chunkSize The bytes per checksum.
+     * @param checksum The checksum used to calculate the chunk sums.
+     * @return The number of bytes appended.
+     */
+    int addChunks(const char * buf, int size, int chunkSize, Checksum & checksum);
+
     void setSyncFlag(bool sync);
 
     void increaseNumChunks();
@@ -32,13 +32,22 @@ PacketPool::PacketPool(int size) :
 
 shared_ptr<Packet> PacketPool::getPacket(int pktSize, int chunksPerPkt,
         int64_t offsetInBlock, int64_t seqno, int checksumSize) {
-    if (packets.empty()) {
+    shared_ptr<Packet> retval;
+
+    {
+        lock_guard<mutex> lock(mut);
+
+        if (!packets.empty()) {
+            retval = packets.front();
+            packets.pop_front();
+        }
+    }
+
+    if (!retval) {
         return shared_ptr<Packet>(
                    new Packet(pktSize, chunksPerPkt, offsetInBlock, seqno,
                               checksumSize));
     } else {
-        shared_ptr<Packet> retval = packets.front();
-        packets.pop_front();
         retval->reset(pktSize, chunksPerPkt, offsetInBlock, seqno,
                       checksumSize);
         return retval;
@@ -46,6 +55,8 @@ shared_ptr<Packet> PacketPool::getPacket(int pktSize, int chunksPerPkt,
 }
 
 void PacketPool::relesePacket(shared_ptr<Packet> packet) {
+    lock_guard<mutex> lock(mut);
+
     if (static_cast<int>(packets.size()) >= maxSize) {
         return;
     }
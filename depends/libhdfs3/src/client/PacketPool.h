@@ -22,6 +22,7 @@
 #ifndef _HDFS_LIBHDFS3_CLIENT_PACKETPOOL_H_
 #define _HDFS_LIBHDFS3_CLIENT_PACKETPOOL_H_
 #include "Memory.h"
+#include "Thread.h"
 
 #include <deque>
 
@@ -38,6 +39,9 @@ class Packet;
  * The Pipeline's packet queue size is not larger than the PacketPool's max size,
  * otherwise the write operation will be pending for the ack.
  * Once the ack is received, packet will reutrn back to the PacketPool to reuse.
+ *
+ * Packets may be taken by the writing thread and returned by the streamer thread,
+ * so the pool is guarded by a mutex.
  */
 class PacketPool {
 public:
@@ -56,6 +60,7 @@ public:
 
 private:
     int maxSize;
+    mutex mut;
     std::deque<shared_ptr<Packet> > packets;
 };
 
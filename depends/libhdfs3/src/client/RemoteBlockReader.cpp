@@ -284,28 +284,23 @@ void RemoteBlockReader::verifyChecksum(int chunks) {
     int dataSize = lastHeader->getDataLen();
     char * pchecksum = &buffer[0];
     char * pdata = &buffer[0] + (chunks * checksumSize);
+    assert(chunks == (dataSize + chunkSize - 1) / chunkSize);
+    assert(checksumSize == static_cast<int>(sizeof(uint32_t)));
 
-    for (int i = 0; i < chunks; ++i) {
-        int size = chunkSize < dataSize ? chunkSize : dataSize;
-        dataSize -= size;
-        checksum->reset();
-        checksum->update(pdata + (i * chunkSize), size);
-        uint32_t result = checksum->getValue();
-        uint32_t target = ReadBigEndian32FromArray(pchecksum + (i * checksumSize));
-
-        if (result != target) {
-            THROW(ChecksumException, "RemoteBlockReader: checksum not match for Block: %s, on Datanode: %s",
-                  binfo.toString().c_str(), datanode.formatAddress().c_str());
-        }
+    if (checksum->verifyChunkedSums(pdata, dataSize, chunkSize, pchecksum) >= 0) {
+        THROW(ChecksumException, "RemoteBlockReader: checksum not match for Block: %s, on Datanode: %s",
+              binfo.toString().c_str(), datanode.formatAddress().c_str());
     }
-
-    assert(0 == dataSize);
 }
 
 int64_t RemoteBlockReader::available() {
     return size - position > 0 ? size - position : 0;
 }
 
+bool RemoteBlockReader::poll(int timeout) {
+    return cursor >= endOffset || size - position > 0 || in->poll(timeout);
+}
+
 int32_t RemoteBlockReader::read(char * buf, int32_t len) {
     assert(0 != len && NULL != buf);
 
@@ -67,6 +67,13 @@ public:
      */
     virtual void skip(int64_t len);
 
+    /**
+     * Wait until data can be read without blocking on the datanode.
+     * @param timeout the time to wait in millisecond.
+     * @return return true if buffered data is available or the socket becomes readable.
+     */
+    virtual bool poll(int timeout);
+
 private:
     bool readTrailingEmptyPacket();
     shared_ptr<PacketHeader> readPacketHeader();
@@ -24,6 +24,8 @@
 
 #include <stdint.h>
 
+#include "BigEndian.h"
+
 #define CHECKSUM_TYPE_SIZE 1
 #define CHECKSUM_BYTES_PER_CHECKSUM_SIZE 4
 #define CHECKSUM_TYPE_CRC32C 2
@@ -53,6 +55,65 @@ public:
      */
     virtual void update(const void * b, int len) = 0;
 
+    /**
+     * Calculates the checksum of every bytesPerChecksum bytes of data,
+     * the way HDFS lays the checksums out in a packet or a meta file.
+     * The last chunk may be shorter. The checksum is reset on return.
+     * @param data The buffer of data.
+     * @param len The buffer length.
+     * @param bytesPerChecksum The chunk size.
+     * @param sums Receives one big endian 4 bytes checksum per chunk.
+     */
+    virtual void calculateChunkedSums(const char * data, int len,
+                                      int bytesPerChecksum, char * sums) {
+        for (; len > 0; len -= bytesPerChecksum) {
+            int size = len < bytesPerChecksum ? len : bytesPerChecksum;
+            reset();
+            update(data, size);
+            sums = WriteBigEndian32ToArray(getValue(), sums);
+            data += size;
+        }
+
+        reset();
+    }
+
+    /**
+     * Verifies data against the big endian checksums of its chunks.
+     * @param data The buffer of data.
+     * @param len The buffer length.
+     * @param bytesPerChecksum The chunk size.
+     * @param sums One big endian 4 bytes checksum per chunk.
+     * @return The index of the first mismatched chunk, -1 if all match.
+     */
+    int verifyChunkedSums(const char * data, int len, int bytesPerChecksum,
+                          const char * sums) {
+        const int batch = 64;
+        char calculated[batch * sizeof(uint32_t)];
+
+        for (int chunk = 0; len > 0; chunk += batch) {
+            int size = len < batch * bytesPerChecksum ?
+                       len : batch * bytesPerChecksum;
+            int chunks = (size + bytesPerChecksum - 1) / bytesPerChecksum;
+            calculateChunkedSums(data, size, bytesPerChecksum, calculated);
+
+            if (memcmp(calculated, sums, chunks * sizeof(uint32_t)) != 0) {
+                for (int i = 0; i < chunks; ++i) {
+                    if (memcmp(calculated + i * sizeof(uint32_t),
+                               sums + i * sizeof(uint32_t),
+                               sizeof(uint32_t)) != 0) {
+                        return chunk + i;
+                    }
+                }
+            }
+
+            data += size;
+            sums += chunks * sizeof(uint32_t);
+            len -= size;
+        }
+
+        return -1;
+    }
+
     /**
      * Destroy the instance.
      */
@@ -21,7 +21,9 @@
  */
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 
+#include "BigEndian.h"
 #include "HWCrc32c.h"
 
 #if ((defined(__X86__) || defined(__i386__) || defined(i386) || defined(_M_IX86) || defined(__386__) || defined(__x86_64__) || defined(_M_X64)))
@@ -117,6 +119,76 @@ void HWCrc32c::update(const void * b, int len) {
     }
 }
 
+void HWCrc32c::calculateChunkedSums(const char * data, int len,
+                                    int bytesPerChecksum, char * sums) {
+    for (; len >= 3 * bytesPerChecksum; len -= 3 * bytesPerChecksum) {
+        uint32_t crc0 = 0xFFFFFFFF, crc1 = 0xFFFFFFFF, crc2 = 0xFFFFFFFF;
+        update3(data, bytesPerChecksum, &crc0, &crc1, &crc2);
+        sums = WriteBigEndian32ToArray(~crc0, sums);
+        sums = WriteBigEndian32ToArray(~crc1, sums);
+        sums = WriteBigEndian32ToArray(~crc2, sums);
+        data += 3 * bytesPerChecksum;
+    }
+
+    for (; len > 0; len -= bytesPerChecksum) {
+        int size = len < bytesPerChecksum ? len : bytesPerChecksum;
+        reset();
+        update(data, size);
+        sums = WriteBigEndian32ToArray(getValue(), sums);
+        data += size;
+    }
+
+    reset();
+}
+
+/*
+ * Update the crc of three consecutive chunks of len bytes. A crc32
+ * instruction has a latency of three cycles but can issue every cycle,
+ * so one chain alone leaves two thirds of the unit idle.
+ */
+void HWCrc32c::update3(const char * b, int len, uint32_t * crc0,
+                       uint32_t * crc1, uint32_t * crc2) {
+    const char * p0 = b;
+    const char * p1 = b + len;
+    const char * p2 = b + 2 * len;
+    uint32_t c0 = *crc0, c1 = *crc1, c2 = *crc2;
+#if defined(__LP64__)
+    uint64_t v0, v1, v2;
+    const int bytes = sizeof(uint64_t);
+#else
+    uint32_t v0, v1, v2;
+    const int bytes = sizeof(uint32_t);
+#endif
+
+    for (int i = len / bytes; i > 0; --i) {
+        memcpy(&v0, p0, bytes);
+        memcpy(&v1, p1, bytes);
+        memcpy(&v2, p2, bytes);
+#if defined(__LP64__)
+        c0 = static_cast<uint32_t>(_mm_crc32_u64(c0, v0));
+        c1 = static_cast<uint32_t>(_mm_crc32_u64(c1, v1));
+        c2 = static_cast<uint32_t>(_mm_crc32_u64(c2, v2));
+#else
+        c0 = _mm_crc32_u32(c0, v0);
+        c1 = _mm_crc32_u32(c1, v1);
+        c2 = _mm_crc32_u32(c2, v2);
+#endif
+        p0 += bytes;
+        p1 += bytes;
+        p2 += bytes;
+    }
+
+    for (int i = len % bytes; i > 0; --i) {
+        c0 = _mm_crc32_u8(c0, *reinterpret_cast<const uint8_t *>(p0++));
+        c1 = _mm_crc32_u8(c1, *reinterpret_cast<const uint8_t *>(p1++));
+        c2 = _mm_crc32_u8(c2, *reinterpret_cast<const uint8_t *>(p2++));
+    }
+
+    *crc0 = c0;
+    *crc1 = c1;
+    *crc2 = c2;
+}
+
 void HWCrc32c::updateInt64(const char * b, int len) {
     assert(len < 8);
 
@@ -55,6 +55,14 @@ public:
      */
     void update(const void * b, int len);
 
+    /**
+     * Interleaves the CRC32 instructions of three chunks at a time, so the
+     * independent dependency chains fill the pipeline of the CRC unit.
+     * @ref Checksum#calculateChunkedSums(const char *, int, int, char *)
+     */
+    void calculateChunkedSums(const char * data, int len,
+                              int bytesPerChecksum, char * sums);
+
     /**
      * Destory an HWCrc32 instance.
      */
@@ -70,6 +78,9 @@ public:
 private:
     void updateInt64(const char * b, int len);
 
+    static void update3(const char * b, int len, uint32_t * crc0,
+                        uint32_t * crc1, uint32_t * crc2);
+
 private:
     uint32_t crc;
 };
@@ -120,6 +120,8 @@ SessionConfig::SessionConfig(const Config & conf) {
             &packetPoolSize, "output.packetpool.size", 1024
         }, {
             &heartBeatInterval, "output.heeartbeat.interval", 10 * 1000
+        }, {
+            &streamerQueueSize, "output.streamer.queue.size", 0, bind(CheckRangeGE<int32_t>, _1, _2, 0)
         }, {
             &rpcMaxHARetry, "dfs.client.failover.max.attempts", 15, bind(CheckRangeGE<int32_t>, _1, _2, 0)
         }, {
@@ -128,6 +130,12 @@ SessionConfig::SessionConfig(const Config & conf) {
             &socketCacheExpiry, "dfs.client.socketcache.expiryMsec", 3000, bind(CheckRangeGE<int32_t>, _1, _2, 0)
         }, {
             &socketCacheCapacity, "dfs.client.socketcache.capacity", 16, bind(CheckRangeGE<int32_t>, _1, _2, 0)
+        }, {
+            &hedgedReadThreshold, "dfs.client.hedged.read.threshold.millis", 0, bind(CheckRangeGE<int32_t>, _1, _2, 0)
+        }, {
+            &blockLocationCacheCapacity, "dfs.client.blocklocations.cache.capacity", 1000, bind(CheckRangeGE<int32_t>, _1, _2, 0)
+        }, {
+            &blockLocationCacheExpiry, "dfs.client.blocklocations.cache.expiryMsec", 10 * 1000, bind(CheckRangeGE<int32_t>, _1, _2, 0)
         }, {
             &cryptoBufferSize, "hadoop.security.crypto.buffer.size", 8192
         }, {
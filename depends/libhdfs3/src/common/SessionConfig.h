@@ -229,6 +229,18 @@ public:
         this->packetPoolSize = packetPoolSize;
     }
 
+    /*
+     * The number of packets queued for the background streamer thread,
+     * 0 sends packets on the writing thread.
+     */
+    int32_t getStreamerQueueSize() const {
+        return streamerQueueSize;
+    }
+
+    void setStreamerQueueSize(int32_t streamerQueueSize) {
+        this->streamerQueueSize = streamerQueueSize;
+    }
+
     int32_t getCloseFileTimeout() const {
         return closeFileTimeout;
     }
@@ -309,6 +321,29 @@ public:
       return socketCacheCapacity;
     }
 
+    /*
+     * Milliseconds to wait for a remote read before issuing a hedged read
+     * to another replica, 0 disables hedged reads.
+     */
+    int32_t getHedgedReadThreshold() const {
+        return hedgedReadThreshold;
+    }
+
+    void setHedgedReadThreshold(int32_t hedgedReadThreshold) {
+        this->hedgedReadThreshold = hedgedReadThreshold;
+    }
+
+    /*
+     * The number of files whose located blocks are cached, 0 disables the cache.
+     */
+    int32_t getBlockLocationCacheCapacity() const {
+        return blockLocationCacheCapacity;
+    }
+
+    int32_t getBlockLocationCacheExpiry() const {
+        return blockLocationCacheExpiry;
+    }
+
     const std::string& getKmsUrl() const {
         return kmsUrl;
     }
@@ -373,6 +408,9 @@ public:
     int32_t prefetchSize;
     int32_t socketCacheCapacity;
     int32_t socketCacheExpiry;
+    int32_t hedgedReadThreshold;
+    int32_t blockLocationCacheCapacity;
+    int32_t blockLocationCacheExpiry;
     std::string domainSocketPath;
 
     /*
@@ -386,6 +424,7 @@ public:
     int32_t outputReadTimeout;
     int32_t outputWriteTimeout;
     int32_t packetPoolSize;
+    int32_t streamerQueueSize;
     int32_t heartBeatInterval;
     int32_t closeFileTimeout;
     std::string kmsUrl;
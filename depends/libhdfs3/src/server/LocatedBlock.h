@@ -98,11 +98,35 @@ public:
         this->storageIDs = sid;
     }
 
+    const std::vector<bool> & getCachedLocations() const {
+        return cached;
+    }
+
+    std::vector<bool> & mutableCachedLocations() {
+        return cached;
+    }
+
+    /**
+     * Check if the replica on the given datanode is cached in its memory.
+     * @param node the datanode to be checked.
+     * @return return true if the datanode reports the replica as cached.
+     */
+    bool isCachedOn(const DatanodeInfo & node) const {
+        for (size_t i = 0; i < locs.size() && i < cached.size(); ++i) {
+            if (locs[i] == node) {
+                return cached[i];
+            }
+        }
+
+        return false;
+    }
+
 private:
     int64_t offset;
     bool corrupt;
     std::vector<DatanodeInfo> locs;
     std::vector<std::string> storageIDs;
+    std::vector<bool> cached;
     Token token;
 };
 
@@ -142,6 +142,16 @@ static inline shared_ptr<LocatedBlock> Convert(const LocatedBlockProto & proto)
         }
     }
 
+    if (proto.iscached_size() > 0) {
+        assert(proto.iscached_size() == proto.locs_size());
+        std::vector<bool> & cached = lb->mutableCachedLocations();
+        cached.resize(proto.iscached_size());
+
+        for (int i = 0; i < proto.iscached_size(); ++i) {
+            cached[i] = proto.iscached(i);
+        }
+    }
+
     Convert(*lb, proto.b());
     lb->setOffset(proto.offset());
     lb->setCorrupt(proto.corrupt());
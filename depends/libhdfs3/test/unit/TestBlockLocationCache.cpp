@@ -0,0 +1,125 @@
+/********************************************************************
+ * 2014 -
+ * open source under Apache License Version 2.0
+ ********************************************************************/
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "client/BlockLocationCache.h"
+#include "server/LocatedBlocks.h"
+#include "SessionConfig.h"
+#include "Thread.h"
+#include "XmlConfig.h"
+
+using namespace Hdfs;
+using namespace Hdfs::Internal;
+
+static void BuildBlocks(LocatedBlocksImpl & lbs, int numBlocks, int64_t blockSize) {
+    lbs.setFileLength(numBlocks * blockSize);
+    lbs.setIsLastBlockComplete(true);
+    lbs.setUnderConstruction(false);
+    lbs.getBlocks().clear();
+
+    for (int i = 0; i < numBlocks; ++i) {
+        LocatedBlock lb;
+        lb.setBlockId(i + 1);
+        lb.setOffset(i * blockSize);
+        lb.setNumBytes(blockSize);
+        lbs.getBlocks().push_back(lb);
+    }
+}
+
+TEST(TestBlockLocationCache, TestHitAndMiss) {
+    Config conf;
+    SessionConfig sconf(conf);
+    BlockLocationCache cache(sconf);
+    LocatedBlocksImpl lbs, cached;
+    BuildBlocks(lbs, 4, 1024);
+    EXPECT_FALSE(cache.get("/file", 0, 4096, 4096, 100, cached));
+    cache.put("/file", 0, 4096, 4096, 100, lbs);
+    ASSERT_TRUE(cache.get("/file", 0, 4096, 4096, 100, cached));
+    EXPECT_EQ(4096, cached.getFileLength());
+    EXPECT_TRUE(cached.isLastBlockComplete());
+    ASSERT_EQ(4u, cached.getBlocks().size());
+    EXPECT_EQ(3, cached.getBlocks()[2].getBlockId());
+    /*
+     * a range inside the cached one, or beyond the end of the file.
+     */
+    EXPECT_TRUE(cache.get("/file", 2048, 1024 * 1024, 4096, 100, cached));
+    /*
+     * the file has been modified.
+     */
+    EXPECT_FALSE(cache.get("/file", 0, 4096, 8192, 200, cached));
+    EXPECT_FALSE(cache.get("/file", 0, 4096, 4096, 100, cached));
+    EXPECT_EQ(2, cache.getHits());
+    EXPECT_EQ(3, cache.getMisses());
+}
+
+TEST(TestBlockLocationCache, TestNotCovered) {
+    Config conf;
+    SessionConfig sconf(conf);
+    BlockLocationCache cache(sconf);
+    LocatedBlocksImpl lbs, cached;
+    BuildBlocks(lbs, 4, 1024);
+    cache.put("/file", 1024, 1024, 4096, 100, lbs);
+    EXPECT_FALSE(cache.get("/file", 0, 1024, 4096, 100, cached));
+    EXPECT_FALSE(cache.get("/file", 1024, 2048, 4096, 100, cached));
+    EXPECT_TRUE(cache.get("/file", 1024, 1024, 4096, 100, cached));
+}
+
+TEST(TestBlockLocationCache, TestNotCacheUnderConstruction) {
+    Config conf;
+    SessionConfig sconf(conf);
+    BlockLocationCache cache(sconf);
+    LocatedBlocksImpl lbs, cached;
+    BuildBlocks(lbs, 4, 1024);
+    lbs.setUnderConstruction(true);
+    cache.put("/file", 0, 4096, 4096, 100, lbs);
+    EXPECT_FALSE(cache.get("/file", 0, 4096, 4096, 100, cached));
+    BuildBlocks(lbs, 4, 1024);
+    cache.put("/file", 0, 4096, 1024, 100, lbs);
+    EXPECT_FALSE(cache.get("/file", 0, 4096, 1024, 100, cached));
+}
+
+TEST(TestBlockLocationCache, TestInvalidateAndExpire) {
+    Config conf;
+    conf.set("dfs.client.blocklocations.cache.expiryMsec", 100);
+    SessionConfig sconf(conf);
+    BlockLocationCache cache(sconf);
+    LocatedBlocksImpl lbs, cached;
+    BuildBlocks(lbs, 4, 1024);
+    cache.put("/file", 0, 4096, 4096, 100, lbs);
+    cache.invalidate("/file");
+    EXPECT_FALSE(cache.get("/file", 0, 4096, 4096, 100, cached));
+    cache.put("/file", 0, 4096, 4096, 100, lbs);
+    EXPECT_TRUE(cache.get("/file", 0, 4096, 4096, 100, cached));
+    sleep_for(milliseconds(200));
+    EXPECT_FALSE(cache.get("/file", 0, 4096, 4096, 100, cached));
+}
+
+TEST(TestBlockLocationCache, TestDisabled) {
+    Config conf;
+    conf.set("dfs.client.blocklocations.cache.capacity", 0);
+    SessionConfig sconf(conf);
+    BlockLocationCache cache(sconf);
+    LocatedBlocksImpl lbs, cached;
+    BuildBlocks(lbs, 4, 1024);
+    cache.put("/file", 0, 4096, 4096, 100, lbs);
+    EXPECT_FALSE(cache.get("/file", 0, 4096, 4096, 100, cached));
+    EXPECT_EQ(0, cache.getMisses());
+}
@@ -21,6 +21,7 @@
  */
 #include "gtest/gtest.h"
 
+#include "BigEndian.h"
 #include "HWCrc32c.h"
 #include "SWCrc32c.h"
 
@@ -133,3 +134,82 @@ TEST_F(TestChecksum, SWCrc32c) {
     EXPECT_EQ(result, cs.getValue());
 }
 
+static void CheckChunkedSums(Checksum & cs) {
+    const int bytesPerChecksum = 512;
+    std::vector<char> data(bytesPerChecksum * 7 + 100);
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 31 + 7);
+    }
+
+    /*
+     * lengths covering fewer chunks than one interleaved group, whole groups
+     * and a short last chunk
+     */
+    int lens[] = {1, 511, 512, 1024, 1536, 1537, 3584, 3684};
+
+    for (size_t l = 0; l < sizeof(lens) / sizeof(lens[0]); ++l) {
+        int len = lens[l];
+        int chunks = (len + bytesPerChecksum - 1) / bytesPerChecksum;
+        std::vector<char> sums(chunks * sizeof(uint32_t));
+        cs.calculateChunkedSums(&data[0], len, bytesPerChecksum, &sums[0]);
+        EXPECT_EQ(0u, cs.getValue());
+
+        for (int i = 0; i < chunks; ++i) {
+            int size = std::min(bytesPerChecksum, len - i * bytesPerChecksum);
+            cs.reset();
+            cs.update(&data[i * bytesPerChecksum], size);
+            EXPECT_EQ(cs.getValue(), static_cast<uint32_t>(
+                          ReadBigEndian32FromArray(&sums[i * sizeof(uint32_t)])));
+        }
+
+        EXPECT_EQ(-1, cs.verifyChunkedSums(&data[0], len, bytesPerChecksum, &sums[0]));
+        sums[(chunks - 1) * sizeof(uint32_t)] ^= 1;
+        EXPECT_EQ(chunks - 1, cs.verifyChunkedSums(&data[0], len, bytesPerChecksum, &sums[0]));
+    }
+}
+
+TEST_F(TestChecksum, ChunkedSums) {
+    SWCrc32c sw;
+    CheckChunkedSums(sw);
+    HWCrc32c hw;
+
+    if (hw.available()) {
+        CheckChunkedSums(hw);
+    }
+}
+
+/*
+ * The chunked sums of a whole 64KB packet match the sums of its chunks, and
+ * the hardware and software implementations agree.
+ */
+TEST_F(TestChecksum, ChunkedSumsPacket) {
+    const int bytesPerChecksum = 512;
+    const int packetSize = 64 * 1024;
+    const int chunks = packetSize / bytesPerChecksum;
+    std::vector<char> data(packetSize);
+    std::vector<char> sums(chunks * sizeof(uint32_t));
+    SWCrc32c sw;
+
+    for (size_t i = 0; i < data.size(); ++i) {
+        data[i] = static_cast<char>(i * 131 + (i >> 9));
+    }
+
+    sw.calculateChunkedSums(&data[0], packetSize, bytesPerChecksum, &sums[0]);
+
+    for (int i = 0; i < chunks; ++i) {
+        sw.reset();
+        sw.update(&data[i * bytesPerChecksum], bytesPerChecksum);
+        EXPECT_EQ(sw.getValue(), static_cast<uint32_t>(
+                      ReadBigEndian32FromArray(&sums[i * sizeof(uint32_t)])));
+    }
+
+    HWCrc32c hw;
+
+    if (hw.available()) {
+        std::vector<char> hwSums(sums.size());
+        hw.calculateChunkedSums(&data[0], packetSize, bytesPerChecksum, &hwSums[0]);
+        EXPECT_TRUE(sums == hwSums);
+        EXPECT_EQ(-1, hw.verifyChunkedSums(&data[0], packetSize, bytesPerChecksum, &sums[0]));
+    }
+}
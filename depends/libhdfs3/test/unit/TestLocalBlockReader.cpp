@@ -0,0 +1,157 @@
+/********************************************************************
+ * 2014 -
+ * open source under Apache License Version 2.0
+ ********************************************************************/
+/**
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#include "gtest/gtest.h"
+#include "client/LocalBlockReader.h"
+#include "BigEndian.h"
+#include "datatransfer.pb.h"
+#include "Exception.h"
+#include "SessionConfig.h"
+#include "SWCrc32c.h"
+#include "XmlConfig.h"
+
+#include <cstdio>
+#include <unistd.h>
+
+using namespace Hdfs;
+using namespace Hdfs::Internal;
+
+#define CHUNK_SIZE 512
+
+class TestLocalBlockReader: public ::testing::Test {
+public:
+    TestLocalBlockReader() : key(0, 1, "bp") {
+    }
+
+    virtual void SetUp() {
+        char dataTemplate[] = "/tmp/LocalBlockReaderDataXXXXXX";
+        char metaTemplate[] = "/tmp/LocalBlockReaderMetaXXXXXX";
+        int dataFd = mkstemp(dataTemplate);
+        int metaFd = mkstemp(metaTemplate);
+        ASSERT_TRUE(dataFd >= 0 && metaFd >= 0);
+        dataPath = dataTemplate;
+        metaPath = metaTemplate;
+        data.resize(CHUNK_SIZE * 10 + 100);
+
+        for (size_t i = 0; i < data.size(); ++i) {
+            data[i] = static_cast<char>(i * 31);
+        }
+
+        int chunks = (data.size() + CHUNK_SIZE - 1) / CHUNK_SIZE;
+        meta.resize(7 + chunks * sizeof(int32_t));
+        char * p = WriteBigEndian16ToArray(1, &meta[0]);
+        *p++ = ChecksumTypeProto::CHECKSUM_CRC32C;
+        p = WriteBigEndian32ToArray(CHUNK_SIZE, p);
+        SWCrc32c crc;
+        crc.calculateChunkedSums(&data[0], data.size(), CHUNK_SIZE, p);
+        ASSERT_EQ(static_cast<ssize_t>(data.size()), ::write(dataFd, &data[0], data.size()));
+        ASSERT_EQ(static_cast<ssize_t>(meta.size()), ::write(metaFd, &meta[0], meta.size()));
+        ::close(dataFd);
+        ::close(metaFd);
+        block.setNumBytes(data.size());
+    }
+
+    virtual void TearDown() {
+        ::unlink(dataPath.c_str());
+        ::unlink(metaPath.c_str());
+    }
+
+    shared_ptr<ReadShortCircuitInfo> createInfo(bool mapped) {
+        shared_ptr<ReadShortCircuitInfo> info(new ReadShortCircuitInfo(key, false));
+        shared_ptr<FileWrapper> dataFile, metaFile;
+
+        if (mapped) {
+            dataFile = shared_ptr<FileWrapper>(new MappedFileWrapper);
+            metaFile = shared_ptr<FileWrapper>(new MappedFileWrapper);
+        } else {
+            dataFile = shared_ptr<FileWrapper>(new CFileWrapper);
+            metaFile = shared_ptr<FileWrapper>(new CFileWrapper);
+        }
+
+        EXPECT_TRUE(dataFile->open(dataPath));
+        EXPECT_TRUE(metaFile->open(metaPath));
+        info->setDataFile(dataFile);
+        info->setMetaFile(metaFile);
+        return info;
+    }
+
+    void readAll(LocalBlockReader & reader, int64_t offset, int32_t size) {
+        const char * p;
+        int32_t done;
+        std::string result;
+
+        while ((done = reader.readZeroCopy(&p, size)) > 0) {
+            result.append(p, done);
+        }
+
+        ASSERT_EQ(data.size() - offset, result.size());
+        EXPECT_EQ(0, memcmp(&data[offset], result.data(), result.size()));
+    }
+
+protected:
+    ExtendedBlock block;
+    ReadShortCircuitInfoKey key;
+    std::string dataPath;
+    std::string metaPath;
+    std::vector<char> buffer;
+    std::vector<char> data;
+    std::vector<char> meta;
+};
+
+TEST_F(TestLocalBlockReader, ReadZeroCopyVerify) {
+    Config conf;
+    conf.set("input.localread.default.buffersize", 1000);
+    SessionConfig sconf(conf);
+
+    for (int mapped = 0; mapped < 2; ++mapped) {
+        LocalBlockReader reader(createInfo(mapped), block, 0, true, sconf, buffer);
+        readAll(reader, 0, 700);
+        LocalBlockReader skipped(createInfo(mapped), block, 1500, true, sconf, buffer);
+        readAll(skipped, 1500, 300);
+    }
+}
+
+TEST_F(TestLocalBlockReader, ReadZeroCopyWithoutVerify) {
+    Config conf;
+    SessionConfig sconf(conf);
+    LocalBlockReader reader(createInfo(true), block, 100, false, sconf, buffer);
+    const char * p = NULL;
+    ASSERT_EQ(CHUNK_SIZE, reader.readZeroCopy(&p, CHUNK_SIZE));
+    EXPECT_EQ(0, memcmp(&data[100], p, CHUNK_SIZE));
+    /*
+     * data is returned from the mapped region, not the reader buffer.
+     */
+    EXPECT_TRUE(buffer.empty());
+    readAll(reader, 100 + CHUNK_SIZE, 4096);
+}
+
+TEST_F(TestLocalBlockReader, ReadZeroCopyChecksumMismatch) {
+    Config conf;
+    SessionConfig sconf(conf);
+    FILE * fp = fopen(dataPath.c_str(), "r+");
+    ASSERT_TRUE(fp != NULL);
+    fseek(fp, CHUNK_SIZE * 2, SEEK_SET);
+    fputc(~data[CHUNK_SIZE * 2], fp);
+    fclose(fp);
+    LocalBlockReader reader(createInfo(true), block, 0, true, sconf, buffer);
+    const char * p = NULL;
+    EXPECT_THROW(reader.readZeroCopy(&p, 100), HdfsIOException);
+}
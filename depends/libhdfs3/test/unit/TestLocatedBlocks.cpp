@@ -85,3 +85,29 @@ TEST(TestLocatedBlocks, TestFindBlock){
     delete blk3;
     delete lbs;
 }
+
+TEST(TestLocatedBlocks, TestIsCachedOn){
+    LocatedBlock lb(0);
+    std::vector<DatanodeInfo> & nodes = lb.mutableLocations();
+    nodes.resize(3);
+
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i].setIpAddr("127.0.0.1");
+        nodes[i].setDatanodeId(std::string("dn") + static_cast<char>('0' + i));
+    }
+
+    // no cached information reported
+    EXPECT_FALSE(lb.isCachedOn(nodes[1]));
+
+    std::vector<bool> & cached = lb.mutableCachedLocations();
+    cached.resize(3);
+    cached[1] = true;
+    EXPECT_FALSE(lb.isCachedOn(nodes[0]));
+    EXPECT_TRUE(lb.isCachedOn(nodes[1]));
+    EXPECT_FALSE(lb.isCachedOn(nodes[2]));
+
+    DatanodeInfo other;
+    other.setIpAddr("127.0.0.2");
+    other.setDatanodeId("dn1");
+    EXPECT_FALSE(lb.isCachedOn(other));
+}
@@ -20,6 +20,7 @@
  * limitations under the License.
  */
 #include "gtest/gtest.h"
+#include "Exception.h"
 #include "SessionConfig.h"
 #include "XmlConfig.h"
 
@@ -31,3 +32,14 @@ TEST(TestSessionConfig, TestSelect) {
     SessionConfig session(conf);
     ASSERT_STREQ("hdfs://localhost:8020", session.getDefaultUri().c_str());
 }
+
+TEST(TestSessionConfig, TestHedgedReadThreshold) {
+    Config conf;
+    SessionConfig disabled(conf);
+    ASSERT_EQ(0, disabled.getHedgedReadThreshold());
+    conf.set("dfs.client.hedged.read.threshold.millis", 500);
+    SessionConfig enabled(conf);
+    ASSERT_EQ(500, enabled.getHedgedReadThreshold());
+    conf.set("dfs.client.hedged.read.threshold.millis", -1);
+    ASSERT_THROW(SessionConfig invalid(conf), HdfsConfigInvalid);
+}
@@ -27,6 +27,7 @@
 #include "MockFileSystemInter.h"
 #include "TestDatanodeStub.h"
 #include "MockDatanode.h"
+#include "MockBlockReader.h"
 #include "server/ExtendedBlock.h"
 #include "XmlConfig.h"
 #include <string>
@@ -67,6 +68,7 @@ public:
 class MockDatanodeStub: public TestDatanodeStub {
 public:
     MOCK_METHOD0(getDatanode, shared_ptr<MockDatanode>());
+    MOCK_METHOD0(getBlockReader, shared_ptr<BlockReader>());
 
 };
 
@@ -145,7 +147,7 @@ TEST(InputStreamTest, UpdateBlockInfos_LastComplete) {
     ins.maxGetBlockInfoRetry = 1;
     ins.lastBlockBeingWrittenLength = 1;
     ins.lbs = shared_ptr < MockLocatedBlocks > (lbs);
-    EXPECT_CALL(*fs, getBlockLocations(_, _, _, _)).WillOnce(Return());
+    EXPECT_CALL(*fs, getCachedBlockLocations(_, _, _, _, _, _)).WillOnce(Return());
     EXPECT_CALL(*lbs, isLastBlockComplete()).WillOnce(Return(true));
     EXPECT_NO_THROW(ins.updateBlockInfos());
     EXPECT_EQ(ins.lastBlockBeingWrittenLength, 0);
@@ -167,7 +169,7 @@ TEST(InputStreamTest, UpdateBlockInfos_NotLastComplete) {
     DatanodeInfo df;
     dfv.push_back(df);
     block->setLocations(dfv);
-    EXPECT_CALL(*fs, getBlockLocations(_, _, _, _)).WillOnce(Return());
+    EXPECT_CALL(*fs, getCachedBlockLocations(_, _, _, _, _, _)).WillOnce(Return());
     EXPECT_CALL(*lbs, isLastBlockComplete()).WillOnce(Return(false));
     EXPECT_CALL(*lbs, getLastBlock()).WillOnce(Return(block));
     EXPECT_CALL(stub, getDatanode()).Times(1).WillOnce(Return(datanode));
@@ -185,7 +187,7 @@ TEST(InputStreamTest, UpdateBlockInfos_TrowAndTry) {
     ins.lastBlockBeingWrittenLength = 1;
     ins.lbs = shared_ptr < MockLocatedBlocks > (lbs);
     Hdfs::HdfsRpcException e("test", "test", 2, "test");
-    EXPECT_CALL(*fs, getBlockLocations(_, _, _, _)).Times(2).WillOnce(Throw(e)).WillOnce(
+    EXPECT_CALL(*fs, getCachedBlockLocations(_, _, _, _, _, _)).Times(2).WillOnce(Throw(e)).WillOnce(
         Throw(e));
     EXPECT_THROW(ins.updateBlockInfos(), Hdfs::HdfsRpcException);
 }
@@ -216,3 +218,91 @@ TEST(InputStreamTest, SetupBlockReader_Failed) {
     ins.failedNodes = dfv;
     EXPECT_THROW(ins.setupBlockReader(false), Hdfs::HdfsIOException);
 }
+
+/*
+ * Prepare ins to read a block with two replicas from the first one,
+ * with hedged reads after 10 ms.
+ */
+static void SetupHedgedRead(InputStreamImpl & ins, MockDatanodeStub & stub,
+                            shared_ptr<BlockReader> reader) {
+    Hdfs::Config conf;
+    LocatedBlock * lb = new LocatedBlock();
+    std::vector<DatanodeInfo> dfv;
+    DatanodeInfo df1;
+    DatanodeInfo df2;
+    df1.setDatanodeId("slow");
+    df2.setDatanodeId("fast");
+    dfv.push_back(df1);
+    dfv.push_back(df2);
+    lb->locs = dfv;
+    lb->setOffset(0);
+    lb->setNumBytes(1024);
+    ins.conf = shared_ptr<SessionConfig>(new SessionConfig(conf));
+    ins.curBlock = shared_ptr<LocatedBlock>(lb);
+    ins.curNode = df1;
+    ins.cursor = 0;
+    ins.hedgedReadThreshold = 10;
+    ins.blockReader = reader;
+    ins.stub = &stub;
+}
+
+TEST(InputStreamTest, ReadWithHedging_SlowDatanode) {
+    InputStreamImpl ins;
+    MockDatanodeStub stub;
+    shared_ptr<MockBlockReader> slow(new MockBlockReader());
+    shared_ptr<MockBlockReader> fast(new MockBlockReader());
+    const char data[] = "data from the other replica";
+    char buf[sizeof(data)] = {0};
+    SetupHedgedRead(ins, stub, slow);
+    EXPECT_CALL(*slow, poll(_)).WillRepeatedly(Return(false));
+    EXPECT_CALL(*slow, read(_, _)).Times(0);
+    EXPECT_CALL(stub, getBlockReader()).Times(1).WillOnce(Return(fast));
+    EXPECT_CALL(*fast, poll(_)).WillRepeatedly(Return(true));
+    EXPECT_CALL(*fast, read(_, sizeof(buf))).Times(1).WillOnce(
+        DoAll(SetArrayArgument<0>(data, data + sizeof(data)), Return(sizeof(data))));
+    EXPECT_EQ(sizeof(data), ins.readWithHedging(buf, sizeof(buf)));
+    EXPECT_STREQ(data, buf);
+    EXPECT_EQ("fast", ins.curNode.getDatanodeId());
+    EXPECT_EQ(fast, ins.blockReader);
+    EXPECT_EQ(1, slow.use_count());
+    EXPECT_EQ(1, ins.getHedgedReadOps());
+    EXPECT_EQ(1, ins.getHedgedReadWins());
+}
+
+TEST(InputStreamTest, ReadWithHedging_PrimaryRespondsFirst) {
+    InputStreamImpl ins;
+    MockDatanodeStub stub;
+    shared_ptr<MockBlockReader> primary(new MockBlockReader());
+    shared_ptr<MockBlockReader> hedge(new MockBlockReader());
+    const char data[] = "data from the first replica";
+    char buf[sizeof(data)] = {0};
+    SetupHedgedRead(ins, stub, primary);
+    EXPECT_CALL(*primary, poll(_)).WillOnce(Return(false)).WillOnce(Return(false)).WillRepeatedly(
+        Return(true));
+    EXPECT_CALL(*primary, read(_, sizeof(buf))).Times(1).WillOnce(
+        DoAll(SetArrayArgument<0>(data, data + sizeof(data)), Return(sizeof(data))));
+    EXPECT_CALL(stub, getBlockReader()).Times(1).WillOnce(Return(hedge));
+    EXPECT_CALL(*hedge, poll(_)).WillRepeatedly(Return(false));
+    EXPECT_CALL(*hedge, read(_, _)).Times(0);
+    EXPECT_EQ(sizeof(data), ins.readWithHedging(buf, sizeof(buf)));
+    EXPECT_STREQ(data, buf);
+    EXPECT_EQ("slow", ins.curNode.getDatanodeId());
+    EXPECT_EQ(primary, ins.blockReader);
+    EXPECT_EQ(1, hedge.use_count());
+    EXPECT_EQ(1, ins.getHedgedReadOps());
+    EXPECT_EQ(0, ins.getHedgedReadWins());
+}
+
+TEST(InputStreamTest, ReadWithHedging_FastDatanode) {
+    InputStreamImpl ins;
+    MockDatanodeStub stub;
+    shared_ptr<MockBlockReader> reader(new MockBlockReader());
+    char buf[16];
+    SetupHedgedRead(ins, stub, reader);
+    EXPECT_CALL(*reader, poll(10)).Times(1).WillOnce(Return(true));
+    EXPECT_CALL(*reader, read(_, sizeof(buf))).Times(1).WillOnce(Return(sizeof(buf)));
+    EXPECT_CALL(stub, getBlockReader()).Times(0);
+    EXPECT_EQ(sizeof(buf), ins.readWithHedging(buf, sizeof(buf)));
+    EXPECT_EQ(reader, ins.blockReader);
+    EXPECT_EQ(0, ins.getHedgedReadOps());
+}
@@ -360,6 +360,91 @@ TEST_F(TestOutputStream, append_Success) {
     EXPECT_NO_THROW(ous.close());
 }
 
+TEST_F(TestOutputStream, appendWithStreamer_Success) {
+    OutputStreamImpl ous;
+    shared_ptr<MockPipeline> pipelineStub(new MockPipeline());
+    MockPipelineStub stub;
+    ous.stub = &stub;
+    MockFileSystemInter * fs = new MockFileSystemInter;
+    FileStatus fileinfo;
+    fileinfo.setBlocksize(2048);
+    fileinfo.setLength(1024);
+    Config conf;
+    conf.set("output.streamer.queue.size", 1);
+    const SessionConfig sessionConf(conf);
+    shared_ptr<LocatedBlock> lastBlock(new LocatedBlock);
+    lastBlock->setNumBytes(0);
+    std::pair<shared_ptr<LocatedBlock>, shared_ptr<FileStatus> > lastBlockWithStatus;
+    lastBlockWithStatus.first = lastBlock;
+    lastBlockWithStatus.second = shared_ptr<FileStatus>(new FileStatus(fileinfo));
+    EXPECT_CALL(*fs, getStandardPath(_)).Times(1).WillOnce(Return("/testopen"));
+    EXPECT_CALL(*fs, getConf()).Times(1).WillOnce(ReturnRef(sessionConf));
+    EXPECT_CALL(*fs, append(_)).Times(1).WillOnce(Return(lastBlockWithStatus));
+    EXPECT_CALL(*fs, getFileStatus(_)).Times(1).WillOnce(Return(fileinfo));
+    EXPECT_CALL(GetMockLeaseRenewer(), StartRenew(_)).Times(1);
+    EXPECT_CALL(GetMockLeaseRenewer(), StopRenew(_)).Times(1);
+    EXPECT_NO_THROW(ous.open(shared_ptr<FileSystemInter>(fs), "testopen", Create | Append, 0644, false, 3, 2048));
+    char buffer[4096 + 523];
+    Hdfs::FillBuffer(buffer, sizeof(buffer), 0);
+    /*
+     * the pipeline is driven by the streamer thread, set all expectations before appending.
+     */
+    EXPECT_CALL(stub, getPipeline()).Times(3).WillRepeatedly(Return(pipelineStub));
+    EXPECT_CALL(*pipelineStub, send(_)).Times(4);
+    EXPECT_CALL(*pipelineStub, flush()).Times(1);
+    EXPECT_CALL(*pipelineStub, close(_)).Times(3).WillRepeatedly(Return(lastBlock));
+    EXPECT_CALL(*fs, fsync(_)).Times(3);
+    EXPECT_CALL(*fs, complete(_, _)).Times(1).WillOnce(Return(true));
+    EXPECT_NO_THROW(ous.append(buffer, sizeof(buffer)));
+    EXPECT_NO_THROW(ous.flush());
+    EXPECT_NO_THROW(ous.close());
+}
+
+TEST_F(TestOutputStream, appendWithStreamer_Fail) {
+    OutputStreamImpl ous;
+    shared_ptr<MockPipeline> pipelineStub(new MockPipeline());
+    MockPipelineStub stub;
+    ous.stub = &stub;
+    MockFileSystemInter * fs = new MockFileSystemInter;
+    FileStatus fileinfo;
+    fileinfo.setBlocksize(2048);
+    fileinfo.setLength(1024);
+    Config conf;
+    conf.set("output.streamer.queue.size", 1);
+    const SessionConfig sessionConf(conf);
+    shared_ptr<LocatedBlock> lastBlock(new LocatedBlock);
+    HdfsIOException e("test", "test", 3, "test");
+    lastBlock->setNumBytes(0);
+    std::pair<shared_ptr<LocatedBlock>, shared_ptr<FileStatus> > lastBlockWithStatus;
+    lastBlockWithStatus.first = lastBlock;
+    lastBlockWithStatus.second = shared_ptr<FileStatus>(new FileStatus(fileinfo));
+    EXPECT_CALL(*fs, getStandardPath(_)).Times(1).WillOnce(Return("/testopen"));
+    EXPECT_CALL(*fs, getConf()).Times(1).WillOnce(ReturnRef(sessionConf));
+    EXPECT_CALL(*fs, append(_)).Times(1).WillOnce(Return(lastBlockWithStatus));
+    EXPECT_CALL(*fs, getFileStatus(_)).Times(1).WillOnce(Return(fileinfo));
+    EXPECT_CALL(GetMockLeaseRenewer(), StartRenew(_)).Times(1);
+    EXPECT_CALL(GetMockLeaseRenewer(), StopRenew(_)).Times(1);
+    EXPECT_NO_THROW(ous.open(shared_ptr<FileSystemInter>(fs), "testopen", Create | Append, 0644, false, 3, 2048));
+    char buffer[4096 + 523];
+    Hdfs::FillBuffer(buffer, sizeof(buffer), 0);
+    EXPECT_CALL(stub, getPipeline()).Times(1).WillOnce(Return(pipelineStub));
+    EXPECT_CALL(*pipelineStub, send(_)).Times(1).WillOnce(Throw(e));
+    /*
+     * the error is reported by append or flush, whichever comes after the streamer failed.
+     */
+    bool failed = false;
+
+    try {
+        ous.append(buffer, sizeof(buffer));
+        ous.flush();
+    } catch (const HdfsIOException & e) {
+        failed = true;
+    }
+
+    EXPECT_TRUE(failed);
+    EXPECT_THROW(ous.close(), HdfsIOException);
+}
+
 TEST_F(TestOutputStream, appendEncryption_Success) {
     OutputStreamImpl ous;
     shared_ptr<MockPipeline> pipelineStub(new MockPipeline());
@@ -20,6 +20,7 @@
 #include "univplan/common/expression.h"
 
 #include <algorithm>
+#include <limits>
 
 #include "dbcommon/common/tuple-batch.h"
 #include "dbcommon/common/vector/fixed-length-vector.h"
@@ -30,6 +31,7 @@
 #include "dbcommon/log/logger.h"
 #include "dbcommon/type/array.h"
 #include "dbcommon/type/type-util.h"
+#include "dbcommon/utils/time-util.h"
 
 namespace univplan {
 
@@ -386,12 +388,109 @@ dbcommon::Datum BoolExprState::calc(ExprContext *context) {
   }
 }
 
+double BoolExprState::ArgStat::rank() const {
+  if (rowsIn == 0) return std::numeric_limits<double>::max();
+  double decidedRate = 1 - passRate();
+  if (decidedRate <= 0) return std::numeric_limits<double>::max();
+  return costPerRow() / decidedRate;
+}
+
+std::vector<size_t> BoolExprState::computeArgOrder(
+    const std::vector<ArgStat> &stats) {
+  std::vector<size_t> order(stats.size());
+  for (size_t i = 0; i < order.size(); ++i) order[i] = i;
+  std::stable_sort(order.begin(), order.end(), [&](size_t lhs, size_t rhs) {
+    return stats[lhs].rank() < stats[rhs].rank();
+  });
+  return order;
+}
+
+void BoolExprState::beginBatch() {
+  if (argOrder_.size() != args.size()) {
+    argStats_.assign(args.size(), ArgStat());
+    argOrder_.resize(args.size());
+    for (size_t i = 0; i < argOrder_.size(); ++i) argOrder_[i] = i;
+  }
+
+  ++numOfBatches_;
+  if (numOfBatches_ == kWarmupBatches + 1 ||
+      (numOfBatches_ > kWarmupBatches + 1 &&
+       (numOfBatches_ - kWarmupBatches - 1) % kReorderInterval == 0)) {
+    std::vector<size_t> order = computeArgOrder(argStats_);
+    if (order != argOrder_) {
+      argOrder_.swap(order);
+      ++numOfReorders_;
+    }
+    // decay the history so that the order follows the change of data
+    for (ArgStat &stat : argStats_) {
+      stat.rowsIn /= 2;
+      stat.rowsOut /= 2;
+      stat.elapsedNs /= 2;
+    }
+  }
+}
+
+void BoolExprState::recordArgStat(size_t argIdx, uint64_t rowsIn,
+                                  uint64_t rowsOut, uint64_t startTime) {
+  ArgStat &stat = argStats_[argIdx];
+  stat.rowsIn += rowsIn;
+  stat.rowsOut += rowsOut;
+  stat.elapsedNs += dbcommon::TimeUtil::currentTimeNanoSec() - startTime;
+}
+
+uint64_t BoolExprState::updatePendingAnd(
+    dbcommon::Vector *ret, const dbcommon::SelectList *inputSel) {
+  dbcommon::FixedSizeTypeVectorRawData<bool> vec(ret);
+  dbcommon::SelectList::size_type counter = 0;
+  dbcommon::SelectList::value_type *__restrict__ pending = pendingSel_.begin();
+  auto isPending = [&](uint64_t plainIdx) {
+    return vec.values[plainIdx] || (vec.nulls && vec.nulls[plainIdx]);
+  };
+  if (inputSel) {
+    for (auto plainIdx : *inputSel)
+      if (isPending(plainIdx)) pending[counter++] = plainIdx;
+  } else {
+    for (uint64_t plainIdx = 0; plainIdx < vec.plainSize; ++plainIdx)
+      if (isPending(plainIdx)) pending[counter++] = plainIdx;
+  }
+  pendingSel_.resize(counter);
+  pendingSel_.setPlainSize(vec.plainSize);
+  return counter;
+}
+
+uint64_t BoolExprState::updatePendingOr(const dbcommon::SelectList *ret,
+                                        const dbcommon::SelectList *inputSel,
+                                        size_t plainSize) {
+  dbcommon::SelectList::size_type counter = 0;
+  dbcommon::SelectList::value_type *__restrict__ pending = pendingSel_.begin();
+  auto decided = ret->begin();
+  auto decidedEnd = ret->end();
+  auto updatePending = [&](uint64_t plainIdx) {
+    while (decided != decidedEnd && *decided < plainIdx) ++decided;
+    if (decided == decidedEnd || *decided != plainIdx)
+      pending[counter++] = plainIdx;
+  };
+  if (inputSel) {
+    for (auto plainIdx : *inputSel) updatePending(plainIdx);
+  } else {
+    for (uint64_t plainIdx = 0; plainIdx < plainSize; ++plainIdx)
+      updatePending(plainIdx);
+  }
+  pendingSel_.resize(counter);
+  pendingSel_.setPlainSize(plainSize);
+  return counter;
+}
+
 dbcommon::Datum BoolExprState::calcAnd(ExprContext *context) {
   assert(args.size() >= 2);
   backupSel_ = context->releaseSelected();
   dbcommon::SelectList *backupSel = context->getSelectList();
+  beginBatch();
 
-  dbcommon::Object *para0 = args[0]->calc(context);
+  uint64_t rowsIn =
+      backupSel ? backupSel->size() : context->getNumOfRowsPlain();
+  uint64_t startTime = dbcommon::TimeUtil::currentTimeNanoSec();
+  dbcommon::Object *para0 = args[argOrder_[0]]->calc(context);
   if (dynamic_cast<dbcommon::Scalar *>(para0))
     LOG_ERROR(ERRCODE_FEATURE_NOT_SUPPORTED, "Feature not supported");
 
@@ -408,12 +507,19 @@ dbcommon::Datum BoolExprState::calcAnd(ExprContext *context) {
 
   dbcommon::Vector *retVector =
       reinterpret_cast<dbcommon::Vector *>(retval.get());
+  uint64_t rowsOut = updatePendingAnd(retVector, backupSel);
+  recordArgStat(argOrder_[0], rowsIn, rowsOut, startTime);
 
   std::unique_ptr<dbcommon::Vector> tmpVectorBackup;
 
-  for (auto i = 1; i < args.size(); i++) {
-    auto &it = args[i];
-    dbcommon::Object *para = it->calc(context);
+  // The rows already FALSE stay FALSE whatever the rest arguments are, so that
+  // the rest arguments only evaluate on the pending rows.
+  for (auto i = 1; i < args.size() && !pendingSel_.empty(); i++) {
+    size_t argIdx = argOrder_[i];
+    rowsIn = rowsOut;
+    context->setSelected(&pendingSel_);
+    startTime = dbcommon::TimeUtil::currentTimeNanoSec();
+    dbcommon::Object *para = args[argIdx]->calc(context);
 
     auto lhsVector = retVector->cloneSelected(nullptr);
     dbcommon::Vector *rhsVector = reinterpret_cast<dbcommon::Vector *>(para);
@@ -454,6 +560,9 @@ dbcommon::Datum BoolExprState::calcAnd(ExprContext *context) {
       dbcommon::transformVector(ret.plainSize, nullptr, rhs.nulls,
                                 setNullFromRhs);
     }
+
+    rowsOut = updatePendingAnd(retVector, backupSel);
+    recordArgStat(argIdx, rowsIn, rowsOut, startTime);
   }
 
   context->setSelected(backupSel);
@@ -465,19 +574,30 @@ dbcommon::Datum BoolExprState::calcOr(ExprContext *context) {
   assert(args.size() >= 2);
   backupSel_ = context->releaseSelected();
   dbcommon::SelectList *backupSel = context->getSelectList();
+  beginBatch();
   if (retval == nullptr) retval.reset(new dbcommon::SelectList);
   retval->clear();
   dbcommon::SelectList *retsel =
       static_cast<dbcommon::SelectList *>(retval.get());
   retsel->setPlainSize(0);
+  size_t plainSize = context->getNumOfRowsPlain();
 
-  dbcommon::Datum d = args[0]->calc(context);
+  uint64_t rowsIn = backupSel ? backupSel->size() : plainSize;
+  uint64_t startTime = dbcommon::TimeUtil::currentTimeNanoSec();
+  dbcommon::Datum d = args[argOrder_[0]]->calc(context);
   dbcommon::SelectList *sel = convertSelectList(d, context);
   *retsel = *sel;
-
-  for (auto i = 1; i < args.size(); i++) {
-    auto &it = args[i];
-    dbcommon::Datum d = it->calc(context);
+  uint64_t rowsOut = updatePendingOr(retsel, backupSel, plainSize);
+  recordArgStat(argOrder_[0], rowsIn, rowsOut, startTime);
+
+  // The rows already TRUE stay TRUE whatever the rest arguments are, so that
+  // the rest arguments only evaluate on the pending rows.
+  for (auto i = 1; i < args.size() && !pendingSel_.empty(); i++) {
+    size_t argIdx = argOrder_[i];
+    rowsIn = rowsOut;
+    context->setSelected(&pendingSel_);
+    startTime = dbcommon::TimeUtil::currentTimeNanoSec();
+    dbcommon::Datum d = args[argIdx]->calc(context);
     dbcommon::SelectList *sel = convertSelectList(d, context);
 
     dbcommon::SelectList tmp = *retsel;
@@ -486,10 +606,12 @@ dbcommon::Datum BoolExprState::calcOr(ExprContext *context) {
     auto end = std::set_union(tmp.begin(), tmp.end(), sel->begin(), sel->end(),
                               retsel->begin());
     retsel->resize(end - retsel->begin());
-    retsel->setNulls(context->getNumOfRowsPlain(), nullptr, tmp.getNulls(),
-                     sel->getNulls());
+    retsel->setNulls(plainSize, nullptr, tmp.getNulls(), sel->getNulls());
+
+    rowsOut = updatePendingOr(retsel, backupSel, plainSize);
+    recordArgStat(argIdx, rowsIn, rowsOut, startTime);
   }
-  retsel->setNulls(context->getNumOfRowsPlain(), retsel, false);
+  retsel->setNulls(plainSize, retsel, false);
 
   context->setSelected(backupSel);
   return dbcommon::CreateDatum(retval.get());
@@ -256,6 +256,10 @@ class BooleanTestState : public ExprState {
   std::unique_ptr<dbcommon::SelectList> result;
 };
 
+// BoolExprState evaluates the arguments of AND/OR adaptively. Each argument
+// is only evaluated on the rows left undecided by the previous ones, and the
+// cost and selectivity of every argument are measured so that the arguments
+// are periodically reordered to minimize the cost per decided row.
 class BoolExprState : public ExprState {
  public:
   explicit BoolExprState(const univplan::UnivPlanBoolExpr *expr)
@@ -264,14 +268,79 @@ class BoolExprState : public ExprState {
 
   typedef std::unique_ptr<BoolExprState> uptr;
 
+  // Runtime statistics of one argument of AND/OR
+  struct ArgStat {
+    uint64_t rowsIn = 0;     // number of rows the argument evaluated on
+    uint64_t rowsOut = 0;    // number of rows still undecided after it
+    uint64_t elapsedNs = 0;  // time spent in the argument
+
+    // Estimated time spent per input row in nanoseconds
+    double costPerRow() const {
+      return rowsIn ? static_cast<double>(elapsedNs) / rowsIn : 0;
+    }
+
+    // Fraction of the input rows that the argument leaves undecided, i.e.
+    // the selectivity of a conjunct in AND
+    double passRate() const {
+      return rowsIn ? static_cast<double>(rowsOut) / rowsIn : 1;
+    }
+
+    // Expected cost to decide one row, the smaller the earlier to evaluate.
+    // Arguments not measured yet rank last and keep their plan order.
+    double rank() const;
+  };
+
+  // Number of batches evaluated in plan order before the first reordering
+  static const uint64_t kWarmupBatches = 4;
+  // Number of batches between two reorderings
+  static const uint64_t kReorderInterval = 64;
+
   dbcommon::Datum calc(ExprContext *context) override;
   dbcommon::Datum calcAnd(ExprContext *context);
   dbcommon::Datum calcOr(ExprContext *context);
   dbcommon::Datum calcNot(ExprContext *context);
 
+  const std::vector<ArgStat> &getArgStats() const { return argStats_; }
+
+  const std::vector<size_t> &getArgOrder() const { return argOrder_; }
+
+  uint64_t getNumOfReorders() const { return numOfReorders_; }
+
+  // Sort the arguments by ascending rank, ties keep their original order
+  //
+  // @param stats The runtime statistics of each argument
+  // @return The argument indexes in evaluation order
+  static std::vector<size_t> computeArgOrder(
+      const std::vector<ArgStat> &stats);
+
  private:
+  // Prepare the argument order for the next batch
+  void beginBatch();
+
+  void recordArgStat(size_t argIdx, uint64_t rowsIn, uint64_t rowsOut,
+                     uint64_t startTime);
+
+  // Collect the rows where AND result is TRUE or NULL within the input
+  // selection into pendingSel_
+  // @return The number of undecided rows
+  uint64_t updatePendingAnd(dbcommon::Vector *ret,
+                            const dbcommon::SelectList *inputSel);
+
+  // Collect the rows where OR result is not TRUE within the input selection
+  // into pendingSel_
+  // @return The number of undecided rows
+  uint64_t updatePendingOr(const dbcommon::SelectList *ret,
+                           const dbcommon::SelectList *inputSel,
+                           size_t plainSize);
+
   const univplan::BOOLEXPRTYPE op;
   std::unique_ptr<dbcommon::Object> retval;
+
+  std::vector<ArgStat> argStats_;
+  std::vector<size_t> argOrder_;
+  uint64_t numOfBatches_ = 0;
+  uint64_t numOfReorders_ = 0;
+  dbcommon::SelectList pendingSel_;
 };
 
 ExprState::uptr InitExpr(const univplan::UnivPlanExprPoly *expr);
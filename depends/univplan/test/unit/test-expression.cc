@@ -0,0 +1,142 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <string>
+#include <vector>
+
+#include "gtest/gtest.h"
+
+#include "dbcommon/function/func-kind.cg.h"
+#include "dbcommon/testutil/tuple-batch-utils.h"
+#include "univplan/common/expression.h"
+#include "univplan/proto/universal-plan-expr.pb.h"
+
+namespace univplan {
+
+static BoolExprState::ArgStat makeArgStat(uint64_t rowsIn, uint64_t rowsOut,
+                                          uint64_t elapsedNs) {
+  BoolExprState::ArgStat stat;
+  stat.rowsIn = rowsIn;
+  stat.rowsOut = rowsOut;
+  stat.elapsedNs = elapsedNs;
+  return stat;
+}
+
+// Build "column attNo <op> value" on an int column of the scan batch
+static void makeVarOpConst(UnivPlanExprPoly *expr, dbcommon::FuncKind op,
+                           int32_t attNo, int32_t value) {
+  expr->set_type(UNIVPLAN_EXPR_OPEXPR);
+  UnivPlanOpExpr *opExpr = expr->mutable_opexpr();
+  opExpr->set_funcid(op);
+  opExpr->set_rettype(dbcommon::TypeKind::BOOLEANID);
+
+  UnivPlanExprPoly *var = opExpr->add_args();
+  var->set_type(UNIVPLAN_EXPR_VAR);
+  var->mutable_var()->set_varno(1);
+  var->mutable_var()->set_varattno(attNo);
+  var->mutable_var()->set_typeid_(dbcommon::TypeKind::INTID);
+
+  UnivPlanExprPoly *val = opExpr->add_args();
+  val->set_type(UNIVPLAN_EXPR_CONST);
+  val->mutable_val()->set_type(dbcommon::TypeKind::INTID);
+  val->mutable_val()->set_isnull(false);
+  val->mutable_val()->set_value(std::to_string(value));
+}
+
+// Evaluate the bool expression on enough batches to pass the warm-up, check
+// the result of every batch, and return the final argument order
+static std::vector<size_t> runBoolExpr(const UnivPlanBoolExpr &expr,
+                                       dbcommon::TupleBatch *batch,
+                                       const std::vector<uint64_t> &expected) {
+  BoolExprState state(&expr);
+  for (int i = 0; i < expr.args_size(); ++i)
+    state.addArg(InitExpr(&expr.args(i)));
+
+  ExprContext context;
+  context.scanBatch = batch;
+  for (uint64_t i = 0; i < BoolExprState::kWarmupBatches + 2; ++i) {
+    dbcommon::SelectList *sel = state.convertSelectList(state.calc(&context),
+                                                        &context);
+    EXPECT_EQ(expected, std::vector<uint64_t>(sel->begin(), sel->end()))
+        << "batch " << i;
+  }
+  EXPECT_EQ(1, state.getNumOfReorders());
+  return state.getArgOrder();
+}
+
+TEST(TestBoolExprState, TestComputeArgOrder) {
+  std::vector<BoolExprState::ArgStat> stats;
+  // expensive and not selective, e.g. LIKE
+  stats.push_back(makeArgStat(1024, 1000, 102400));
+  // cheap and selective, e.g. int4 equal
+  stats.push_back(makeArgStat(1024, 10, 1024));
+  // cheap but not selective
+  stats.push_back(makeArgStat(1024, 512, 1024));
+  std::vector<size_t> order = BoolExprState::computeArgOrder(stats);
+  EXPECT_EQ(std::vector<size_t>({1, 2, 0}), order);
+}
+
+TEST(TestBoolExprState, TestComputeArgOrderUnmeasured) {
+  std::vector<BoolExprState::ArgStat> stats;
+  stats.push_back(makeArgStat(0, 0, 0));
+  stats.push_back(makeArgStat(1024, 1024, 10));
+  stats.push_back(makeArgStat(1024, 0, 100000));
+  stats.push_back(makeArgStat(0, 0, 0));
+  std::vector<size_t> order = BoolExprState::computeArgOrder(stats);
+  EXPECT_EQ(std::vector<size_t>({2, 0, 1, 3}), order);
+}
+
+TEST(TestBoolExprState, TestCalcAndReorder) {
+  dbcommon::TupleDesc::uptr desc =
+      dbcommon::TupleBatchUtility::generateTupleDesc("ii");
+  dbcommon::TupleBatch::uptr batch =
+      dbcommon::TupleBatchUtility::generateTupleBatch(*desc, 0, 2000);
+
+  // c1 < 1990 keeps almost every row, c2 < 10 only keeps 10 of them
+  UnivPlanBoolExpr expr;
+  expr.set_type(BOOLEXPRTYPE_AND_EXPR);
+  makeVarOpConst(expr.add_args(), dbcommon::INT_LESS_THAN_INT, 1, 1990);
+  makeVarOpConst(expr.add_args(), dbcommon::INT_LESS_THAN_INT, 2, 10);
+
+  std::vector<uint64_t> expected;
+  for (uint64_t i = 0; i < 10; ++i) expected.push_back(i);
+  EXPECT_EQ(std::vector<size_t>({1, 0}),
+            runBoolExpr(expr, batch.get(), expected));
+}
+
+TEST(TestBoolExprState, TestCalcOrReorder) {
+  dbcommon::TupleDesc::uptr desc =
+      dbcommon::TupleBatchUtility::generateTupleDesc("ii");
+  dbcommon::TupleBatch::uptr batch =
+      dbcommon::TupleBatchUtility::generateTupleBatch(*desc, 0, 2000);
+
+  // c1 < 10 decides only 10 rows, c2 > 99 decides all but 100 of them
+  UnivPlanBoolExpr expr;
+  expr.set_type(BOOLEXPRTYPE_OR_EXPR);
+  makeVarOpConst(expr.add_args(), dbcommon::INT_LESS_THAN_INT, 1, 10);
+  makeVarOpConst(expr.add_args(), dbcommon::INT_GREATER_THAN_INT, 2, 99);
+
+  std::vector<uint64_t> expected;
+  for (uint64_t i = 0; i < 2000; ++i)
+    if (i < 10 || i >= 100) expected.push_back(i);
+  EXPECT_EQ(std::vector<size_t>({1, 0}),
+            runBoolExpr(expr, batch.get(), expected));
+}
+
+}  // namespace univplan
@@ -42,6 +42,7 @@
 #include "catalog/catquery.h"
 #include "utils/lsyscache.h"
 #include "utils/builtins.h"
+#include "utils/memutils.h"
 #include "catalog/pg_statistic.h"
 #include "cdb/cdbparquetfooterbuffer.h"
 #include "cdb/cdbparquetfooterserializer.h"
@@ -236,6 +237,23 @@ void parquet_endscan(ParquetScanDesc scan) {
 				pfree(reader->pageBuffer);
 			}
 
+			if (reader->dictionaryBuffer != NULL)
+			{
+				pfree(reader->dictionaryBuffer);
+			}
+
+			if (reader->dictionary != NULL)
+			{
+				pfree(reader->dictionary);
+			}
+
+			if (reader->pageValues != NULL)
+			{
+				pfree(reader->pageValues);
+				pfree(reader->pageNulls);
+				pfree(reader->pageInts);
+			}
+
 			if (reader->geoval != NULL)
 			{
 				pfree(reader->geoval);
@@ -247,6 +265,28 @@ void parquet_endscan(ParquetScanDesc scan) {
 		pfree(rowGroupReader.columnReaders);
 	}
 
+	/* Free the batch decoded by ParquetRowGroupReader_ScanNextTuple */
+	if (rowGroupReader.batchValues != NULL)
+	{
+		for (int i = 0; i < scan->pqs_tupDesc->natts; ++i)
+		{
+			if (rowGroupReader.batchValues[i] != NULL)
+			{
+				pfree(rowGroupReader.batchValues[i]);
+				pfree(rowGroupReader.batchNulls[i]);
+			}
+		}
+		pfree(rowGroupReader.batchValues);
+		pfree(rowGroupReader.batchNulls);
+	}
+	if (rowGroupReader.batchContext != NULL)
+		MemoryContextDelete(rowGroupReader.batchContext);
+	if (rowGroupReader.batchPass != NULL)
+	{
+		pfree(rowGroupReader.batchPass);
+		pfree(rowGroupReader.batchHashes);
+	}
+
 	if(scan->hawqAttrToParquetColChunks != NULL){
 		pfree(scan->hawqAttrToParquetColChunks);
 	}
@@ -255,6 +295,13 @@ void parquet_endscan(ParquetScanDesc scan) {
 		pfree(scan->aoEntry);
 	}
 
+	if(scan->rowGroupFilter != NULL){
+		if (scan->rowGroupFilter->keys != NULL)
+			pfree(scan->rowGroupFilter->keys);
+		pfree(scan->rowGroupFilter);
+		scan->rowGroupFilter = NULL;
+	}
+
 	ParquetStorageRead_FinishSession(&(scan->storageRead));
 
 	MemoryContextSwitchTo(oldContext);
@@ -350,7 +397,8 @@ bool getNextRowGroup(ParquetScanDesc scan)
 												scan->proj,
 												scan->pqs_tupDesc,
 												scan->hawqAttrToParquetColChunks,
-												scan->toCloseFile)) {
+												scan->toCloseFile,
+												scan->rowGroupFilter)) {
 		ParquetRowGroupReader_GetContents(&scan->rowGroupReader);
 	}
 	else {
@@ -297,6 +297,21 @@ typedef struct hostname_volume_stat_context {
 	HostnameVolumeInfo *hostnameVolInfos;
 } hostname_volume_stat_context;
 
+/*
+ * structure for the block locations of a segment
+ * file fetched ahead of the per relation scan.
+ */
+typedef struct PrefetchedLocationKey {
+	RelFileNode rnode;
+	int segno;
+} PrefetchedLocationKey;
+
+typedef struct PrefetchedLocationEntry {
+	PrefetchedLocationKey key;
+	BlockLocation *locations;
+	int block_num;
+} PrefetchedLocationEntry;
+
 /*
  * structure for tracking the whole procedure
  * of computing the split to segment mapping
@@ -309,6 +324,7 @@ typedef struct split_to_segment_mapping_context {
 	collect_hdfs_split_location_context chsl_context;
 	hostname_volume_stat_context host_context;
 	HTAB *hostname_map;
+	HTAB *prefetched_locations; /* PrefetchedLocationEntry, NULL if nothing is prefetched */
 	bool keep_hash;
 	int prefer_segment_num;
 	int64 split_size;
@@ -331,6 +347,9 @@ typedef struct split_to_segment_mapping_context {
 	int64 total_metadata_logic_len;
 
 	int metadata_cache_time_us;
+	int metadata_cache_hit_files; /* files whose block locations are served by metadata cache */
+	int hdfs_fetch_files; /* files whose block locations are fetched from HDFS namenode */
+	int hdfs_prefetch_files; /* fetch files served by prefetch_hdfs_data_block_locations */
 	int alloc_resource_time_us;
 	int cal_datalocality_time_us;
 } split_to_segment_mapping_context;
@@ -396,7 +415,21 @@ static void ExternalGetHdfsFileDataLocation(Relation relation,
 
 Oid LookupCustomProtocolBlockLocationFunc(char *protoname);
 
-static BlockLocation *fetch_hdfs_data_block_location(char *filepath, int64 len,
+static bool is_result_relation(split_to_segment_mapping_context *context,
+		Oid rel_oid);
+
+static bool is_relation_in_scan_nodes(split_to_segment_mapping_context *context,
+		Oid rel_oid);
+
+static void prefetch_hdfs_data_block_locations(
+		split_to_segment_mapping_context *context);
+
+static BlockLocation *take_prefetched_block_location(
+		split_to_segment_mapping_context *context, RelFileNode rnode,
+		uint32_t segno, int *block_num);
+
+static BlockLocation *fetch_hdfs_data_block_location(
+		split_to_segment_mapping_context *context, char *filepath, int64 len,
 		int *block_num, RelFileNode rnode, uint32_t segno, double* hit_ratio);
 
 static void free_hdfs_data_block_location(BlockLocation *locations,
@@ -457,6 +490,8 @@ static int compare_file_continuity(const void *e1, const void *e2);
 
 static int compare_hostid(const void *e1, const void *e2);
 
+static int compare_vseg_index(const void *e1, const void *e2);
+
 static void assign_split_to_host(Host_Assignment_Result *result,
 		Detailed_File_Split *split);
 
@@ -579,6 +614,7 @@ static void init_datalocality_context(PlannedStmt *plannedstmt,
 		context->hostname_map = hash_create("Hostname Index Map Hash", 16, &ctl,
 		HASH_ELEM);
 	}
+	context->prefetched_locations = NULL;
 
 	context->keep_hash = false;
 	context->prefer_segment_num = -1;
@@ -591,6 +627,9 @@ static void init_datalocality_context(PlannedStmt *plannedstmt,
 	context->total_metadata_logic_len = 0;
 
     context->metadata_cache_time_us = 0;
+    context->metadata_cache_hit_files = 0;
+    context->hdfs_fetch_files = 0;
+    context->hdfs_prefetch_files = 0;
     context->alloc_resource_time_us = 0;
     context->cal_datalocality_time_us = 0;
 	return;
@@ -902,6 +941,8 @@ int64 get_block_locations_and_claculte_table_size(split_to_segment_mapping_conte
 	ActiveSnapshot = CopySnapshot(ActiveSnapshot);
 	ActiveSnapshot->curcid = GetCurrentCommandId();
 
+	prefetch_hdfs_data_block_locations(context);
+
 	foreach(lc, context->rtc_context.full_range_tables)
 	{
 		Oid rel_oid = lfirst_oid(lc);
@@ -918,29 +959,12 @@ int64 get_block_locations_and_claculte_table_size(split_to_segment_mapping_conte
 			rel_data->files = NIL;
 			rel_data->partition_parent_relid = 0;
 			rel_data->block_count = 0;
-			bool isResultRelation = true;
-			ListCell *nonResultlc;
-			foreach(nonResultlc, context->rtc_context.range_tables)
-			{
-				Oid nonResultRel_oid = lfirst_oid(nonResultlc);
-				if (rel_oid == nonResultRel_oid) {
-					isResultRelation = false;
-				}
-			}
+			bool isResultRelation = is_result_relation(context, rel_oid);
 
 			if (!isResultRelation) {
 				// skip the relation not in scan nodes
 				// for partition table scan optimization;
-				ListCell *rtc;
-				bool found = false;
-				foreach(rtc, context->srtc_context.range_tables) {
-					RangeTblEntry *rte = lfirst(rtc);
-					if (rel_oid == rte->relid) {
-						found = true;
-						break;
-					}
-				}
-				if (!found) {
+				if (!is_relation_in_scan_nodes(context, rel_oid)) {
 					relation_close(rel, AccessShareLock);
 					continue;
 				}
@@ -1001,8 +1025,11 @@ int64 get_block_locations_and_claculte_table_size(split_to_segment_mapping_conte
 	int eclaspeTime = allRelationFetchLeavetime - allRelationFetchBegintime;
 	double hitrate = (allblocks == 0) ? 0 : (double) hitblocks / allblocks;
 	if (debug_print_split_alloc_result) {
-		elog(LOG, "fetch blocks of %d files overall execution time: %d us with hit rate %f",
-				totalFileCount, eclaspeTime, hitrate);
+		elog(LOG, "fetch blocks of %d files overall execution time: %d us with hit rate %f, "
+				"%d files from metadata cache, %d files from HDFS (%d concurrently)",
+				totalFileCount, eclaspeTime, hitrate,
+				context->metadata_cache_hit_files, context->hdfs_fetch_files,
+				context->hdfs_prefetch_files);
 	}
 	context->total_file_count = totalFileCount;
 	context->total_size = total_size;
@@ -1014,6 +1041,221 @@ int64 get_block_locations_and_claculte_table_size(split_to_segment_mapping_conte
 	return total_size;
 }
 
+/*
+ * is_result_relation: whether the relation is only a result relation
+ * of the query, i.e. it is not read.
+ */
+static bool is_result_relation(split_to_segment_mapping_context *context,
+		Oid rel_oid) {
+	ListCell *lc;
+
+	foreach(lc, context->rtc_context.range_tables)
+	{
+		if (rel_oid == lfirst_oid(lc)) {
+			return false;
+		}
+	}
+	return true;
+}
+
+/*
+ * is_relation_in_scan_nodes: whether the relation is scanned by the plan,
+ * unscanned partitions are skipped.
+ */
+static bool is_relation_in_scan_nodes(split_to_segment_mapping_context *context,
+		Oid rel_oid) {
+	ListCell *lc;
+
+	foreach(lc, context->srtc_context.range_tables)
+	{
+		RangeTblEntry *rte = lfirst(lc);
+		if (rel_oid == rte->relid) {
+			return true;
+		}
+	}
+	return false;
+}
+
+/*
+ * prefetch_hdfs_data_block_locations: fetch the block locations of the
+ * segment files of all the AO and Parquet relations of the query which are
+ * not in metadata cache, with up to metadata_fetch_max_threads requests in
+ * flight. fetch_hdfs_data_block_location() takes them from
+ * context->prefetched_locations, so the planning time of a cold table is
+ * bounded by the slowest requests rather than by their sum.
+ */
+static void prefetch_hdfs_data_block_locations(
+		split_to_segment_mapping_context *context) {
+	int max_files = 64;
+	int file_num = 0;
+	PrefetchedLocationKey *keys;
+	char **paths;
+	int64 *lengths;
+	ListCell *lc;
+
+	if (metadata_fetch_max_threads <= 1 || debug_fake_datalocality
+			|| (metadata_cache_enable && metadata_cache_testfile
+					&& metadata_cache_testfile[0])) {
+		return;
+	}
+
+	keys = (PrefetchedLocationKey *) palloc(sizeof(PrefetchedLocationKey) * max_files);
+	paths = (char **) palloc(sizeof(char *) * max_files);
+	lengths = (int64 *) palloc(sizeof(int64) * max_files);
+
+	foreach(lc, context->rtc_context.full_range_tables)
+	{
+		Oid rel_oid = lfirst_oid(lc);
+		if (!is_result_relation(context, rel_oid)
+				&& !is_relation_in_scan_nodes(context, rel_oid)) {
+			continue;
+		}
+
+		Relation rel = relation_open(rel_oid, AccessShareLock);
+		if (!RelationIsAoRows(rel) && !RelationIsParquet(rel)) {
+			relation_close(rel, AccessShareLock);
+			continue;
+		}
+
+		AppendOnlyEntry *aoEntry = GetAppendOnlyEntry(rel_oid, SnapshotNow);
+		char *basepath = relpath(rel->rd_node);
+		Relation pg_seg_rel = heap_open(aoEntry->segrelid, AccessShareLock);
+		TupleDesc pg_seg_dsc = RelationGetDescr(pg_seg_rel);
+		SysScanDesc segscan = systable_beginscan(pg_seg_rel, InvalidOid, FALSE,
+				ActiveSnapshot, 0, NULL);
+		HeapTuple tuple;
+
+		while (HeapTupleIsValid(tuple = systable_getnext(segscan))) {
+			int segno;
+			int64 logic_len;
+
+			if (RelationIsAoRows(rel)) {
+				segno = DatumGetInt32(
+						fastgetattr(tuple, Anum_pg_aoseg_segno, pg_seg_dsc, NULL));
+				logic_len = (int64) DatumGetFloat8(
+						fastgetattr(tuple, Anum_pg_aoseg_eof, pg_seg_dsc, NULL));
+			} else {
+				segno = DatumGetInt32(
+						fastgetattr(tuple, Anum_pg_parquetseg_segno, pg_seg_dsc, NULL));
+				logic_len = (int64) DatumGetFloat8(
+						fastgetattr(tuple, Anum_pg_parquetseg_eof, pg_seg_dsc, NULL));
+			}
+
+			/* empty files are never fetched */
+			if (logic_len == 0) {
+				continue;
+			}
+			if (metadata_cache_enable) {
+				HdfsFileInfo *file_info = CreateHdfsFileInfo(rel->rd_node, segno);
+				bool cached = HdfsFileBlockLocationsCached(file_info, logic_len);
+				DestroyHdfsFileInfo(file_info);
+				if (cached) {
+					continue;
+				}
+			}
+
+			if (file_num >= max_files) {
+				max_files <<= 1;
+				keys = (PrefetchedLocationKey *) repalloc(keys,
+						sizeof(PrefetchedLocationKey) * max_files);
+				paths = (char **) repalloc(paths, sizeof(char *) * max_files);
+				lengths = (int64 *) repalloc(lengths, sizeof(int64) * max_files);
+			}
+			MemSet(&keys[file_num], 0, sizeof(PrefetchedLocationKey));
+			keys[file_num].rnode = rel->rd_node;
+			keys[file_num].segno = segno;
+			paths[file_num] = (char *) palloc0(strlen(basepath) + 9);
+			FormatAOSegmentFileName(basepath, segno, -1, 0, &segno, paths[file_num]);
+			lengths[file_num] = logic_len;
+			file_num++;
+		}
+
+		systable_endscan(segscan);
+		heap_close(pg_seg_rel, AccessShareLock);
+		pfree(basepath);
+		relation_close(rel, AccessShareLock);
+	}
+
+	/* a single file is fetched as usual */
+	if (file_num > 1) {
+		BlockLocation **locations = (BlockLocation **) palloc(
+				sizeof(BlockLocation *) * file_num);
+		int *block_nums = (int *) palloc(sizeof(int) * file_num);
+		HASHCTL ctl;
+
+		HdfsGetFileBlockLocationsParallel((const char **) paths, lengths,
+				file_num, metadata_fetch_max_threads, locations, block_nums);
+
+		MemSet(&ctl, 0, sizeof(ctl));
+		ctl.keysize = sizeof(PrefetchedLocationKey);
+		ctl.entrysize = sizeof(PrefetchedLocationEntry);
+		ctl.hash = tag_hash;
+		ctl.hcxt = context->datalocality_memorycontext;
+		context->prefetched_locations = hash_create("Prefetched Block Location Hash",
+				file_num, &ctl, HASH_ELEM | HASH_FUNCTION | HASH_CONTEXT);
+
+		for (int i = 0; i < file_num; i++) {
+			PrefetchedLocationEntry *entry;
+			bool found;
+
+			/* failed fetches are retried and reported by the serial path */
+			if (locations[i] == NULL) {
+				continue;
+			}
+			entry = (PrefetchedLocationEntry *) hash_search(
+					context->prefetched_locations, (void *) &keys[i], HASH_ENTER,
+					&found);
+			if (found) {
+				HdfsFreeFileBlockLocations(locations[i], block_nums[i]);
+				continue;
+			}
+			entry->locations = locations[i];
+			entry->block_num = block_nums[i];
+		}
+
+		pfree(locations);
+		pfree(block_nums);
+	}
+
+	for (int i = 0; i < file_num; i++) {
+		pfree(paths[i]);
+	}
+	pfree(keys);
+	pfree(paths);
+	pfree(lengths);
+}
+
+/*
+ * take_prefetched_block_location: return the prefetched block locations
+ * of a segment file, the caller owns them. NULL if it was not prefetched.
+ */
+static BlockLocation *take_prefetched_block_location(
+		split_to_segment_mapping_context *context, RelFileNode rnode,
+		uint32_t segno, int *block_num) {
+	PrefetchedLocationKey key;
+	PrefetchedLocationEntry *entry;
+	BlockLocation *locations;
+	bool found;
+
+	if (context->prefetched_locations == NULL) {
+		return NULL;
+	}
+
+	MemSet(&key, 0, sizeof(key));
+	key.rnode = rnode;
+	key.segno = segno;
+	entry = (PrefetchedLocationEntry *) hash_search(context->prefetched_locations,
+			(void *) &key, HASH_FIND, &found);
+	if (!found) {
+		return NULL;
+	}
+
+	locations = entry->locations;
+	*block_num = entry->block_num;
+	hash_search(context->prefetched_locations, (void *) &key, HASH_REMOVE, NULL);
+	return locations;
+}
+
 bool dataStoredInHdfs(Relation rel) {
 	if (RelationIsAoRows(rel) || RelationIsParquet(rel)) {
 		return true;
@@ -1075,7 +1317,8 @@ search_host_in_stat_context(split_to_segment_mapping_context *context,
  * collect all its data block location information.
  */
 static BlockLocation *
-fetch_hdfs_data_block_location(char *filepath, int64 len, int *block_num,
+fetch_hdfs_data_block_location(split_to_segment_mapping_context *context,
+		char *filepath, int64 len, int *block_num,
 		RelFileNode rnode, uint32_t segno, double* hit_ratio) {
 	// for fakse test, the len of file always be zero
 	if(len == 0  && !debug_fake_datalocality){
@@ -1083,6 +1326,7 @@ fetch_hdfs_data_block_location(char *filepath, int64 len, int *block_num,
 		return NULL;
 	}
 	BlockLocation *locations;
+	BlockLocation *hdfs_locations;
 	HdfsFileInfo *file_info;
 	//double hit_ratio;
 	uint64_t beginTime;
@@ -1095,13 +1339,33 @@ fetch_hdfs_data_block_location(char *filepath, int64 len, int *block_num,
 			if (locations) {
 				DumpHdfsFileBlockLocations(locations, *block_num);
 			}
+		} else if ((hdfs_locations = take_prefetched_block_location(context,
+				rnode, segno, block_num)) != NULL) {
+			/* fetched ahead because it was not cached, cache it as a miss does */
+			locations = CacheHdfsFileBlockLocations(file_info, len, hdfs_locations,
+					block_num);
+			*hit_ratio = 0.0;
+			context->hdfs_fetch_files++;
+			context->hdfs_prefetch_files++;
 		} else {
 			locations = GetHdfsFileBlockLocations(file_info, len, block_num,
 					hit_ratio);
+			if (*hit_ratio == 1.0) {
+				context->metadata_cache_hit_files++;
+			} else {
+				context->hdfs_fetch_files++;
+			}
 		}
 		DestroyHdfsFileInfo(file_info);
 	} else {
-		locations = HdfsGetFileBlockLocations(filepath, len, block_num);
+		locations = take_prefetched_block_location(context, rnode, segno,
+				block_num);
+		if (locations == NULL) {
+			locations = HdfsGetFileBlockLocations(filepath, len, block_num);
+		} else {
+			context->hdfs_prefetch_files++;
+		}
+		context->hdfs_fetch_files++;
 	}
 	if (debug_print_split_alloc_result) {
 		uint64 endTime = gettime_microsec();
@@ -1252,7 +1516,7 @@ static void AOGetSegFileDataLocation(Relation relation,
 			if (!context->keep_hash || !isRelationHash) {
 				FormatAOSegmentFileName(basepath, segno, -1, 0, &segno, segfile_path);
 				double hit_ratio=0.0;
-				locations = fetch_hdfs_data_block_location(segfile_path, logic_len,
+				locations = fetch_hdfs_data_block_location(context, segfile_path, logic_len,
 						&block_num, relation->rd_node, segno, &hit_ratio);
 				*allblocks += block_num;
 				*hitblocks += block_num * hit_ratio;
@@ -1326,7 +1590,7 @@ static void AOGetSegFileDataLocation(Relation relation,
 
 				FormatAOSegmentFileName(basepath, segno, -1, 0, &segno, segfile_path);
 				double hit_ratio = 0.0;
-				locations = fetch_hdfs_data_block_location(segfile_path, logic_len,
+				locations = fetch_hdfs_data_block_location(context, segfile_path, logic_len,
 						&block_num, relation->rd_node, segno, &hit_ratio);
 				*allblocks += block_num;
 				*hitblocks += block_num * hit_ratio;
@@ -1409,7 +1673,7 @@ static void AOGetSegFileDataLocation(Relation relation,
 			if (!context->keep_hash || !isRelationHash) {
 				FormatAOSegmentFileName(basepath, segno, -1, 0, &segno, segfile_path);
 				double hit_ratio = 0.0;
-				locations = fetch_hdfs_data_block_location(segfile_path, logic_len,
+				locations = fetch_hdfs_data_block_location(context, segfile_path, logic_len,
 						&block_num, relation->rd_node, segno, &hit_ratio);
 				*allblocks += block_num;
 				*hitblocks += block_num * hit_ratio;
@@ -1466,7 +1730,7 @@ static void AOGetSegFileDataLocation(Relation relation,
 
 				FormatAOSegmentFileName(basepath, segno, -1, 0, &segno, segfile_path);
 				double hit_ratio = 0.0;
-				locations = fetch_hdfs_data_block_location(segfile_path, logic_len,
+				locations = fetch_hdfs_data_block_location(context, segfile_path, logic_len,
 						&block_num, relation->rd_node, segno, &hit_ratio);
 				*allblocks += block_num;
 				*hitblocks += block_num * hit_ratio;
@@ -1587,7 +1851,7 @@ static void ParquetGetSegFileDataLocation(Relation relation,
 		if (!context->keep_hash || !isRelationHash) {
 			FormatAOSegmentFileName(basepath, segno, -1, 0, &segno, segfile_path);
 			double hit_ratio = 0.0;
-			locations = fetch_hdfs_data_block_location(segfile_path, logic_len,
+			locations = fetch_hdfs_data_block_location(context, segfile_path, logic_len,
 					&block_num, relation->rd_node, segno, &hit_ratio);
 			*allblocks += block_num;
 			*hitblocks += block_num * hit_ratio;
@@ -1645,7 +1909,7 @@ static void ParquetGetSegFileDataLocation(Relation relation,
 		} else {
 			FormatAOSegmentFileName(basepath, segno, -1, 0, &segno, segfile_path);
 			double hit_ratio = 0.0;
-			locations = fetch_hdfs_data_block_location(segfile_path, logic_len,
+			locations = fetch_hdfs_data_block_location(context, segfile_path, logic_len,
 					&block_num, relation->rd_node, segno, &hit_ratio);
 			*allblocks += block_num;
 			*hitblocks += block_num * hit_ratio;
@@ -1943,6 +2207,14 @@ static int select_random_host_algorithm(Relation_Assignment_Context *context,
 	bool isExceedVolume = false;
 	bool isExceedWholeSize =false;
 	bool isExceedPartitionTableSize =false;
+	/* the partition volumes don't move during the search, look them up once */
+	int64 *partitionvols_with_penalty = NULL;
+	if (partition_parent_oid > 0) {
+		PAIR p = getHASHTABLENode(context->partitionvols_with_penalty_map,
+				TYPCONVERT(void *, partition_parent_oid));
+		partitionvols_with_penalty = (int64 *) (p->Value);
+	}
+
 	//step1
 	int64 minvols = INT64_MAX;
 	int minindex = 0;
@@ -1963,13 +2235,9 @@ static int select_random_host_algorithm(Relation_Assignment_Context *context,
 			isExceedWholeSize = balance_on_whole_query_level
 					&& splitsize + context->totalvols_with_penalty[j]
 							> context->avg_size_of_whole_query;
-			int64** partitionvols_with_penalty=NULL;
 			if(partition_parent_oid > 0){
-				PAIR p = getHASHTABLENode(context->partitionvols_with_penalty_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				partitionvols_with_penalty = (int64 **) (&(p->Value));
 				isExceedPartitionTableSize = balance_on_partition_table_level && splitsize
-						+ (*partitionvols_with_penalty)[j]
+						+ partitionvols_with_penalty[j]
 						> context->avg_size_of_whole_partition_table;
 			}
 			else{
@@ -1980,7 +2248,7 @@ static int select_random_host_algorithm(Relation_Assignment_Context *context,
 			}
 			if ((!isExceedWholeSize || context->totalvols_with_penalty[j] == 0)
 					&& (!isExceedVolume || context->vols[j] == 0)
-					&& (!isExceedPartitionTableSize || (*partitionvols_with_penalty)[j] ==0)) {
+					&& (!isExceedPartitionTableSize || partitionvols_with_penalty[j] ==0)) {
 				{
 					*isLocality = true;
 					if (minvols > context->vols[j]) {
@@ -2017,20 +2285,16 @@ static int select_random_host_algorithm(Relation_Assignment_Context *context,
 		isExceedWholeSize = balance_on_whole_query_level
 				&& net_disk_ratio * splitsize + context->totalvols_with_penalty[j]
 						> context->avg_size_of_whole_query;
-		int64** partitionvols_with_penalty=NULL;
 		if(partition_parent_oid > 0){
-			PAIR p = getHASHTABLENode(context->partitionvols_with_penalty_map,
-					TYPCONVERT(void *, partition_parent_oid));
-			partitionvols_with_penalty = (int64 **) (&(p->Value));
 			isExceedPartitionTableSize = balance_on_partition_table_level &&
-					splitsize + (*partitionvols_with_penalty)[j]
+					splitsize + partitionvols_with_penalty[j]
 					> context->avg_size_of_whole_partition_table;
 		} else {
 			isExceedPartitionTableSize = false;
 		}
 		if ((!isExceedWholeSize || context->totalvols_with_penalty[j] == 0)
 				&& (!isExceedVolume || context->vols[j] == 0)
-				&& (!isExceedPartitionTableSize || (*partitionvols_with_penalty)[j] ==0)) {
+				&& (!isExceedPartitionTableSize || partitionvols_with_penalty[j] ==0)) {
 			isFound = true;
 			if (minvols > context->vols[j]) {
 				minvols = context->vols[j];
@@ -2063,13 +2327,10 @@ static int select_random_host_algorithm(Relation_Assignment_Context *context,
 					continue;
 				}
 				if (partition_parent_oid > 0) {
-					PAIR p = getHASHTABLENode(context->partitionvols_with_penalty_map,
-							TYPCONVERT(void *, partition_parent_oid));
-					int64** partitionvols_with_penalty = (int64 **) (&(p->Value));
 					if (balance_on_partition_table_level
-							&& splitsize + (*partitionvols_with_penalty)[j]
+							&& splitsize + partitionvols_with_penalty[j]
 									> context->avg_size_of_whole_partition_table
-							&& (*partitionvols_with_penalty)[j] != 0) {
+							&& partitionvols_with_penalty[j] != 0) {
 						continue;
 					}
 				}
@@ -2096,13 +2357,10 @@ static int select_random_host_algorithm(Relation_Assignment_Context *context,
 				continue;
 			}
 			if (partition_parent_oid > 0) {
-				PAIR p = getHASHTABLENode(context->partitionvols_with_penalty_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				int64** partitionvols_with_penalty = (int64 **) (&(p->Value));
 				if (balance_on_partition_table_level
-						&& net_disk_ratio * splitsize + (*partitionvols_with_penalty)[j]
+						&& net_disk_ratio * splitsize + partitionvols_with_penalty[j]
 								> context->avg_size_of_whole_partition_table
-						&& (*partitionvols_with_penalty)[j] != 0) {
+						&& partitionvols_with_penalty[j] != 0) {
 					continue;
 				}
 			}
@@ -2389,6 +2647,24 @@ static int compare_container_segment(const void *e1, const void *e2) {
 	return 0;
 }
 
+/*
+ * compare two virtual segment indexes.
+ */
+static int compare_vseg_index(const void *e1, const void *e2) {
+	int v1 = *(const int *) e1;
+	int v2 = *(const int *) e2;
+
+	if (v1 < v2) {
+		return -1;
+	}
+
+	if (v1 > v2) {
+		return 1;
+	}
+
+	return 0;
+}
+
 /*
  * compare two detailed file splits.
  */
@@ -2727,6 +3003,12 @@ static Relation_File** change_file_order_based_on_continuity(
 
 	Relation_File** file_vector = NULL;
 	int* isBlockContinue = (int *) palloc(sizeof(int) * host_num);
+	/*
+	 * vsegs whose isBlockContinue is non-zero, so that finding the longest
+	 * run and resetting it doesn't need to walk all the vsegs per block.
+	 */
+	int* touchedVSegs = (int *) palloc(sizeof(int) * host_num);
+	int touchedVSegNum = 0;
 	for (int i = 0; i < host_num; i++) {
 		isBlockContinue[i] = 0;
 	}
@@ -2747,9 +3029,6 @@ static Relation_File** change_file_order_based_on_continuity(
 		int file_total_block_count = 0;
 		int file_continue_block_count = 0;
 		ListCell* lc;
-		for (int i = 0; i < host_num; i++) {
-			isBlockContinue[i] = 0;
-		}
 		int continuityBeginIndex = 0;
 		file_total_block_count = rel_file->split_num;
 		for (int i = 0; i < rel_file->split_num; i++) {
@@ -2766,7 +3045,9 @@ static Relation_File** change_file_order_based_on_continuity(
 					foreach(lc, val)
 					{
 						int j = lfirst_int(lc);
-						isBlockContinue[j]++;
+						if (isBlockContinue[j]++ == 0) {
+							touchedVSegs[touchedVSegNum++] = j;
+						}
 						isLocalContinueBlockFound = true;
 						isBlocksBegin = false;
 					}
@@ -2794,17 +3075,17 @@ static Relation_File** change_file_order_based_on_continuity(
 			}
 			if (!isLocalContinueBlockFound || i == rel_file->split_num - 1) {
 				int maxBlockContinue = 0;
-				for (int k = 0; k < host_num; k++) {
+				for (int t = 0; t < touchedVSegNum; t++) {
+					int k = touchedVSegs[t];
 					if (isBlockContinue[k] > maxBlockContinue) {
 						maxBlockContinue = isBlockContinue[k];
 					}
+					isBlockContinue[k] = 0;
 				}
+				touchedVSegNum = 0;
 				if (maxBlockContinue >= 2) {
 					file_continue_block_count += maxBlockContinue;
 				}
-				for (int k = 0; k < host_num; k++) {
-					isBlockContinue[k] = 0;
-				}
 				isBlocksBegin = true;
 				if (maxBlockContinue == 0) {
 					continuityBeginIndex = i + 1;
@@ -2836,6 +3117,7 @@ static Relation_File** change_file_order_based_on_continuity(
 	}
 
 	pfree(isBlockContinue);
+	pfree(touchedVSegs);
 	return file_vector;
 }
 
@@ -3006,10 +3288,23 @@ static void allocate_random_relation(Relation_Data* rel_data,
 	Oid myrelid = rel_data->relid;
 	Oid partition_parent_oid = rel_data->partition_parent_relid;
 
+	/*
+	 * the partition volume arrays stay at the same place during the
+	 * allocation, look them up once instead of for each block.
+	 */
+	int64 *partitionParentAvgSize = NULL;
+	int64 *partitionvols_with_penalty = NULL;
+	int64 *partitionvols = NULL;
 	if(partition_parent_oid > 0){
 		PAIR pa = getHASHTABLENode(assignment_context->patition_parent_size_map,
 						TYPCONVERT(void *, partition_parent_oid));
-		int64* partitionParentAvgSize = (int64 *) (pa->Value);
+		partitionParentAvgSize = (int64 *) (pa->Value);
+		pa = getHASHTABLENode(assignment_context->partitionvols_with_penalty_map,
+						TYPCONVERT(void *, partition_parent_oid));
+		partitionvols_with_penalty = (int64 *) (pa->Value);
+		pa = getHASHTABLENode(assignment_context->partitionvols_map,
+						TYPCONVERT(void *, partition_parent_oid));
+		partitionvols = (int64 *) (pa->Value);
 		assignment_context->avg_size_of_whole_partition_table = *partitionParentAvgSize;
 		if(debug_print_split_alloc_result){
 			elog(LOG, "partition table  "INT64_FORMAT" of relation %u",
@@ -3036,8 +3331,26 @@ static void allocate_random_relation(Relation_Data* rel_data,
 	bool isExceedMaxSize = false;
 	bool isExceedPartitionTableSize = false;
 	bool isExceedWholeSize = false;
-	int* isBlockContinue = (int *) palloc(
+	int* isBlockContinue = (int *) palloc0(
+			sizeof(int) * assignment_context->virtual_segment_num);
+	/*
+	 * only the vsegs in touchedVSegs have a non-zero isBlockContinue, scan
+	 * and reset those instead of all the vsegs each time a run ends.
+	 */
+	int* touchedVSegs = (int *) palloc(
 			sizeof(int) * assignment_context->virtual_segment_num);
+	int touchedVSegNum = 0;
+	/*
+	 * splitSizePrefix[r] is the total length of the first r splits of the
+	 * current file, so the size of a run is a subtraction.
+	 */
+	int maxSplitNum = 0;
+	for (int fi = 0; fi < fileCount; fi++) {
+		if (file_vector[fi]->split_num > maxSplitNum) {
+			maxSplitNum = file_vector[fi]->split_num;
+		}
+	}
+	int64* splitSizePrefix = (int64 *) palloc(sizeof(int64) * (maxSplitNum + 1));
 
 
 	/*find the insert node for each block*/
@@ -3106,8 +3419,9 @@ static void allocate_random_relation(Relation_Data* rel_data,
 		bool isLocalContinueBlockFound = false;
 		ListCell *lc;
 		int beginIndex = 0;
-		for (i = 0; i < assignment_context->virtual_segment_num; i++) {
-			isBlockContinue[i] = 0;
+		splitSizePrefix[0] = 0;
+		for (i = 0; i < rel_file->split_num; i++) {
+			splitSizePrefix[i + 1] = splitSizePrefix[i] + rel_file->splits[i].length;
 		}
 		/* we assign split(block) to host base on continuity
 		 * the length of continue blocks of local host determines
@@ -3115,10 +3429,8 @@ static void allocate_random_relation(Relation_Data* rel_data,
 		 */
 		for (i = 0; i < rel_file->split_num; i++) {
 			int64 split_size = rel_file->splits[i].length;
-			int64 currentSequenceSize = 0;
-			for (int r = beginIndex; r <= i; r++) {
-				currentSequenceSize += rel_file->splits[r].length;
-			}
+			int64 currentSequenceSize = splitSizePrefix[i + 1]
+					- splitSizePrefix[beginIndex];
 			/* first block in one file doesn't need to consider continuity,
 			 * but the following blocks must consider it.
 			 */
@@ -3142,12 +3454,9 @@ static void allocate_random_relation(Relation_Data* rel_data,
 								&& currentSequenceSize
 										+ assignment_context->totalvols_with_penalty[j]
 										> assignment_context->avg_size_of_whole_query;
-						int64** partitionvols_with_penalty=NULL;
 						if(partition_parent_oid > 0){
-						PAIR p = getHASHTABLENode(assignment_context->partitionvols_with_penalty_map,TYPCONVERT(void *,partition_parent_oid));
-					  partitionvols_with_penalty = (int64 **)(&(p->Value));
 						isExceedPartitionTableSize = balance_on_partition_table_level && currentSequenceSize
-								+ (*partitionvols_with_penalty)[j]
+								+ partitionvols_with_penalty[j]
 							  > assignment_context->avg_size_of_whole_partition_table;
 						}else{
 							isExceedPartitionTableSize =false;
@@ -3156,8 +3465,10 @@ static void allocate_random_relation(Relation_Data* rel_data,
 								|| assignment_context->totalvols_with_penalty[j] == 0)
 								&& (!isExceedMaxSize
 										|| (i == beginIndex && assignment_context->vols[j] == 0))
-								&& (!isExceedPartitionTableSize || (*partitionvols_with_penalty)[j] ==0)) {
-							isBlockContinue[j]++;
+								&& (!isExceedPartitionTableSize || partitionvols_with_penalty[j] ==0)) {
+							if (isBlockContinue[j]++ == 0) {
+								touchedVSegs[touchedVSegNum++] = j;
+							}
 							isLocalContinueBlockFound = true;
 							isBlocksBegin = false;
 						}
@@ -3183,14 +3494,9 @@ static void allocate_random_relation(Relation_Data* rel_data,
 								&& currentSequenceSize
 										+ assignment_context->totalvols_with_penalty[j]
 										> assignment_context->avg_size_of_whole_query;
-						int64** partitionvols_with_penalty = NULL;
 						if (partition_parent_oid > 0) {
-							PAIR p = getHASHTABLENode(
-									assignment_context->partitionvols_with_penalty_map,
-									TYPCONVERT(void *, partition_parent_oid));
-							partitionvols_with_penalty = (int64 **) (&(p->Value));
 							isExceedPartitionTableSize = balance_on_partition_table_level && currentSequenceSize
-									+ (*partitionvols_with_penalty)[j]
+									+ partitionvols_with_penalty[j]
 									> assignment_context->avg_size_of_whole_partition_table;
 						} else {
 							isExceedPartitionTableSize = false;
@@ -3199,7 +3505,7 @@ static void allocate_random_relation(Relation_Data* rel_data,
 								|| assignment_context->totalvols_with_penalty[j] == 0)
 								&& (!isExceedMaxSize
 										|| (i == beginIndex && assignment_context->vols[j] == 0))
-								&& (!isExceedPartitionTableSize || (*partitionvols_with_penalty)[j] ==0)
+								&& (!isExceedPartitionTableSize || partitionvols_with_penalty[j] ==0)
 								&& isBlockContinue[j] == i - beginIndex) {
 							isBlockContinue[j]++;
 							isLocalContinueBlockFound = true;
@@ -3211,7 +3517,10 @@ static void allocate_random_relation(Relation_Data* rel_data,
 			if (!isLocalContinueBlockFound || i == rel_file->split_num - 1) {
 				int assignedVSeg = -1;
 				int maxBlockContinue = 0;
-				for (int k = 0; k < assignment_context->virtual_segment_num; k++) {
+				/* ascending order keeps the tie break of the full scan */
+				qsort(touchedVSegs, touchedVSegNum, sizeof(int), compare_vseg_index);
+				for (int t = 0; t < touchedVSegNum; t++) {
+					int k = touchedVSegs[t];
 					if (isBlockContinue[k] > maxBlockContinue) {
 						maxBlockContinue = isBlockContinue[k];
 						assignedVSeg = k;
@@ -3254,17 +3563,8 @@ static void allocate_random_relation(Relation_Data* rel_data,
 						assignment_context->totalvols[assignedVSeg] += rel_file->splits[r].length;
 						assignment_context->totalvols_with_penalty[assignedVSeg] += rel_file->splits[r].length;
 						if (partition_parent_oid > 0) {
-							PAIR p = getHASHTABLENode(
-									assignment_context->partitionvols_with_penalty_map,
-									TYPCONVERT(void *, partition_parent_oid));
-							int64** partitionvols_with_penalty = (int64 **) (&(p->Value));
-							(*partitionvols_with_penalty)[assignedVSeg] +=
-									rel_file->splits[r].length;
-							p = getHASHTABLENode(assignment_context->partitionvols_map,
-									TYPCONVERT(void *, partition_parent_oid));
-							int64** partitionvols = (int64 **) (&(p->Value));
-							(*partitionvols)[assignedVSeg] +=
-									rel_file->splits[r].length;
+							partitionvols_with_penalty[assignedVSeg] += rel_file->splits[r].length;
+							partitionvols[assignedVSeg] += rel_file->splits[r].length;
 						}
 						rel_file->splits[r].host = assignedVSeg;
 						if (debug_print_split_alloc_result) {
@@ -3285,15 +3585,8 @@ static void allocate_random_relation(Relation_Data* rel_data,
 						assignment_context->totalvols[assignedVSeg] += split_size;
 						assignment_context->totalvols_with_penalty[assignedVSeg] += split_size;
 						if (partition_parent_oid > 0) {
-							PAIR p = getHASHTABLENode(
-									assignment_context->partitionvols_with_penalty_map,
-									TYPCONVERT(void *, partition_parent_oid));
-							int64** partitionvols_with_penalty = (int64 **) (&(p->Value));
-							(*partitionvols_with_penalty)[assignedVSeg] += split_size;
-							p = getHASHTABLENode(assignment_context->partitionvols_map,
-									TYPCONVERT(void *, partition_parent_oid));
-							int64** partitionvols = (int64 **) (&(p->Value));
-							(*partitionvols)[assignedVSeg] += split_size;
+							partitionvols_with_penalty[assignedVSeg] += split_size;
+							partitionvols[assignedVSeg] += split_size;
 						}
 						if (debug_print_split_alloc_result) {
 							elog(LOG, "local4 split %d offset "INT64_FORMAT" of file %d is assigned to host %d",i,rel_file->splits[i].offset, rel_file->segno,assignedVSeg);
@@ -3305,9 +3598,10 @@ static void allocate_random_relation(Relation_Data* rel_data,
 
 				}
 
-				for (int r = 0; r < assignment_context->virtual_segment_num; r++) {
-					isBlockContinue[r] = 0;
+				for (int t = 0; t < touchedVSegNum; t++) {
+					isBlockContinue[touchedVSegs[t]] = 0;
 				}
+				touchedVSegNum = 0;
 				isBlocksBegin = true;
 			}
 			isLocalContinueBlockFound = false;
@@ -3346,16 +3640,8 @@ static void allocate_random_relation(Relation_Data* rel_data,
 			assignment_context->totalvols[assignedVSeg] += cur_split_size;
 			assignment_context->totalvols_with_penalty[assignedVSeg] += cur_split_size;
 			if (partition_parent_oid > 0) {
-				PAIR p = getHASHTABLENode(
-						assignment_context->partitionvols_with_penalty_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				int64** partitionvols_with_penalty = (int64 **) (&(p->Value));
-				(*partitionvols_with_penalty)[assignedVSeg] += cur_split_size;
-
-				p = getHASHTABLENode(assignment_context->partitionvols_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				int64** partitionvols = (int64 **) (&(p->Value));
-				(*partitionvols)[assignedVSeg] += cur_split_size;
+				partitionvols_with_penalty[assignedVSeg] += cur_split_size;
+				partitionvols[assignedVSeg] += cur_split_size;
 			}
 			log_context->localDataSizePerRelation += cur_split_size;
 			if (debug_print_split_alloc_result) {
@@ -3408,15 +3694,8 @@ static void allocate_random_relation(Relation_Data* rel_data,
 			assignment_context->totalvols[assignedVSeg] += cur_split_size;
 			assignment_context->totalvols_with_penalty[assignedVSeg] += cur_split_size;
 			if (partition_parent_oid > 0) {
-				PAIR p = getHASHTABLENode(
-						assignment_context->partitionvols_with_penalty_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				int64** partitionvols_with_penalty = (int64 **) (&(p->Value));
-				(*partitionvols_with_penalty)[assignedVSeg] += cur_split_size;
-				p = getHASHTABLENode(assignment_context->partitionvols_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				int64** partitionvols = (int64 **) (&(p->Value));
-				(*partitionvols)[assignedVSeg] += cur_split_size;
+				partitionvols_with_penalty[assignedVSeg] += cur_split_size;
+				partitionvols[assignedVSeg] += cur_split_size;
 			}
 			log_context->localDataSizePerRelation += cur_split_size;
 			if (debug_print_split_alloc_result) {
@@ -3442,23 +3721,13 @@ static void allocate_random_relation(Relation_Data* rel_data,
 			assignment_context->totalvols_with_penalty[assignedVSeg] +=
 					network_split_size;
 			if (partition_parent_oid > 0) {
-				PAIR p = getHASHTABLENode(
-						assignment_context->partitionvols_with_penalty_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				int64** partitionvols_with_penalty = (int64 **) (&(p->Value));
-				(*partitionvols_with_penalty)[assignedVSeg] += network_split_size;
-				p = getHASHTABLENode(assignment_context->partitionvols_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				int64** partitionvols = (int64 **) (&(p->Value));
-				(*partitionvols)[assignedVSeg] += cur_split_size;
+				partitionvols_with_penalty[assignedVSeg] += network_split_size;
+				partitionvols[assignedVSeg] += cur_split_size;
 			}
 			assignment_context->totalvols[assignedVSeg] += cur_split_size;
 			maxExtendedSizePerSegment += network_incre_size;
 			assignment_context->avg_size_of_whole_query += network_incre_size;
 			if(partition_parent_oid > 0){
-				PAIR pa = getHASHTABLENode(assignment_context->patition_parent_size_map,
-								TYPCONVERT(void *, partition_parent_oid));
-				int64* partitionParentAvgSize = (int64 *) (pa->Value);
 				*partitionParentAvgSize += network_incre_size;
 			}
 
@@ -3491,11 +3760,8 @@ static void allocate_random_relation(Relation_Data* rel_data,
 	if (debug_print_split_alloc_result) {
 		for (int j = 0; j < assignment_context->virtual_segment_num; j++) {
 			if (partition_parent_oid > 0) {
-				PAIR p = getHASHTABLENode(assignment_context->partitionvols_map,
-						TYPCONVERT(void *, partition_parent_oid));
-				int64** partitionvols_with_penalty = (int64 **) (&(p->Value));
 				elog(LOG, "for partition parent table %u: sub partition table size of of vseg %d "
-						"is "INT64_FORMAT"",partition_parent_oid,j, (*partitionvols_with_penalty)[j]);
+						"is "INT64_FORMAT"",partition_parent_oid,j, partitionvols[j]);
 			}
 		}
 		int64 maxvsSize = 0;
@@ -3541,6 +3807,8 @@ static void allocate_random_relation(Relation_Data* rel_data,
 		pfree(file_vector);
 	}
 	pfree(isBlockContinue);
+	pfree(touchedVSegs);
+	pfree(splitSizePrefix);
 }
 
 /*
@@ -3579,40 +3847,48 @@ static int remedy_non_localRead(int fileIndex, int splitIndex, int parentPos,
 				|| !former_file->splits[j].is_local_read) {
 					continue;
 				}
-				for (int p = 0; p < 3; p++) {
-					Block_Host_Index *formerHostID = former_file->hostIDs + j;
+				Block_Host_Index *formerHostID = former_file->hostIDs + j;
+				for (int p = 0; p < formerHostID->replica_num && p < 3; p++) {
 					if (formerHostID->hostIndex[p]
 							== hostID->hostIndex[parentPos]) {
 						continue;
 					}
 
-					for (int v = 0; v < assignment_context->virtual_segment_num; v++) {
-						if (idMap->global_IDs[v] == formerHostID->hostIndex[p]) {
-							bool isExceedMaxSize = former_split_size
-									+ assignment_context->vols[v] > maxExtendedSizePerSegment;
-							bool isExceedWholeSize = balance_on_whole_query_level
-									&& former_split_size
-											+ assignment_context->totalvols_with_penalty[v]
-											> assignment_context->avg_size_of_whole_query;
-							if (!isExceedWholeSize&& !isExceedMaxSize){
-								//removesplit
-								assignment_context->split_num[orivseg]--;
-								assignment_context->vols[orivseg] -= former_split_size;
-								assignment_context->totalvols[orivseg] -= former_split_size;
-								assignment_context->totalvols_with_penalty[orivseg] -=
-										former_split_size;
-								//insertsplit
-								former_file->splits[j].host = v;
-								assignment_context->split_num[v]++;
-								// we simply treat adjusted split as continue one
-								assignment_context->continue_split_num[v]++;
-								assignment_context->vols[v] += former_split_size;
-								assignment_context->totalvols[v] += former_split_size;
-								assignment_context->totalvols_with_penalty[v] +=
-										former_split_size;
-								isDone = true;
-								break;
-							}
+					/* vsegs of the replica host, in ascending order */
+					uint32_t key = formerHostID->hostIndex[p];
+					PAIR pair = getHASHTABLENode(assignment_context->vseg_to_splits_map,
+							TYPCONVERT(void *, key));
+					if (pair == NULL) {
+						continue;
+					}
+					ListCell *lc;
+					foreach(lc, (List *) (pair->Value))
+					{
+						int v = lfirst_int(lc);
+						bool isExceedMaxSize = former_split_size
+								+ assignment_context->vols[v] > maxExtendedSizePerSegment;
+						bool isExceedWholeSize = balance_on_whole_query_level
+								&& former_split_size
+										+ assignment_context->totalvols_with_penalty[v]
+										> assignment_context->avg_size_of_whole_query;
+						if (!isExceedWholeSize&& !isExceedMaxSize){
+							//removesplit
+							assignment_context->split_num[orivseg]--;
+							assignment_context->vols[orivseg] -= former_split_size;
+							assignment_context->totalvols[orivseg] -= former_split_size;
+							assignment_context->totalvols_with_penalty[orivseg] -=
+									former_split_size;
+							//insertsplit
+							former_file->splits[j].host = v;
+							assignment_context->split_num[v]++;
+							// we simply treat adjusted split as continue one
+							assignment_context->continue_split_num[v]++;
+							assignment_context->vols[v] += former_split_size;
+							assignment_context->totalvols[v] += former_split_size;
+							assignment_context->totalvols_with_penalty[v] +=
+									former_split_size;
+							isDone = true;
+							break;
 						}
 					}
 					if (isDone) {
@@ -4311,8 +4587,9 @@ run_allocation_algorithm(SplitAllocResult *result, List *virtual_segments, Query
 	}
 
     result->datalocalityTime = (double)(context->metadata_cache_time_us + context->alloc_resource_time_us + context->cal_datalocality_time_us)/ 1000;
-    appendStringInfo(result->datalocalityInfo, "DFS metadatacache: %.3f ms; resource allocation: %.3f ms; datalocality calculation: %.3f ms.",
-            (double)context->metadata_cache_time_us/1000, (double)context->alloc_resource_time_us/1000, (double)context->cal_datalocality_time_us/1000);  
+    appendStringInfo(result->datalocalityInfo, "DFS metadatacache: %.3f ms (cache hit files: %d, HDFS fetch files: %d, concurrently fetched files: %d); resource allocation: %.3f ms; datalocality calculation: %.3f ms.",
+            (double)context->metadata_cache_time_us/1000, context->metadata_cache_hit_files, context->hdfs_fetch_files, context->hdfs_prefetch_files,
+            (double)context->alloc_resource_time_us/1000, (double)context->cal_datalocality_time_us/1000);  
 
 	return alloc_result;
 }
@@ -4342,6 +4619,18 @@ static void cleanup_allocation_algorithm(
 		}
 	}
 
+	/* prefetched block locations which no relation took */
+	if (context->prefetched_locations != NULL) {
+		HASH_SEQ_STATUS status;
+		PrefetchedLocationEntry *entry;
+
+		hash_seq_init(&status, context->prefetched_locations);
+		while ((entry = (PrefetchedLocationEntry *) hash_seq_search(&status)) != NULL) {
+			HdfsFreeFileBlockLocations(entry->locations, entry->block_num);
+		}
+		context->prefetched_locations = NULL;
+	}
+
 	if(DataLocalityMemoryContext){
 	  MemoryContextResetAndDeleteChildren(DataLocalityMemoryContext);
 	}
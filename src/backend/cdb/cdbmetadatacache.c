@@ -730,6 +730,25 @@ BlockLocation *GetHdfsFileBlockLocations(const HdfsFileInfo *file_info, uint64_t
     return locations;
 }
 
+/*
+ *  Check whether the block locations of the first filesize bytes of a file are in metadata cache
+ */
+bool
+HdfsFileBlockLocationsCached(const HdfsFileInfo *file_info, uint64_t filesize)
+{
+    Insist(file_info != NULL);
+
+    MetadataCacheEntry *cache_entry = NULL;
+    bool cached = false;
+
+    LWLockAcquire(MetadataCacheLock, LW_SHARED);
+    cache_entry = MetadataCacheExists(file_info);
+    cached = (NULL != cache_entry) && (filesize <= cache_entry->file_size);
+    LWLockRelease(MetadataCacheLock);
+
+    return cached;
+}
+
 /*
  *  Get hdfs file block locations from Hadoop HDFS and put the result into metadata cache
  */
@@ -737,21 +756,33 @@ BlockLocation *
 GetHdfsFileBlockLocationsNoCache(const HdfsFileInfo *file_info, uint64_t filesize, int *block_num)
 {
     BlockLocation *hdfs_locations = NULL; 
-    BlockLocation *locations = NULL; 
-    MetadataCacheEntry *entry = NULL;
 
     // 1. fetch hdfs block locations
     hdfs_locations = HdfsGetFileBlockLocations(file_info->filepath, filesize, block_num);
+
+    return CacheHdfsFileBlockLocations(file_info, filesize, hdfs_locations, block_num);
+}
+
+/*
+ *  Put hdfs block locations fetched from Hadoop HDFS into metadata cache and return
+ *  the block locations for user, hdfs_locations is freed
+ */
+BlockLocation *
+CacheHdfsFileBlockLocations(const HdfsFileInfo *file_info, uint64_t filesize, BlockLocation *hdfs_locations, int *block_num)
+{
+    BlockLocation *locations = NULL; 
+    MetadataCacheEntry *entry = NULL;
+
     if ((NULL == hdfs_locations) || (0 == *block_num))
     {
-        elog(DEBUG1, "[MetadataCache] GetHdfsFileBlockLocationsNoCache fetch hdfs block locatons fail. filename:%s filesize:"INT64_FORMAT" block_num:%d",
+        elog(DEBUG1, "[MetadataCache] CacheHdfsFileBlockLocations fetch hdfs block locatons fail. filename:%s filesize:"INT64_FORMAT" block_num:%d",
                                 file_info->filepath, 
                                 filesize, 
                                 *block_num);
         goto done;
     }
     
-    elog(DEBUG1, "[MetadataCache] GetHdfsFileBlockLocationsNoCache fetch hdfs block locatons successfully. filename:%s filesize:"INT64_FORMAT" block_num:%d",
+    elog(DEBUG1, "[MetadataCache] CacheHdfsFileBlockLocations fetch hdfs block locatons successfully. filename:%s filesize:"INT64_FORMAT" block_num:%d",
                                 file_info->filepath, 
                                 filesize, 
                                 *block_num);
@@ -762,11 +793,28 @@ GetHdfsFileBlockLocationsNoCache(const HdfsFileInfo *file_info, uint64_t filesiz
     // 3. generate result block locations
     locations = CreateHdfsFileBlockLocations(hdfs_locations, *block_num);
 
+    /*
+     * Another backend may have cached the file while the lock was released,
+     * keep its entry if it covers at least as much of the file, otherwise
+     * replace it. Entering the key again would leak the blocks of the old
+     * entry.
+     */
+    entry = MetadataCacheExists(file_info);
+    if (NULL != entry)
+    {
+        if (entry->file_size >= filesize)
+        {
+            LWLockRelease(MetadataCacheLock);
+            goto done;
+        }
+        RemoveHdfsFileBlockLocations(file_info);
+    }
+
     entry = MetadataCacheNew(file_info, filesize, hdfs_locations, *block_num); 
     if (NULL == entry)
     {
         LWLockRelease(MetadataCacheLock);
-        elog(DEBUG1, "[MetadataCache] GetHdfsFileBlockLocationsNoCache put hdfs block locations info cache fail. filename:%s filesize:"INT64_FORMAT" block_num:%d",
+        elog(DEBUG1, "[MetadataCache] CacheHdfsFileBlockLocations put hdfs block locations info cache fail. filename:%s filesize:"INT64_FORMAT" block_num:%d",
                                 file_info->filepath, 
                                 filesize, 
                                 *block_num);
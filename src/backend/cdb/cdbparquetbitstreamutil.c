@@ -33,13 +33,10 @@ static void writeIntLittleEndianOnTwoBytes	(CapacityByteWriter *out, uint32_t va
 
 static int readIntLittleEndianOnOneByte(uint8_t *in);
 static int readIntLittleEndianOnTwoBytes(uint8_t *in);
-
-#ifdef NOT_USED
 static void writeIntLittleEndianOnThreeBytes(CapacityByteWriter *out, uint32_t value);
 static void writeIntLittleEndianOnFourBytes	(CapacityByteWriter *out, uint32_t value);
 static int readIntLittleEndianOnThreeBytes(uint8_t *in);
 static int readIntLittleEndianOnFourBytes(uint8_t *in);
-#endif
 
 static int paddedByteCountFromBits(int bitLength);
 
@@ -133,20 +130,21 @@ writeIntLittleEndianPaddedOnBitWidth(CapacityByteWriter *writer, int value, int
 {
 	switch (paddedByteCountFromBits(bitWidth))
 	{
+	case 0:
+		/* zero bit width, the value is implied */
+		break;
 	case 1:
 		writeIntLittleEndianOnOneByte(writer, value);
 		break;
 	case 2:
 		writeIntLittleEndianOnTwoBytes(writer, value);
 		break;
-#ifdef NOT_USED
 	case 3:
 		writeIntLittleEndianOnThreeBytes(writer, value);
 		break;
 	case 4:
 		writeIntLittleEndianOnFourBytes(writer, value);
 		break;
-#endif
 	default:
 		/*ereport error*/
 		break;
@@ -159,20 +157,21 @@ readIntLittleEndianPaddedOnBitWidth(int bitWidth, uint8_t *in, int *val)
 	int bytes_to_read = paddedByteCountFromBits(bitWidth);
 	switch (bytes_to_read)
 	{
+	case 0:
+		*val = 0;
+		break;
 	case 1:
 		*val = readIntLittleEndianOnOneByte(in);
 		break;
 	case 2:
 		*val = readIntLittleEndianOnTwoBytes(in);
 		break;
-#ifdef NOT_USED
 	case 3:
 		*val = readIntLittleEndianOnThreeBytes(in);
 		break;
 	case 4:
 		*val = readIntLittleEndianOnFourBytes(in);
 		break;
-#endif
 	default:
 		/* TODO raise error */
 		return -1;
@@ -208,7 +207,6 @@ readIntLittleEndianOnTwoBytes(uint8_t *in)
 	return ((ch2 << 8) + (ch1 << 0));
 }
 
-#ifdef NOT_USED
 void
 writeIntLittleEndianOnThreeBytes(CapacityByteWriter *out, uint32_t value)
 {
@@ -244,4 +242,3 @@ readIntLittleEndianOnFourBytes(uint8_t *in)
 	int ch4 = (int) in[3];
 	return ((ch4 << 24) + (ch3 << 16) + (ch2 << 8) + (ch1 << 0));
 }
-#endif
@@ -49,6 +49,9 @@ static void unpack8Values7Bits(uint8_t *in, int inPos, int32_t *out, int outPos)
 static void unpack8Values8Bits(uint8_t *in, int inPos, int32_t *out, int outPos);
 #endif
 
+static void pack8ValuesAnyBits(int bitWidth, int32_t *in, int inPos, uint8_t* out, int outPos);
+static void unpack8ValuesAnyBits(int bitWidth, uint8_t *in, int inPos, int32_t *out, int outPos);
+
 static int paddedByteCountFromBits(int numBits);
 static void pack(ByteBasedBitPackingEncoder *encoder);
 
@@ -240,7 +243,7 @@ pack8Values(int bitWidth, int32_t *in, int inPos, uint8_t* out, int outPos)
 		break;
 #endif
 	default:
-		/*ereport error*/
+		pack8ValuesAnyBits(bitWidth, in, inPos, out, outPos);
 		break;
 	}
 }
@@ -324,11 +327,62 @@ unpack8Values(int bitWidth, uint8_t *in, int inPos, int32_t *out, int outPos)
 		break;
 #endif
 	default:
-		/*ereport error*/
+		unpack8ValuesAnyBits(bitWidth, in, inPos, out, outPos);
 		break;
 	}
 }
 
+/*
+ * Pack 8 values of any bit width (0 to 32) into `bitWidth` bytes, least
+ * significant bit first. Widths 1 and 2 have unrolled versions below; the
+ * wider widths are needed by dictionary indices.
+ */
+void
+pack8ValuesAnyBits(int bitWidth, int32_t *in, int inPos, uint8_t* out, int outPos)
+{
+	uint64_t	buffer = 0;
+	int			bufferBits = 0;
+	uint64_t	mask = (bitWidth == 32) ? 0xFFFFFFFFULL : ((1ULL << bitWidth) - 1);
+	int			i;
+
+	Assert(bitWidth >= 0 && bitWidth <= 32);
+
+	for (i = 0; i < 8; i++)
+	{
+		buffer |= (((uint64_t) (uint32_t) in[i + inPos]) & mask) << bufferBits;
+		bufferBits += bitWidth;
+		while (bufferBits >= 8)
+		{
+			out[outPos++] = (uint8_t) (buffer & 255);
+			buffer >>= 8;
+			bufferBits -= 8;
+		}
+	}
+}
+
+void
+unpack8ValuesAnyBits(int bitWidth, uint8_t *in, int inPos, int32_t *out, int outPos)
+{
+	uint64_t	buffer = 0;
+	int			bufferBits = 0;
+	uint64_t	mask = (bitWidth == 32) ? 0xFFFFFFFFULL : ((1ULL << bitWidth) - 1);
+	int			i;
+
+	Assert(bitWidth >= 0 && bitWidth <= 32);
+
+	for (i = 0; i < 8; i++)
+	{
+		while (bufferBits < bitWidth)
+		{
+			buffer |= ((uint64_t) in[inPos++]) << bufferBits;
+			bufferBits += 8;
+		}
+		out[i + outPos] = (int32_t) (buffer & mask);
+		buffer >>= bitWidth;
+		bufferBits -= bitWidth;
+	}
+}
+
 void
 pack8Values1Bits(int32_t *in, int inPos, uint8_t* out, int outPos)
 {
@@ -40,8 +40,16 @@
 static void consume(ParquetColumnReader *columnReader);
 static void readRepetitionAndDefinitionLevels(ParquetColumnReader *columnReader);
 static void decodeCurrentPage(ParquetColumnReader *columnReader);
+static void decompressPage(ParquetColumnReader *columnReader, ParquetPageHeader header,
+						   uint8_t *compressed, uint8_t *buf);
+static void readDictionaryPage(ParquetColumnReader *columnReader, ParquetPageHeader header,
+							   uint8_t *data);
+static void decodeDictionary(ParquetColumnReader *columnReader, int hawqTypeID);
 
 static bool decodePlain(Datum *value, uint8_t **buffer, int hawqTypeID);
+static void decodePageValues(ParquetColumnReader *columnReader, int hawqTypeID);
+static void decodePlainValues(Datum *values, bool *nulls, int count,
+							  uint8_t **buffer, int hawqTypeID);
 
 /* return size of PATH struct given number of points in it */
 static inline int get_path_size(int npts) { return offsetof(PATH, p[0]) + sizeof(Point) * npts; }
@@ -56,6 +64,13 @@ ParquetExecutorReadColumn(ParquetColumnReader *columnReader, File file)
 
 	int64 firstPageOffset = columnChunkMetadata->firstDataPage;
 
+	/* dictionary page, if any, is the first page of the column chunk */
+	if (columnChunkMetadata->dictionaryPageOffset > 0 &&
+		columnChunkMetadata->dictionaryPageOffset < firstPageOffset)
+	{
+		firstPageOffset = columnChunkMetadata->dictionaryPageOffset;
+	}
+
 	int64 columnChunkSize = columnChunkMetadata->totalSize;
 
 	if ( columnChunkSize > MaxAllocSize ) 
@@ -144,14 +159,13 @@ ParquetExecutorReadColumn(ParquetColumnReader *columnReader, File file)
 
 		buffer += header_size;
 
-		/*just process data page now*/
+		/*just process data page and dictionary page now*/
 		if(pageHeader->page_type != DATA_PAGE){
 			if(pageHeader->page_type == DICTIONARY_PAGE) {
-				ereport(ERROR, (errcode(ERRCODE_GP_INTERNAL_ERROR),
-								errmsg("HAWQ does not support dictionary page type resolver for Parquet format in column \'%s\' ",
-										columnChunkMetadata->colName)));
+				readDictionaryPage(columnReader, pageHeader, (uint8_t *) buffer);
 			}
 			buffer += pageHeader->compressed_page_size;
+			pfree(pageHeader);
 			continue;
 		}
 
@@ -188,6 +202,70 @@ ParquetExecutorReadColumn(ParquetColumnReader *columnReader, File file)
 	}
 }
 
+/*
+ * Keep the dictionary page of the column chunk, decompressed if needed.
+ * Entries are decoded later by decodeDictionary().
+ */
+static void
+readDictionaryPage(ParquetColumnReader *columnReader,
+				   ParquetPageHeader header,
+				   uint8_t *data)
+{
+	if (columnReader->columnMetadata->codec == UNCOMPRESSED)
+	{
+		columnReader->dictionaryData = data;
+	}
+	else
+	{
+		if (columnReader->dictionaryBufferLen < header->uncompressed_page_size)
+		{
+			if (columnReader->dictionaryBuffer != NULL)
+			{
+				pfree(columnReader->dictionaryBuffer);
+			}
+			columnReader->dictionaryBufferLen = header->uncompressed_page_size;
+			columnReader->dictionaryBuffer = palloc(columnReader->dictionaryBufferLen);
+		}
+
+		decompressPage(columnReader, header, data, (uint8_t *) columnReader->dictionaryBuffer);
+		columnReader->dictionaryData = (uint8_t *) columnReader->dictionaryBuffer;
+	}
+
+	columnReader->dictionarySize = header->num_values;
+	columnReader->dictionaryDecoded = false;
+}
+
+/*
+ * Decode all plain encoded entries of the dictionary page as `hawqTypeID`.
+ */
+static void
+decodeDictionary(ParquetColumnReader *columnReader, int hawqTypeID)
+{
+	MemoryContext oldContext;
+	uint8_t *buf = columnReader->dictionaryData;
+
+	oldContext = MemoryContextSwitchTo(columnReader->memoryContext);
+
+	if (columnReader->dictionaryCapacity < columnReader->dictionarySize)
+	{
+		if (columnReader->dictionary != NULL)
+		{
+			pfree(columnReader->dictionary);
+		}
+		columnReader->dictionaryCapacity = columnReader->dictionarySize;
+		columnReader->dictionary = (Datum *) palloc(columnReader->dictionaryCapacity * sizeof(Datum));
+	}
+
+	for (int i = 0; i < columnReader->dictionarySize; i++)
+	{
+		decodePlain(&columnReader->dictionary[i], &buf, hawqTypeID);
+	}
+
+	columnReader->dictionaryDecoded = true;
+
+	MemoryContextSwitchTo(oldContext);
+}
+
 /*
  * End the current value, move to next r/d/value.
  * Should be called after current value is read.
@@ -288,89 +366,8 @@ decodeCurrentPage(ParquetColumnReader *columnReader)
 			buf = (uint8_t *) columnReader->pageBuffer;
 		}
 
-		/*
-		 * call corresponding decompress routine
-		 */
-		switch (chunkmd->codec)
-		{
-			case SNAPPY:
-			{
-				size_t uncompressedLen;
-				if (snappy_uncompressed_length((char *) page->data,
-											   header->compressed_page_size,
-											   &uncompressedLen) != SNAPPY_OK)
-				{
-					ereport(ERROR,
-							(errcode(ERRCODE_GP_INTERNAL_ERROR),
-							 errmsg("invalid snappy compressed data for column %s, page number %d",
-									chunkmd->colName, columnReader->dataPageProcessed)));
-				}
-
-				Insist(uncompressedLen == header->uncompressed_page_size);
-
-				if (snappy_uncompress((char *) page->data,		header->compressed_page_size,
-									  (char *) buf,				&uncompressedLen) != SNAPPY_OK)
-				{
-					ereport(ERROR,
-							(errcode(ERRCODE_GP_INTERNAL_ERROR),
-							 errmsg("failed to decompress snappy data for column %s, page number %d, "
-									"uncompressed size %d, compressed size %d",
-									chunkmd->colName, columnReader->dataPageProcessed,
-									header->uncompressed_page_size, header->compressed_page_size)));
-				}
-				
-				page->data = buf;
-				break;
-			}
-			case GZIP:
-			{
-				int ret;
-				/* 15(default windowBits for deflate) + 16(ouput GZIP header/tailer) */
-				const int windowbits = 31;
-
-				z_stream stream;
-				stream.zalloc	= Z_NULL;
-				stream.zfree	= Z_NULL;
-				stream.opaque	= Z_NULL;
-				stream.avail_in	= header->compressed_page_size;
-				stream.next_in	= (Bytef *) page->data;
-				
-				ret = inflateInit2(&stream, windowbits);
-				if (ret != Z_OK)
-				{
-					ereport(ERROR,
-							(errcode(ERRCODE_GP_INTERNAL_ERROR),
-							 errmsg("zlib inflateInit2 failed: %s", stream.msg)));
-				}
-
-				size_t uncompressedLen = header->uncompressed_page_size;
-
-				stream.avail_out = uncompressedLen;
-				stream.next_out  = (Bytef *) buf;
-				ret = inflate(&stream, Z_FINISH);
-				if (ret != Z_STREAM_END)
-				{
-					ereport(ERROR,
-							(errcode(ERRCODE_GP_INTERNAL_ERROR),
-							 errmsg("zlib inflate failed: %s", stream.msg)));
-				
-				}
-				/* should fill all uncompressed_page_size bytes */
-				Assert(stream.avail_out == 0);
-
-				inflateEnd(&stream);
-
-				page->data = buf;
-				break;
-			}
-			case LZO:
-				/* TODO */
-				Insist(false);
-				break;
-			default:
-				Insist(false);
-				break;
-		}
+		decompressPage(columnReader, header, page->data, buf);
+		page->data = buf;
 	}
 
 	/*----------------------------------------------------------------
@@ -410,6 +407,26 @@ decodeCurrentPage(ParquetColumnReader *columnReader)
 				palloc0(sizeof(ByteBasedBitPackingDecoder));
 		BitPack_InitDecoder(page->bool_values_reader, buf, /*bitwidth=*/1);
 	}
+	else if (header->encoding == PLAIN_DICTIONARY || header->encoding == RLE_DICTIONARY)
+	{
+		/* value = <1-byte bit width> + <rle/bitpack encoded dictionary indices> */
+		int bitWidth = *buf;
+		buf += 1;
+
+		if (columnReader->dictionaryData == NULL || bitWidth > 32)
+		{
+			ereport(ERROR,
+					(errcode(ERRCODE_DATA_CORRUPTED),
+					 errmsg("invalid dictionary encoded page for column %s, page number %d",
+							chunkmd->colName, columnReader->dataPageProcessed)));
+		}
+
+		page->dict_index_reader = (RLEDecoder *) palloc0(sizeof(RLEDecoder));
+		RLEDecoder_Init(page->dict_index_reader,
+						bitWidth,
+						buf,
+						header->uncompressed_page_size - (buf - page->data));
+	}
 	else
 	{
 		page->values_buffer = buf;
@@ -418,6 +435,97 @@ decodeCurrentPage(ParquetColumnReader *columnReader)
 	MemoryContextSwitchTo(oldContext);
 }
 
+/*
+ * Decompress `compressed` page data of the column chunk into `buf`, which
+ * should be large enough for uncompressed_page_size bytes.
+ */
+static void
+decompressPage(ParquetColumnReader *columnReader,
+			   ParquetPageHeader header,
+			   uint8_t *compressed,
+			   uint8_t *buf)
+{
+	ColumnChunkMetadata_4C *chunkmd = columnReader->columnMetadata;
+
+	switch (chunkmd->codec)
+	{
+		case SNAPPY:
+		{
+			size_t uncompressedLen;
+			if (snappy_uncompressed_length((char *) compressed,
+										   header->compressed_page_size,
+										   &uncompressedLen) != SNAPPY_OK)
+			{
+				ereport(ERROR,
+						(errcode(ERRCODE_GP_INTERNAL_ERROR),
+						 errmsg("invalid snappy compressed data for column %s, page number %d",
+								chunkmd->colName, columnReader->dataPageProcessed)));
+			}
+
+			Insist(uncompressedLen == header->uncompressed_page_size);
+
+			if (snappy_uncompress((char *) compressed,		header->compressed_page_size,
+								  (char *) buf,				&uncompressedLen) != SNAPPY_OK)
+			{
+				ereport(ERROR,
+						(errcode(ERRCODE_GP_INTERNAL_ERROR),
+						 errmsg("failed to decompress snappy data for column %s, page number %d, "
+								"uncompressed size %d, compressed size %d",
+								chunkmd->colName, columnReader->dataPageProcessed,
+								header->uncompressed_page_size, header->compressed_page_size)));
+			}
+			break;
+		}
+		case GZIP:
+		{
+			int ret;
+			/* 15(default windowBits for deflate) + 16(ouput GZIP header/tailer) */
+			const int windowbits = 31;
+
+			z_stream stream;
+			stream.zalloc	= Z_NULL;
+			stream.zfree	= Z_NULL;
+			stream.opaque	= Z_NULL;
+			stream.avail_in	= header->compressed_page_size;
+			stream.next_in	= (Bytef *) compressed;
+			
+			ret = inflateInit2(&stream, windowbits);
+			if (ret != Z_OK)
+			{
+				ereport(ERROR,
+						(errcode(ERRCODE_GP_INTERNAL_ERROR),
+						 errmsg("zlib inflateInit2 failed: %s", stream.msg)));
+			}
+
+			size_t uncompressedLen = header->uncompressed_page_size;
+
+			stream.avail_out = uncompressedLen;
+			stream.next_out  = (Bytef *) buf;
+			ret = inflate(&stream, Z_FINISH);
+			if (ret != Z_STREAM_END)
+			{
+				ereport(ERROR,
+						(errcode(ERRCODE_GP_INTERNAL_ERROR),
+						 errmsg("zlib inflate failed: %s", stream.msg)));
+			
+			}
+			/* should fill all uncompressed_page_size bytes */
+			Assert(stream.avail_out == 0);
+
+			inflateEnd(&stream);
+
+			break;
+		}
+		case LZO:
+			/* TODO */
+			Insist(false);
+			break;
+		default:
+			Insist(false);
+			break;
+	}
+}
+
 /**
  * Read the value from a certain columnReader, the value will be embedded in value,
  * and if the value is null, the null field should be true
@@ -454,6 +562,25 @@ ParquetColumnReader_readValue(
 		{
 			*value = BoolGetDatum((bool) BitPack_ReadInt(columnReader->currentPage->bool_values_reader));
 		}
+		else if (columnReader->currentPage->dict_index_reader != NULL)
+		{
+			int index = RLEDecoder_ReadInt(columnReader->currentPage->dict_index_reader);
+
+			if (!columnReader->dictionaryDecoded)
+			{
+				decodeDictionary(columnReader, hawqTypeID);
+			}
+
+			if (index < 0 || index >= columnReader->dictionarySize)
+			{
+				ereport(ERROR,
+						(errcode(ERRCODE_DATA_CORRUPTED),
+						 errmsg("dictionary index %d out of range for column %s with %d entries",
+								index, columnReader->columnMetadata->colName,
+								columnReader->dictionarySize)));
+			}
+			*value = columnReader->dictionary[index];
+		}
 		else
 		{
 			decodePlain(value, &(columnReader->currentPage->values_buffer), hawqTypeID);
@@ -469,6 +596,244 @@ ParquetColumnReader_readValue(
 	}
 }
 
+/*
+ * Make sure the current page of a non-repeatable column has values left,
+ * decoding the next page into column arrays if the current one is used up.
+ *
+ * Return the number of values left in the current page, 0 at the end of
+ * the column chunk. For compressed column, decoded values point into the
+ * shared page buffer, so they are valid until the next page is decoded.
+ */
+int
+ParquetColumnReader_prepareValues(
+		ParquetColumnReader *columnReader,
+		int hawqTypeID)
+{
+	Assert(columnReader->columnMetadata->r == 0);
+
+	if (columnReader->currentPageValueRemained == 0)
+	{
+		if (columnReader->dataPageProcessed >= columnReader->dataPageNum)
+		{
+			return 0;
+		}
+
+		columnReader->currentPage = &columnReader->dataPages[columnReader->dataPageProcessed];
+		decodeCurrentPage(columnReader);
+		decodePageValues(columnReader, hawqTypeID);
+
+		columnReader->currentPageValueRemained = columnReader->currentPage->header->num_values;
+		columnReader->dataPageProcessed++;
+	}
+
+	return columnReader->currentPageValueRemained;
+}
+
+/*
+ * Copy the next `count` decoded values of the current page, which should
+ * have been checked to be available by ParquetColumnReader_prepareValues().
+ */
+void
+ParquetColumnReader_readValues(
+		ParquetColumnReader *columnReader,
+		Datum *values,
+		bool *nulls,
+		int count)
+{
+	int start;
+
+	Assert(count <= columnReader->currentPageValueRemained);
+
+	start = columnReader->currentPage->header->num_values - columnReader->currentPageValueRemained;
+	memcpy(values, columnReader->pageValues + start, count * sizeof(Datum));
+	memcpy(nulls, columnReader->pageNulls + start, count * sizeof(bool));
+
+	columnReader->currentPageValueRemained -= count;
+}
+
+/*
+ * Decode definition levels and values of the whole current page into
+ * `pageValues` and `pageNulls`.
+ */
+static void
+decodePageValues(ParquetColumnReader *columnReader, int hawqTypeID)
+{
+	ParquetDataPage page = columnReader->currentPage;
+	int numValues = page->header->num_values;
+	int maxLevel = columnReader->columnMetadata->d;
+	int numNotNull;
+	int i;
+
+	if (columnReader->pageValueCapacity < numValues)
+	{
+		MemoryContext oldContext = MemoryContextSwitchTo(columnReader->memoryContext);
+
+		if (columnReader->pageValues != NULL)
+		{
+			pfree(columnReader->pageValues);
+			pfree(columnReader->pageNulls);
+			pfree(columnReader->pageInts);
+		}
+		columnReader->pageValueCapacity = numValues;
+		columnReader->pageValues = (Datum *) palloc(numValues * sizeof(Datum));
+		columnReader->pageNulls = (bool *) palloc(numValues * sizeof(bool));
+		columnReader->pageInts = (int *) palloc(numValues * sizeof(int));
+
+		MemoryContextSwitchTo(oldContext);
+	}
+
+	/* value is null if its definition level is less than the max level */
+	numNotNull = numValues;
+	if (page->definition_level_reader != NULL)
+	{
+		RLEDecoder_ReadInts(page->definition_level_reader, columnReader->pageInts, numValues);
+
+		numNotNull = 0;
+		for (i = 0; i < numValues; i++)
+		{
+			columnReader->pageNulls[i] = (columnReader->pageInts[i] < maxLevel);
+			numNotNull += columnReader->pageNulls[i] ? 0 : 1;
+		}
+	}
+	else
+	{
+		memset(columnReader->pageNulls, 0, numValues * sizeof(bool));
+	}
+
+	if (hawqTypeID == HAWQ_TYPE_BOOL)
+	{
+		for (i = 0; i < numValues; i++)
+		{
+			columnReader->pageValues[i] = columnReader->pageNulls[i] ? (Datum) 0 :
+				BoolGetDatum((bool) BitPack_ReadInt(page->bool_values_reader));
+		}
+	}
+	else if (page->dict_index_reader != NULL)
+	{
+		int *indices = columnReader->pageInts;
+		int n = 0;
+
+		if (!columnReader->dictionaryDecoded)
+		{
+			decodeDictionary(columnReader, hawqTypeID);
+		}
+
+		/* indices are only stored for non-null values */
+		RLEDecoder_ReadInts(page->dict_index_reader, indices, numNotNull);
+		for (i = 0; i < numValues; i++)
+		{
+			if (columnReader->pageNulls[i])
+			{
+				columnReader->pageValues[i] = (Datum) 0;
+				continue;
+			}
+			if (indices[n] < 0 || indices[n] >= columnReader->dictionarySize)
+			{
+				ereport(ERROR,
+						(errcode(ERRCODE_DATA_CORRUPTED),
+						 errmsg("dictionary index %d out of range for column %s with %d entries",
+								indices[n], columnReader->columnMetadata->colName,
+								columnReader->dictionarySize)));
+			}
+			columnReader->pageValues[i] = columnReader->dictionary[indices[n++]];
+		}
+	}
+	else
+	{
+		decodePlainValues(columnReader->pageValues, columnReader->pageNulls, numValues,
+						  &page->values_buffer, hawqTypeID);
+	}
+}
+
+/*
+ * Decode plain encoded values of a page, which are only stored for
+ * non-null entries. Fixed width types are decoded in a tight loop, other
+ * types one by one through decodePlain().
+ */
+static void
+decodePlainValues(Datum *values, bool *nulls, int count, uint8_t **buffer, int hawqTypeID)
+{
+	uint8_t *buf = *buffer;
+	int i;
+
+	switch (hawqTypeID)
+	{
+		case HAWQ_TYPE_INT2:
+		case HAWQ_TYPE_INT4:
+		case HAWQ_TYPE_DATE:
+		case HAWQ_TYPE_FLOAT4:
+		{
+			for (i = 0; i < count; i++)
+			{
+				if (nulls[i])
+				{
+					values[i] = (Datum) 0;
+					continue;
+				}
+				values[i] = *((int32_t *) buf);
+				buf += 4;
+			}
+			break;
+		}
+
+		case HAWQ_TYPE_INT8:
+		case HAWQ_TYPE_TIME:
+		case HAWQ_TYPE_TIMESTAMPTZ:
+		case HAWQ_TYPE_TIMESTAMP:
+		case HAWQ_TYPE_FLOAT8:
+		{
+			for (i = 0; i < count; i++)
+			{
+				if (nulls[i])
+				{
+					values[i] = (Datum) 0;
+					continue;
+				}
+				values[i] = *((int64_t *) buf);
+				buf += 8;
+			}
+			break;
+		}
+
+		case HAWQ_TYPE_MACADDR:
+		{
+			/*
+			 * macaddr has no alignment requirement, point to the value
+			 * in the page buffer instead of copying it to a palloc'ed
+			 * one, which would not survive the per tuple context.
+			 */
+			for (i = 0; i < count; i++)
+			{
+				if (nulls[i])
+				{
+					values[i] = (Datum) 0;
+					continue;
+				}
+				buf += 4;	/* skip BINARY header */
+				values[i] = PointerGetDatum(buf);
+				buf += sizeof(macaddr);
+			}
+			break;
+		}
+
+		default:
+		{
+			for (i = 0; i < count; i++)
+			{
+				if (nulls[i])
+				{
+					values[i] = (Datum) 0;
+					continue;
+				}
+				decodePlain(&values[i], &buf, hawqTypeID);
+			}
+			break;
+		}
+	}
+
+	*buffer = buf;
+}
+
 static bool
 decodePlain(Datum *value, uint8_t **buffer, int hawqTypeID)
 {
@@ -633,6 +998,11 @@ ParquetColumnReader_FinishedScanColumn(
 			pfree(page->bool_values_reader);
 		}
 
+		if (page->dict_index_reader != NULL)
+		{
+			pfree(page->dict_index_reader);
+		}
+
 		/*
 		 * compressed repeatable column keeps each page's decompressed
 		 * content in page->data, which should be freed.
@@ -648,6 +1018,10 @@ ParquetColumnReader_FinishedScanColumn(
 		memset(columnReader->dataBuffer, 0, columnReader->dataLen);
 	}
 
+	columnReader->dictionaryData = NULL;
+	columnReader->dictionarySize = 0;
+	columnReader->dictionaryDecoded = false;
+
 	if(columnReader->dataPageNum != 0)
 	{
 		memset(columnReader->dataPages, 0, columnReader->dataPageNum
@@ -83,6 +83,11 @@ readColumnMetadata(
 		CompactProtocol *prot,
 		struct ColumnChunkMetadata_4C *colChunk);
 
+static int
+readStatistics(
+		CompactProtocol *prot,
+		struct ColumnChunkMetadata_4C *colChunk);
+
 static void
 assignRDFromFieldToColumnChunk(
 		struct ColumnChunkMetadata_4C* columns,
@@ -110,6 +115,11 @@ writeColumnChunk(
 		struct ColumnChunkMetadata_4C *columnInfo,
 		CompactProtocol *prot);
 
+static int
+writeStatistics(
+		struct ColumnChunkMetadata_4C *columnInfo,
+		CompactProtocol *prot);
+
 static int
 writeSchemaElement_Single(
 		CompactProtocol *prot,
@@ -627,7 +637,7 @@ readRowGroupInfo(
 		ereport(ERROR,
 				(errcode(ERRCODE_GP_INTERNAL_ERROR), errmsg("file metadata row group row count not set")));
 
-	/*assign r and d of fields to column chunks*/
+	/*assign r, d and hawq type of fields to column chunks*/
 	int columnIndex = 0;
 	assignRDFromFieldToColumnChunk(rowGroupInfo->columns, &columnIndex, pfields,
 			pfieldCount);
@@ -815,13 +825,14 @@ readColumnMetadata(
 			break;
 		case 11:
 			if (ftype == T_I64) {
-				xfer += skipType(prot, ftype);
+				/*read dictionary page offset*/
+				xfer += readI64(prot, &(colChunk->dictionaryPageOffset));
 			}
 			break;
 		case 12:
-			/* Skip this optional field now */
 			if (ftype == T_STRUCT) {
-				xfer += skipType(prot, ftype);
+				/*read column chunk statistics*/
+				xfer += readStatistics(prot, colChunk);
 			}
 			break;
 		case 13:
@@ -866,7 +877,89 @@ readColumnMetadata(
 }
 
 /**
- * Assign the r and d value of column chunks, from pfields to column chunks
+ * read column chunk statistics. Only fixed width min/max values are kept,
+ * the others are skipped. The min_value/max_value fields take precedence
+ * over the deprecated min/max fields since they come later in the struct.
+ */
+int
+readStatistics(
+		CompactProtocol *prot,
+		struct ColumnChunkMetadata_4C *colChunk)
+{
+	uint32_t xfer = 0;
+	TType ftype;
+	int16_t fid;
+	char *buf;
+	int32_t len;
+	int32_t minLen = 0;
+	int32_t maxLen = 0;
+
+	readStructBegin(prot);
+
+	while (true) {
+		xfer += readFieldBegin(prot, &ftype, &fid);
+		if (ftype == T_STOP) {
+			break;
+		}
+		switch (fid) {
+		case 1:
+		case 5:
+			/*max value*/
+			if (ftype == T_STRING) {
+				xfer += readBinary(prot, &buf, &len);
+				if (len == 4 || len == 8) {
+					memcpy(colChunk->maxValue, buf, len);
+					maxLen = len;
+				}
+				if (len > 0)
+					pfree(buf);
+			} else {
+				xfer += skipType(prot, ftype);
+			}
+			break;
+		case 2:
+		case 6:
+			/*min value*/
+			if (ftype == T_STRING) {
+				xfer += readBinary(prot, &buf, &len);
+				if (len == 4 || len == 8) {
+					memcpy(colChunk->minValue, buf, len);
+					minLen = len;
+				}
+				if (len > 0)
+					pfree(buf);
+			} else {
+				xfer += skipType(prot, ftype);
+			}
+			break;
+		case 3:
+			if (ftype == T_I64) {
+				xfer += readI64(prot, &(colChunk->nullCount));
+				colChunk->hasNullCount = true;
+			} else {
+				xfer += skipType(prot, ftype);
+			}
+			break;
+		default:
+			xfer += skipType(prot, ftype);
+			break;
+		}
+	}
+
+	readStructEnd(prot);
+
+	if (minLen != 0 && minLen == maxLen) {
+		colChunk->hasMinMax = true;
+		colChunk->minMaxLen = minLen;
+	}
+
+	return xfer;
+}
+
+/**
+ * Assign the r and d value and the hawq type of column chunks, from pfields
+ * to column chunks. The types are set on pfields by checkAndSyncMetadata, the
+ * row group statistics filters compare them against the scan keys.
  */
 void
 assignRDFromFieldToColumnChunk(
@@ -881,6 +974,7 @@ assignRDFromFieldToColumnChunk(
 		{
 			columns[*columnIndex].r = pfields[i].r;
 			columns[*columnIndex].d = pfields[i].d;
+			columns[*columnIndex].hawqTypeId = pfields[i].hawqTypeId;
 			(*columnIndex)++;
 		}
 		else
@@ -1094,7 +1188,17 @@ writeColumnMetadata(
 	xfer += writeFieldBegin(prot, T_I64, 9);
 	xfer += writeI64(prot, columnInfo->firstDataPage);
 
-	/*write out index page offset and dictionary page offset. No need to write currently*/
+	/*write out dictionary page offset. No need to write index page offset currently*/
+	if (columnInfo->dictionaryPageOffset > 0) {
+		xfer += writeFieldBegin(prot, T_I64, 11);
+		xfer += writeI64(prot, columnInfo->dictionaryPageOffset);
+	}
+
+	/*write out statistics*/
+	if (columnInfo->hasNullCount || columnInfo->hasMinMax) {
+		xfer += writeFieldBegin(prot, T_STRUCT, 12);
+		xfer += writeStatistics(columnInfo, prot);
+	}
 
 	/*write out field stop identifier*/
 	xfer += writeFieldStop(prot);
@@ -1103,6 +1207,45 @@ writeColumnMetadata(
 	return xfer;
 }
 
+/**
+ * write out column chunk statistics. min/max are written both as the
+ * deprecated min/max fields and as min_value/max_value, so that older
+ * readers can use them as well.
+ */
+int
+writeStatistics(
+		struct ColumnChunkMetadata_4C *columnInfo,
+		CompactProtocol *prot)
+{
+	uint32_t xfer = 0;
+
+	xfer += writeStructBegin(prot);
+
+	if (columnInfo->hasMinMax) {
+		xfer += writeFieldBegin(prot, T_STRING, 1);
+		xfer += writeBinary(prot, columnInfo->maxValue, columnInfo->minMaxLen);
+		xfer += writeFieldBegin(prot, T_STRING, 2);
+		xfer += writeBinary(prot, columnInfo->minValue, columnInfo->minMaxLen);
+	}
+
+	if (columnInfo->hasNullCount) {
+		xfer += writeFieldBegin(prot, T_I64, 3);
+		xfer += writeI64(prot, columnInfo->nullCount);
+	}
+
+	if (columnInfo->hasMinMax) {
+		xfer += writeFieldBegin(prot, T_STRING, 5);
+		xfer += writeBinary(prot, columnInfo->maxValue, columnInfo->minMaxLen);
+		xfer += writeFieldBegin(prot, T_STRING, 6);
+		xfer += writeBinary(prot, columnInfo->minValue, columnInfo->minMaxLen);
+	}
+
+	xfer += writeFieldStop(prot);
+	xfer += writeStructEnd(prot);
+
+	return xfer;
+}
+
 int
 writeColumnChunk(
 		struct ColumnChunkMetadata_4C *columnInfo,
@@ -79,7 +79,7 @@ void readStructBegin(CompactProtocol *prot) {
 	if (prot->lastFieldArrSize >= prot->lastFieldArrMaxSize) {
 		prot->lastFieldArrMaxSize *= 2;
 		prot->lastFieldArr = (int16_t*) repalloc(prot->lastFieldArr,
-				prot->lastFieldArrMaxSize);
+				sizeof(int16_t) * prot->lastFieldArrMaxSize);
 	}
 	prot->lastFieldArr[prot->lastFieldArrSize++] = prot->lastFieldID;
 	prot->lastFieldID = 0;
@@ -237,6 +237,16 @@ uint32_t readI64(CompactProtocol *prot, int64_t *i64) {
 }
 
 uint32_t readString(CompactProtocol *prot, char **str) {
+	int32_t len;
+
+	return readBinary(prot, str, &len);
+}
+
+/*
+ * Read a length-prefixed binary value. The returned buffer is null
+ * terminated, so readString can share this routine.
+ */
+uint32_t readBinary(CompactProtocol *prot, char **buf, int32_t *len) {
 	int32_t rsize = 0;
 	int32_t size = 0;
 	uint8_t *tmp = NULL;
@@ -248,7 +258,8 @@ uint32_t readString(CompactProtocol *prot, char **str) {
 	rsize += readVarint32(prot, &size);
 	/* Catch empty string case */
 	if (size == 0) {
-		*str = "";
+		*buf = "";
+		*len = 0;
 		return rsize;
 	}
 
@@ -260,21 +271,22 @@ uint32_t readString(CompactProtocol *prot, char **str) {
 	}
 
   sizeForRead = size;
-  (*str) = (char*)palloc0(size + 1);
+  (*buf) = (char*)palloc0(size + 1);
   Assert (prot->footerProcessor != NULL);
   bufCapacity = prot->footerProcessor->Capacity;
   /* Read from buffer to string, read length size */
   while (sizeForRead > bufCapacity) {
     bufRet = prepareFooterBufferForwardReading(prot->footerProcessor, bufCapacity, &tmp);
     Assert (bufRet == PARQUET_FOOTER_BUFFER_MOVE_OK);
-    memcpy(*str + strIdx, tmp, bufCapacity);
+    memcpy(*buf + strIdx, tmp, bufCapacity);
     sizeForRead -= bufCapacity;
     strIdx += bufCapacity;
     tmp = NULL;
   }
   bufRet = prepareFooterBufferForwardReading(prot->footerProcessor, sizeForRead, &tmp);
   Assert (bufRet == PARQUET_FOOTER_BUFFER_MOVE_OK);
-  memcpy(*str + strIdx, tmp, sizeForRead);
+  memcpy(*buf + strIdx, tmp, sizeForRead);
+  *len = size;
 
 	return rsize + (uint32_t) size;
 }
@@ -520,7 +532,7 @@ writeStructBegin(CompactProtocol *prot)
 	if (prot->lastFieldArrSize >= prot->lastFieldArrMaxSize) {
 		prot->lastFieldArrMaxSize *= 2;
 		prot->lastFieldArr = (int16_t*) repalloc(prot->lastFieldArr,
-                                                 prot->lastFieldArrMaxSize);
+                                                 sizeof(int16_t) * prot->lastFieldArrMaxSize);
 	}
 	prot->lastFieldArr[prot->lastFieldArrSize++] = prot->lastFieldID;
 	prot->lastFieldID = 0;
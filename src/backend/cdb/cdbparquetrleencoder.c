@@ -234,6 +234,7 @@ RLEDecoder_Init(RLEDecoder *decoder, int bitWidth, uint8_t *in, int inputSize)
 	decoder->input		= in;
 	decoder->inputPos	= 0;
 	decoder->inputSize	= inputSize;
+	decoder->valueCount	= 0;
 }
 
 int 
@@ -252,7 +253,17 @@ RLEDecoder_ReadInt(RLEDecoder *decoder)
 			result = decoder->rleValue;
 			break;
 		case MODE_BITPACK:
-			result = decoder->bitpackBuffer[decoder->bitpackBufferSize - decoder->valueCount];
+			if (decoder->bitpackBufferPos == 8)
+			{
+				unpack8Values(decoder->bitWidth,
+							  decoder->input,
+							  decoder->inputPos,
+							  decoder->bitpackBuffer,
+							  0);
+				decoder->inputPos += decoder->bitWidth;
+				decoder->bitpackBufferPos = 0;
+			}
+			result = decoder->bitpackBuffer[decoder->bitpackBufferPos++];
 			break;
 		default:
 			/* TODO raise error */
@@ -263,10 +274,77 @@ RLEDecoder_ReadInt(RLEDecoder *decoder)
 	return result;
 }
 
+/*
+ * Read `count` values into `values`, a whole run at a time.
+ */
+void
+RLEDecoder_ReadInts(RLEDecoder *decoder, int *values, int count)
+{
+	int n = 0;
+	int take;
+	int i;
+
+	while (n < count)
+	{
+		if (decoder->valueCount == 0)
+		{
+			if (decoder->inputPos >= decoder->inputSize)
+				ereport(ERROR,
+						(errcode(ERRCODE_DATA_CORRUPTED),
+						 errmsg("parquet rle data ends after %d of %d values", n, count)));
+
+			readNextRun(decoder);
+			continue;
+		}
+
+		take = Min(count - n, decoder->valueCount);
+
+		if (decoder->mode == MODE_RLE)
+		{
+			for (i = 0; i < take; i++)
+				values[n + i] = decoder->rleValue;
+		}
+		else
+		{
+			for (i = 0; i < take; )
+			{
+				if (decoder->bitpackBufferPos == 8 && take - i >= 8)
+				{
+					/* whole group wanted, unpack it in place */
+					unpack8Values(decoder->bitWidth,
+								  decoder->input,
+								  decoder->inputPos,
+								  values,
+								  n + i);
+					decoder->inputPos += decoder->bitWidth;
+					i += 8;
+					continue;
+				}
+
+				if (decoder->bitpackBufferPos == 8)
+				{
+					unpack8Values(decoder->bitWidth,
+								  decoder->input,
+								  decoder->inputPos,
+								  decoder->bitpackBuffer,
+								  0);
+					decoder->inputPos += decoder->bitWidth;
+					decoder->bitpackBufferPos = 0;
+				}
+				values[n + i] = decoder->bitpackBuffer[decoder->bitpackBufferPos++];
+				i++;
+			}
+		}
+
+		decoder->valueCount -= take;
+		n += take;
+	}
+}
+
 void 
 readNextRun(RLEDecoder *decoder)
 {
-	int i, header, num_groups;
+	int header, num_groups;
 
 	if (decoder->inputPos >= decoder->inputSize)
 	{
@@ -290,18 +368,13 @@ readNextRun(RLEDecoder *decoder)
 			 * which takes up `bitWidth` bytes when encoded
 			 */
 			num_groups = header >> 1;
+			if (num_groups * decoder->bitWidth > decoder->inputSize - decoder->inputPos)
+				ereport(ERROR,
+						(errcode(ERRCODE_DATA_CORRUPTED),
+						 errmsg("parquet bit-packed run of %d groups exceeds the encoded data",
+								num_groups)));
 			decoder->valueCount = num_groups * 8;
-			decoder->bitpackBufferSize = decoder->valueCount;
-
-			for (i = 0; i < decoder->valueCount; i += 8)
-			{
-				unpack8Values(decoder->bitWidth,
-							  decoder->input,
-							  decoder->inputPos,
-							  decoder->bitpackBuffer,
-							  i);
-				decoder->inputPos += decoder->bitWidth;
-			}
+			decoder->bitpackBufferPos = 8;
 			break;
 	}
 }
@@ -27,11 +27,32 @@
 #include "cdb/cdbparquetrowgroup.h"
 #include "cdb/cdbparquetfooterserializer.h"
 #include "utils/bloomfilter.h"
+#include "access/nbtree.h"
+#include "catalog/pg_am.h"
+#include "commands/defrem.h"
+#include "utils/date.h"
+#include "utils/datum.h"
+#include "utils/lsyscache.h"
+#include "utils/memutils.h"
+#include "utils/timestamp.h"
 
 static bool ParquetRowGroupReader_Select(FileSplit split,
                                          ParquetMetadata parquetMetadata,
                                          bool *rowGroupInfoProcessed);
 
+static bool ParquetRowGroupFilter_Skip(ParquetRowGroupFilter *filter,
+                                       struct BlockMetadata_4C *rowGroupMetadata,
+                                       int *hawqAttrToParquetColChunks);
+static bool ParquetRowGroupFilter_SkipByRuntimeFilter(RuntimeFilterState *rfState,
+                                                      struct BlockMetadata_4C *rowGroupMetadata,
+                                                      int *hawqAttrToParquetColChunks);
+static struct ColumnChunkMetadata_4C *ParquetRowGroupFilter_GetColumnChunk(
+		struct BlockMetadata_4C *rowGroupMetadata,
+		int *hawqAttrToParquetColChunks, int attno);
+
+static void ParquetRowGroupReader_ProbeRuntimeFilter(ParquetRowGroupReader *rowGroupReader,
+                                                     RuntimeFilterState *rfState);
+
 /*
  * Initialize the ExecutorReadGroup once.  Assumed to be zeroed out before the call.
  */
@@ -66,7 +87,8 @@ ParquetRowGroupReader_GetRowGroupInfo(
 	bool 					*projs,
 	TupleDesc 				hawqTupleDesc,
 	int 					*hawqAttrToParquetColChunks,
-	bool                    toCloseFile)
+	bool                    toCloseFile,
+	ParquetRowGroupFilter	*rowGroupFilter)
 {
 	ParquetMetadata parquetMetadata;
 	int rowGroupIndex;
@@ -94,7 +116,23 @@ ParquetRowGroupReader_GetRowGroupInfo(
 		storageRead->preRead = false;
 
 		if (ParquetRowGroupReader_Select(split, parquetMetadata, &rowGroupInfoProcessed))
-			break;
+		{
+			if (rowGroupFilter == NULL)
+				break;
+
+			/*
+			 * skip the row group without reading its column chunks if the
+			 * statistics show no row of it can satisfy the scan quals
+			 */
+			if (!ParquetRowGroupFilter_Skip(rowGroupFilter,
+											parquetMetadata->currentBlockMD,
+											hawqAttrToParquetColChunks))
+			{
+				rowGroupFilter->rowGroupsScanned++;
+				break;
+			}
+			rowGroupFilter->rowGroupsSkipped++;
+		}
 
 		/* done with current split and pre-read the next rowgroup info */
 		if (rowGroupInfoProcessed) {
@@ -197,129 +235,326 @@ ParquetRowGroupReader_GetContents(
 }
 
 /*
- * Get next tuple from current row group into slot.
+ * Read a value of a geometric type, which is stored in several parquet
+ * column chunks, one value per call.
+ */
+static void
+ParquetRowGroupReader_ReadGeoValue(
+	ParquetColumnReader		*columnReader,
+	int						hawqTypeID,
+	Datum					*value,
+	bool					*null)
+{
+	switch (hawqTypeID)
+	{
+		case HAWQ_TYPE_POINT:
+			ParquetColumnReader_readPoint(columnReader, value, null);
+			break;
+		case HAWQ_TYPE_PATH:
+			ParquetColumnReader_readPATH(columnReader, value, null);
+			break;
+		case HAWQ_TYPE_LSEG:
+			ParquetColumnReader_readLSEG(columnReader, value, null);
+			break;
+		case HAWQ_TYPE_BOX:
+			ParquetColumnReader_readBOX(columnReader, value, null);
+			break;
+		case HAWQ_TYPE_CIRCLE:
+			ParquetColumnReader_readCIRCLE(columnReader, value, null);
+			break;
+		case HAWQ_TYPE_POLYGON:
+			ParquetColumnReader_readPOLYGON(columnReader, value, null);
+			break;
+		default:
+			/* TODO array type */
+			/* TODO UDT */
+			Insist(false);
+			break;
+	}
+}
+
+/*
+ * Get next batch of at most maxRows rows from current row group into
+ * column arrays: values[i] and nulls[i] receive the rows of hawq attribute
+ * i, for projected attributes only.
  *
- * Return false if current row group has no tuple left, true otherwise.
+ * A whole data page of each column is decoded at once, and a batch never
+ * crosses a data page boundary of any column, as the decoded values of
+ * compressed column may point into its page buffer, which is reused by
+ * the next page. The values are valid until the next call.
+ *
+ * Return the number of rows read, 0 if current row group has no row left.
  */
-bool
-ParquetRowGroupReader_ScanNextTuple(
+int
+ParquetRowGroupReader_ScanNextBatch(
 	TupleDesc 				tupDesc,
 	ParquetRowGroupReader	*rowGroupReader,
 	int						*hawqAttrToParquetColNum,
 	bool 					*projs,
-	RuntimeFilterState		*rfState,
-	TupleTableSlot 			*slot)
+	int						natts,
+	int						maxRows,
+	Datum					**values,
+	bool					**nulls)
 {
-	Assert(slot);
-	while (rowGroupReader->rowRead < rowGroupReader->rowCount)
-	{
+	int nrows;
+	int colReaderIndex;
 
-		/*
-		 * get the next item (tuple) from the row group
-		 */
-		rowGroupReader->rowRead++;
+	Assert(natts <= tupDesc->natts);
 
-		int natts = slot->tts_tupleDescriptor->natts;
-		Assert(natts <= tupDesc->natts);
+	/* the values of the previous batch are not used any more */
+	if (rowGroupReader->batchContext != NULL)
+		MemoryContextReset(rowGroupReader->batchContext);
 
-		Datum *values = slot_get_values(slot);
-		bool *nulls = slot_get_isnull(slot);
+	if (rowGroupReader->rowRead >= rowGroupReader->rowCount)
+	{
+		ParquetRowGroupReader_FinishedScanRowGroup(rowGroupReader);
+		return 0;
+	}
 
-		int colReaderIndex = 0;
-		for (int i = 0; i < natts; i++)
+	nrows = Min(maxRows, rowGroupReader->rowCount - rowGroupReader->rowRead);
+
+	/* stop at the nearest page end of all the columns */
+	colReaderIndex = 0;
+	for (int i = 0; i < natts; i++)
+	{
+		if (projs[i] == false)
+			continue;
+
+		if (hawqAttrToParquetColNum[i] == 1)
 		{
-			if (projs[i] == false)
+			ParquetColumnReader *reader =
+					&rowGroupReader->columnReaders[colReaderIndex];
+			int remained = ParquetColumnReader_prepareValues(reader,
+					tupDesc->attrs[i]->atttypid);
+
+			if (remained == 0)
 			{
-				nulls[i] = true;
-				continue;
+				ereport(ERROR,
+						(errcode(ERRCODE_DATA_CORRUPTED),
+						 errmsg("column %s has fewer values than the %d rows of row group in file %s",
+								reader->columnMetadata->colName,
+								rowGroupReader->rowCount,
+								rowGroupReader->storageRead->segmentFileName)));
 			}
-			ParquetColumnReader *nextReader =
-					&rowGroupReader->columnReaders[colReaderIndex];
-			int hawqTypeID = tupDesc->attrs[i]->atttypid;
+			nrows = Min(nrows, remained);
+		}
+
+		colReaderIndex += hawqAttrToParquetColNum[i];
+	}
 
-			if (hawqAttrToParquetColNum[i] == 1)
+	colReaderIndex = 0;
+	for (int i = 0; i < natts; i++)
+	{
+		if (projs[i] == false)
+			continue;
+
+		ParquetColumnReader *nextReader =
+				&rowGroupReader->columnReaders[colReaderIndex];
+		int hawqTypeID = tupDesc->attrs[i]->atttypid;
+
+		if (hawqAttrToParquetColNum[i] == 1)
+		{
+			ParquetColumnReader_readValues(nextReader, values[i], nulls[i], nrows);
+		}
+		else
+		{
+			/*
+			 * Because there are some memory reused inside the whole column reader, so need
+			 * to switch the context from PerTupleContext to rowgroup->context
+			 */
+			MemoryContext oldContext = MemoryContextSwitchTo(
+					rowGroupReader->memoryContext);
+			Form_pg_attribute attr = tupDesc->attrs[i];
+
+			if (rowGroupReader->batchContext == NULL)
 			{
-				ParquetColumnReader_readValue(nextReader, &values[i], &nulls[i],
-						hawqTypeID);
+				rowGroupReader->batchContext = AllocSetContextCreate(
+						rowGroupReader->memoryContext,
+						"ParquetScanBatch",
+						ALLOCSET_DEFAULT_MINSIZE,
+						ALLOCSET_DEFAULT_INITSIZE,
+						ALLOCSET_DEFAULT_MAXSIZE);
 			}
-			else
+
+			for (int j = 0; j < nrows; j++)
 			{
+				ParquetRowGroupReader_ReadGeoValue(nextReader, hawqTypeID,
+						&values[i][j], &nulls[i][j]);
+
 				/*
-				 * Because there are some memory reused inside the whole column reader, so need
-				 * to switch the context from PerTupleContext to rowgroup->context
+				 * The geometric value is decoded into the buffer of the column
+				 * reader, which the next value overwrites, copy it out.
 				 */
-				MemoryContext oldContext = MemoryContextSwitchTo(
-						rowGroupReader->memoryContext);
-
-				switch (hawqTypeID) {
-				case HAWQ_TYPE_POINT:
-					ParquetColumnReader_readPoint(nextReader, &values[i], &nulls[i]);
-					break;
-				case HAWQ_TYPE_PATH:
-					ParquetColumnReader_readPATH(nextReader, &values[i], &nulls[i]);
-					break;
-				case HAWQ_TYPE_LSEG:
-					ParquetColumnReader_readLSEG(nextReader, &values[i], &nulls[i]);
-					break;
-				case HAWQ_TYPE_BOX:
-					ParquetColumnReader_readBOX(nextReader, &values[i], &nulls[i]);
-					break;
-				case HAWQ_TYPE_CIRCLE:
-					ParquetColumnReader_readCIRCLE(nextReader, &values[i], &nulls[i]);
-					break;
-				case HAWQ_TYPE_POLYGON:
-					ParquetColumnReader_readPOLYGON(nextReader, &values[i], &nulls[i]);
-					break;
-				default:
-					/* TODO array type */
-					/* TODO UDT */
-					Insist(false);
-					break;
+				if (!nulls[i][j])
+				{
+					MemoryContextSwitchTo(rowGroupReader->batchContext);
+					values[i][j] = datumCopy(values[i][j], attr->attbyval,
+							attr->attlen);
+					MemoryContextSwitchTo(rowGroupReader->memoryContext);
 				}
+			}
+
+			MemoryContextSwitchTo(oldContext);
+		}
+
+		colReaderIndex += hawqAttrToParquetColNum[i];
+	}
+
+	rowGroupReader->rowRead += nrows;
+	return nrows;
+}
+
+/*
+ * Test the join keys of all the rows of the current batch against the Bloom
+ * filter of the runtime filter at once. Rows with a NULL join key are kept,
+ * the join drops them anyway.
+ */
+static void
+ParquetRowGroupReader_ProbeRuntimeFilter(
+	ParquetRowGroupReader	*rowGroupReader,
+	RuntimeFilterState		*rfState)
+{
+	int			rows = rowGroupReader->batchRows;
+	uint32	   *hashes = rowGroupReader->batchHashes;
+	bool	   *pass = rowGroupReader->batchPass;
+	ListCell   *hk;
+	int			i = 0;
+
+	Assert(rfState->bloomfilter != NULL);
+
+	memset(hashes, 0, rows * sizeof(uint32));
+	memset(pass, false, rows * sizeof(bool));
+	foreach(hk, rfState->joinkeys)
+	{
+		AttrNumber	attrno = (AttrNumber) lfirst(hk);
+		Datum	   *keyvals = rowGroupReader->batchValues[attrno - 1];
+		bool	   *keynulls = rowGroupReader->batchNulls[attrno - 1];
 
-				MemoryContextSwitchTo(oldContext);
+		for (int row = 0; row < rows; row++)
+		{
+			/* rotate hashkey left 1 bit at each step */
+			uint32		hashkey = (hashes[row] << 1) | ((hashes[row] & 0x80000000) ? 1 : 0);
+
+			if (keyvals == NULL || keynulls[row])
+			{
+				pass[row] = true;
+				continue;
 			}
+			hashes[row] = hashkey ^ DatumGetUInt32(
+					FunctionCall1(&rfState->hashfunctions[i], keyvals[row]));
+		}
+		i++;
+	}
+
+	/* pass holds the rows with NULL keys, found the ones the filter may match */
+	bool	   *found = (bool *) palloc(rows * sizeof(bool));
+	FindBloomFilterBatch(rfState->bloomfilter, hashes, rows, found);
+	for (int row = 0; row < rows; row++)
+		pass[row] = pass[row] || found[row];
+	pfree(found);
+
+	rowGroupReader->batchFiltered = true;
+}
+
+/*
+ * Get next tuple from current row group into slot. Rows are decoded in
+ * batches by ParquetRowGroupReader_ScanNextBatch() and returned one by one.
+ * With a runtime filter, the rows of a batch are tested all at once.
+ *
+ * Return false if current row group has no tuple left, true otherwise.
+ */
+bool
+ParquetRowGroupReader_ScanNextTuple(
+	TupleDesc 				tupDesc,
+	ParquetRowGroupReader	*rowGroupReader,
+	int						*hawqAttrToParquetColNum,
+	bool 					*projs,
+	RuntimeFilterState		*rfState,
+	TupleTableSlot 			*slot)
+{
+	Assert(slot);
 
-			colReaderIndex += hawqAttrToParquetColNum[i];
+	int natts = slot->tts_tupleDescriptor->natts;
+	Assert(natts <= tupDesc->natts);
+
+	if (rowGroupReader->batchValues == NULL)
+	{
+		MemoryContext oldContext = MemoryContextSwitchTo(
+				rowGroupReader->memoryContext);
+
+		/* sized by tupDesc, so that parquet_endscan() knows the length */
+		rowGroupReader->batchValues = (Datum **) palloc0(tupDesc->natts * sizeof(Datum *));
+		rowGroupReader->batchNulls = (bool **) palloc0(tupDesc->natts * sizeof(bool *));
+		for (int i = 0; i < natts; i++)
+		{
+			if (projs[i] == false)
+				continue;
+			rowGroupReader->batchValues[i] =
+					(Datum *) palloc(PARQUET_SCAN_BATCH_SIZE * sizeof(Datum));
+			rowGroupReader->batchNulls[i] =
+					(bool *) palloc(PARQUET_SCAN_BATCH_SIZE * sizeof(bool));
 		}
 
-		if (rfState != NULL && rfState->hasRuntimeFilter
-				&& !rfState->stopRuntimeFilter)
+		MemoryContextSwitchTo(oldContext);
+	}
+
+	for (;;)
+	{
+		if (rowGroupReader->batchRowIndex >= rowGroupReader->batchRows)
 		{
-			Assert(rfState->bloomfilter != NULL);
-			uint32_t hashkey = 0;
-			ListCell *hk;
-			int i = 0;
-			foreach(hk, rfState->joinkeys)
+			rowGroupReader->batchRows = ParquetRowGroupReader_ScanNextBatch(
+					tupDesc, rowGroupReader, hawqAttrToParquetColNum, projs,
+					natts, PARQUET_SCAN_BATCH_SIZE,
+					rowGroupReader->batchValues, rowGroupReader->batchNulls);
+			rowGroupReader->batchRowIndex = 0;
+			rowGroupReader->batchFiltered = false;
+
+			if (rowGroupReader->batchRows == 0)
+				return false;
+
+			if (rfState != NULL && rfState->hasRuntimeFilter
+					&& !rfState->stopRuntimeFilter)
 			{
-				AttrNumber attrno = (AttrNumber) lfirst(hk);
-				Datum keyval;
-				uint32 hkey;
-
-				/* rotate hashkey left 1 bit at each step */
-				hashkey = (hashkey << 1) | ((hashkey & 0x80000000) ? 1 : 0);
-				keyval = values[attrno - 1];
-
-				/* Evaluate expression */
-				hkey = DatumGetUInt32(
-						FunctionCall1(&rfState->hashfunctions[i], keyval));
-				hashkey ^= hkey;
-				i++;
+				if (rowGroupReader->batchPass == NULL)
+				{
+					MemoryContext oldContext = MemoryContextSwitchTo(
+							rowGroupReader->memoryContext);
+					rowGroupReader->batchPass =
+							(bool *) palloc(PARQUET_SCAN_BATCH_SIZE * sizeof(bool));
+					rowGroupReader->batchHashes =
+							(uint32 *) palloc(PARQUET_SCAN_BATCH_SIZE * sizeof(uint32));
+					MemoryContextSwitchTo(oldContext);
+				}
+				ParquetRowGroupReader_ProbeRuntimeFilter(rowGroupReader, rfState);
 			}
+		}
+
+		/*
+		 * get the next item (tuple) from the batch
+		 */
+		int row = rowGroupReader->batchRowIndex++;
+
+		if (rowGroupReader->batchFiltered && !rowGroupReader->batchPass[row])
+			continue;
+
+		Datum *values = slot_get_values(slot);
+		bool *nulls = slot_get_isnull(slot);
 
-			if (!FindBloomFilter(rfState->bloomfilter, hashkey))
+		for (int i = 0; i < natts; i++)
+		{
+			if (projs[i] == false)
 			{
+				nulls[i] = true;
 				continue;
 			}
+			values[i] = rowGroupReader->batchValues[i][row];
+			nulls[i] = rowGroupReader->batchNulls[i][row];
 		}
 
 		/*construct tuple, and return back*/
 		TupSetVirtualTupleNValid(slot, natts);
 		return true;
 	}
-
-	ParquetRowGroupReader_FinishedScanRowGroup(rowGroupReader);
-	return false;
 }
 
 /**
@@ -332,6 +567,9 @@ ParquetRowGroupReader_FinishedScanRowGroup(
 	/*reset rowCount and rowRead*/
 	rowGroupReader->rowCount = 0;
 	rowGroupReader->rowRead = 0;
+	rowGroupReader->batchRows = 0;
+	rowGroupReader->batchRowIndex = 0;
+	rowGroupReader->batchFiltered = false;
 
 	/*memset columnreader content to zero for later use*/
 	for(int i = 0; i < rowGroupReader->columnReaderCount; i++){
@@ -350,6 +588,11 @@ static bool ParquetRowGroupReader_Select(FileSplit split,
   int64 splitEnd = splitStart + split->lengths;
   int64 rowGroupStart = rowGroupMetadata->columns[0].firstDataPage;
 
+  /* the first column chunk starts with its dictionary page, if any */
+  if (rowGroupMetadata->columns[0].dictionaryPageOffset > 0 &&
+      rowGroupMetadata->columns[0].dictionaryPageOffset < rowGroupStart)
+    rowGroupStart = rowGroupMetadata->columns[0].dictionaryPageOffset;
+
   elog(DEBUG1, "parquetSplitSegNo/EOF: %d/"INT64_FORMAT"", split->segno, split->logiceof);
   elog(DEBUG1, "parquetSplitStart: "INT64_FORMAT"", splitStart);
   elog(DEBUG1, "parquetSplitEnd: "INT64_FORMAT"", splitEnd);
@@ -365,3 +608,405 @@ static bool ParquetRowGroupReader_Select(FileSplit split,
 
   return false;
 }
+
+/*
+ * Build a row group filter from the scan quals. Only top level quals of the
+ * form "column op constant" with a btree operator, and null tests on
+ * columns are used. Return NULL if there is no such qual.
+ */
+ParquetRowGroupFilter *
+ParquetRowGroupFilter_Create(
+	List			*quals,
+	TupleDesc		hawqTupleDesc)
+{
+	ParquetRowGroupFilter *filter;
+	ListCell	*lc;
+	int			nkeys = 0;
+
+	if (quals == NIL)
+		return NULL;
+
+	filter = (ParquetRowGroupFilter *) palloc0(sizeof(ParquetRowGroupFilter));
+	filter->keys = (ParquetRowGroupFilterKey *)
+			palloc0(list_length(quals) * sizeof(ParquetRowGroupFilterKey));
+
+	foreach(lc, quals)
+	{
+		Expr	   *qual = (Expr *) lfirst(lc);
+		ParquetRowGroupFilterKey *key = &filter->keys[nkeys];
+		Var		   *var;
+
+		if (IsA(qual, NullTest))
+		{
+			NullTest   *ntest = (NullTest *) qual;
+
+			var = (Var *) ntest->arg;
+			if (var == NULL || !IsA(var, Var) ||
+				var->varattno <= 0 || var->varattno > hawqTupleDesc->natts)
+				continue;
+
+			key->attno = var->varattno - 1;
+			key->typeId = var->vartype;
+			key->isNullTest = true;
+			key->nullTestType = ntest->nulltesttype;
+			nkeys++;
+		}
+		else if (IsA(qual, OpExpr) && list_length(((OpExpr *) qual)->args) == 2)
+		{
+			OpExpr	   *opexpr = (OpExpr *) qual;
+			Expr	   *leftop = (Expr *) linitial(opexpr->args);
+			Expr	   *rightop = (Expr *) lsecond(opexpr->args);
+			Const	   *cnst;
+			Oid			opno = opexpr->opno;
+			Oid			opclass;
+			Oid			subtype;
+			Oid			cmpfunc;
+			int			strategy;
+			bool		recheck;
+
+			if (leftop && IsA(leftop, RelabelType))
+				leftop = ((RelabelType *) leftop)->arg;
+			if (rightop && IsA(rightop, RelabelType))
+				rightop = ((RelabelType *) rightop)->arg;
+
+			if (leftop && IsA(leftop, Var) && rightop && IsA(rightop, Const))
+			{
+				var = (Var *) leftop;
+				cnst = (Const *) rightop;
+			}
+			else if (leftop && IsA(leftop, Const) && rightop && IsA(rightop, Var))
+			{
+				/* constant on the left, use the commutator */
+				var = (Var *) rightop;
+				cnst = (Const *) leftop;
+				opno = get_commutator(opno);
+				if (!OidIsValid(opno))
+					continue;
+			}
+			else
+				continue;
+
+			if (cnst->constisnull ||
+				var->varattno <= 0 || var->varattno > hawqTupleDesc->natts)
+				continue;
+
+			opclass = GetDefaultOpClass(var->vartype, BTREE_AM_OID);
+			if (!OidIsValid(opclass) || !op_in_opclass(opno, opclass))
+				continue;
+
+			get_op_opclass_properties(opno, opclass, &strategy, &subtype, &recheck);
+			if (recheck || strategy < BTLessStrategyNumber ||
+				strategy > BTGreaterStrategyNumber)
+				continue;
+
+			cmpfunc = get_opclass_proc(opclass, subtype, BTORDER_PROC);
+			if (!OidIsValid(cmpfunc))
+				continue;
+
+			key->attno = var->varattno - 1;
+			key->typeId = var->vartype;
+			key->isNullTest = false;
+			key->strategy = strategy;
+			key->value = cnst->constvalue;
+			fmgr_info(cmpfunc, &key->cmpProc);
+			nkeys++;
+		}
+	}
+
+	if (nkeys == 0)
+	{
+		pfree(filter->keys);
+		pfree(filter);
+		return NULL;
+	}
+
+	filter->nkeys = nkeys;
+	return filter;
+}
+
+/*
+ * Attach the runtime filter of a hash join to the row group filter, creating
+ * the row group filter if there is none. The row groups read from now on are
+ * also checked against the value ranges of the join keys.
+ */
+ParquetRowGroupFilter *
+ParquetRowGroupFilter_AddRuntimeFilter(
+	ParquetRowGroupFilter	*filter,
+	RuntimeFilterState		*rfState)
+{
+	if (rfState == NULL || !rfState->hasRuntimeFilter ||
+		rfState->keyranges == NULL)
+		return filter;
+
+	if (filter == NULL)
+		filter = (ParquetRowGroupFilter *) palloc0(sizeof(ParquetRowGroupFilter));
+	filter->rfState = rfState;
+	return filter;
+}
+
+/*
+ * Convert plain encoded min/max statistics value to datum. Return false if
+ * the type has no usable statistics.
+ */
+static bool
+ParquetRowGroupFilter_GetStatDatum(
+	struct ColumnChunkMetadata_4C	*chunkmd,
+	uint8_t							*buf,
+	Datum							*value)
+{
+	switch (chunkmd->hawqTypeId)
+	{
+	case HAWQ_TYPE_INT2:
+	case HAWQ_TYPE_INT4:
+	case HAWQ_TYPE_DATE:
+	{
+		int32 val;
+		if (chunkmd->minMaxLen != sizeof(int32))
+			return false;
+		memcpy(&val, buf, sizeof(int32));
+		if (chunkmd->hawqTypeId == HAWQ_TYPE_INT2)
+			*value = Int16GetDatum((int16) val);
+		else
+			*value = Int32GetDatum(val);
+		return true;
+	}
+	case HAWQ_TYPE_FLOAT4:
+	{
+		float4 val;
+		if (chunkmd->minMaxLen != sizeof(float4))
+			return false;
+		memcpy(&val, buf, sizeof(float4));
+		*value = Float4GetDatum(val);
+		return true;
+	}
+	case HAWQ_TYPE_INT8:
+	{
+		int64 val;
+		if (chunkmd->minMaxLen != sizeof(int64))
+			return false;
+		memcpy(&val, buf, sizeof(int64));
+		*value = Int64GetDatum(val);
+		return true;
+	}
+	case HAWQ_TYPE_TIME:
+	{
+		TimeADT val;
+		if (chunkmd->minMaxLen != sizeof(TimeADT))
+			return false;
+		memcpy(&val, buf, sizeof(TimeADT));
+		*value = TimeADTGetDatum(val);
+		return true;
+	}
+	case HAWQ_TYPE_TIMESTAMP:
+	case HAWQ_TYPE_TIMESTAMPTZ:
+	{
+		Timestamp val;
+		if (chunkmd->minMaxLen != sizeof(Timestamp))
+			return false;
+		memcpy(&val, buf, sizeof(Timestamp));
+		*value = TimestampGetDatum(val);
+		return true;
+	}
+	case HAWQ_TYPE_FLOAT8:
+	{
+		float8 val;
+		if (chunkmd->minMaxLen != sizeof(float8))
+			return false;
+		memcpy(&val, buf, sizeof(float8));
+		*value = Float8GetDatum(val);
+		return true;
+	}
+	default:
+		return false;
+	}
+}
+
+/*
+ * Get the metadata of the column chunk of the zero based hawq attribute, or
+ * NULL if the attribute is stored in several column chunks.
+ */
+static struct ColumnChunkMetadata_4C *
+ParquetRowGroupFilter_GetColumnChunk(
+	struct BlockMetadata_4C		*rowGroupMetadata,
+	int							*hawqAttrToParquetColChunks,
+	int							attno)
+{
+	int			colIndex = 0;
+
+	/* only columns stored in a single column chunk have statistics */
+	if (hawqAttrToParquetColChunks[attno] != 1)
+		return NULL;
+
+	for (int i = 0; i < attno; i++)
+		colIndex += hawqAttrToParquetColChunks[i];
+	Assert(colIndex < rowGroupMetadata->ColChunkCount);
+	return &rowGroupMetadata->columns[colIndex];
+}
+
+/*
+ * Check the statistics of the join key columns in the row group against the
+ * value ranges of the inner join keys. Return true if no row of the row group
+ * can find a match on the inner side.
+ */
+static bool
+ParquetRowGroupFilter_SkipByRuntimeFilter(
+	RuntimeFilterState			*rfState,
+	struct BlockMetadata_4C		*rowGroupMetadata,
+	int							*hawqAttrToParquetColChunks)
+{
+	ListCell   *lc;
+	int			k = 0;
+
+	foreach(lc, rfState->joinkeys)
+	{
+		RuntimeFilterKeyRange *range = &rfState->keyranges[k++];
+		int			attno = lfirst_int(lc) - 1;
+		struct ColumnChunkMetadata_4C *chunkmd;
+		Datum		minValue;
+		Datum		maxValue;
+		int			lo;
+		int			hi;
+
+		if (!range->valid)
+			continue;
+
+		/* no inner row has a non-null key, nothing can join */
+		if (!range->hasValue)
+			return true;
+
+		chunkmd = ParquetRowGroupFilter_GetColumnChunk(rowGroupMetadata,
+													   hawqAttrToParquetColChunks,
+													   attno);
+		if (chunkmd == NULL)
+			continue;
+
+		/* hash join operators are strict, null keys never match */
+		if (chunkmd->hasNullCount &&
+			chunkmd->nullCount == rowGroupMetadata->rowCount)
+			return true;
+
+		if (!chunkmd->hasMinMax ||
+			chunkmd->hawqTypeId != range->typeId ||
+			!ParquetRowGroupFilter_GetStatDatum(chunkmd, chunkmd->minValue, &minValue) ||
+			!ParquetRowGroupFilter_GetStatDatum(chunkmd, chunkmd->maxValue, &maxValue))
+			continue;
+
+		if (DatumGetInt32(FunctionCall2(&range->cmpProc, maxValue, range->minValue)) < 0 ||
+			DatumGetInt32(FunctionCall2(&range->cmpProc, minValue, range->maxValue)) > 0)
+			return true;
+
+		if (range->nvalues <= 0)
+			continue;
+
+		/* find the first inner value not less than the min of the row group */
+		lo = 0;
+		hi = range->nvalues;
+		while (lo < hi)
+		{
+			int			mid = (lo + hi) / 2;
+
+			if (DatumGetInt32(FunctionCall2(&range->cmpProc,
+											range->values[mid], minValue)) < 0)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+		if (lo == range->nvalues ||
+			DatumGetInt32(FunctionCall2(&range->cmpProc,
+										range->values[lo], maxValue)) > 0)
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * Check the statistics of the column chunks in the row group against the
+ * filter keys. Return true if no row of the row group can satisfy all
+ * the keys, so the row group can be skipped.
+ */
+static bool
+ParquetRowGroupFilter_Skip(
+	ParquetRowGroupFilter		*filter,
+	struct BlockMetadata_4C		*rowGroupMetadata,
+	int							*hawqAttrToParquetColChunks)
+{
+	for (int k = 0; k < filter->nkeys; k++)
+	{
+		ParquetRowGroupFilterKey *key = &filter->keys[k];
+		struct ColumnChunkMetadata_4C *chunkmd;
+		Datum		minValue;
+		Datum		maxValue;
+		int32		cmp;
+
+		chunkmd = ParquetRowGroupFilter_GetColumnChunk(rowGroupMetadata,
+													   hawqAttrToParquetColChunks,
+													   key->attno);
+		if (chunkmd == NULL)
+			continue;
+
+		if (key->isNullTest)
+		{
+			if (!chunkmd->hasNullCount)
+				continue;
+			if (key->nullTestType == IS_NULL && chunkmd->nullCount == 0)
+				return true;
+			if (key->nullTestType == IS_NOT_NULL &&
+				chunkmd->nullCount == rowGroupMetadata->rowCount)
+				return true;
+			continue;
+		}
+
+		/* strict operators never match null values */
+		if (chunkmd->hasNullCount &&
+			chunkmd->nullCount == rowGroupMetadata->rowCount)
+			return true;
+
+		if (!chunkmd->hasMinMax ||
+			chunkmd->hawqTypeId != key->typeId ||
+			!ParquetRowGroupFilter_GetStatDatum(chunkmd, chunkmd->minValue, &minValue) ||
+			!ParquetRowGroupFilter_GetStatDatum(chunkmd, chunkmd->maxValue, &maxValue))
+			continue;
+
+		switch (key->strategy)
+		{
+		case BTLessStrategyNumber:
+			cmp = DatumGetInt32(FunctionCall2(&key->cmpProc, minValue, key->value));
+			if (cmp >= 0)
+				return true;
+			break;
+		case BTLessEqualStrategyNumber:
+			cmp = DatumGetInt32(FunctionCall2(&key->cmpProc, minValue, key->value));
+			if (cmp > 0)
+				return true;
+			break;
+		case BTEqualStrategyNumber:
+			cmp = DatumGetInt32(FunctionCall2(&key->cmpProc, minValue, key->value));
+			if (cmp > 0)
+				return true;
+			cmp = DatumGetInt32(FunctionCall2(&key->cmpProc, maxValue, key->value));
+			if (cmp < 0)
+				return true;
+			break;
+		case BTGreaterEqualStrategyNumber:
+			cmp = DatumGetInt32(FunctionCall2(&key->cmpProc, maxValue, key->value));
+			if (cmp < 0)
+				return true;
+			break;
+		case BTGreaterStrategyNumber:
+			cmp = DatumGetInt32(FunctionCall2(&key->cmpProc, maxValue, key->value));
+			if (cmp <= 0)
+				return true;
+			break;
+		default:
+			break;
+		}
+	}
+
+	if (filter->rfState != NULL)
+		return ParquetRowGroupFilter_SkipByRuntimeFilter(filter->rfState,
+														 rowGroupMetadata,
+														 hawqAttrToParquetColChunks);
+
+	return false;
+}
@@ -27,6 +27,7 @@
 
 #include "postgres.h"
 
+#include "access/hash.h"
 #include "catalog/catquery.h"
 #include "cdb/cdbparquetstoragewrite.h"
 #include "cdb/cdbparquetfooterserializer.h"
@@ -37,6 +38,7 @@
 #include "utils/numeric.h"
 #include "utils/xml.h"
 #include "utils/inet.h"
+#include "utils/guc.h"
 
 #include "snappy-c.h"
 #include "zlib.h"
@@ -51,9 +53,36 @@ static int encodeCurrentPage(
 static int finalizeCurrentAndNewPage(
 		ParquetColumnChunk columnChunk);
 
-static void flushDataPage(
+static void compressAndFinalizePage(
 		ParquetColumnChunk chunk,
-		int page_number);
+		ParquetDataPage page,
+		StringInfo buf);
+
+static ParquetDataPage encodeDictionaryPage(
+		ParquetColumnChunk chunk);
+
+static RLEEncoder *encodeDictionaryIndices(
+		ParquetColumnChunk chunk,
+		ParquetDataPage page);
+
+static void flushPage(
+		ParquetDataPage page);
+
+static ParquetDictionary createDictionary(void);
+
+static void freeDictionary(
+		ParquetDictionary dict);
+
+static int insertDictionaryEntry(
+		ParquetDictionary dict,
+		uint8_t *value,
+		int len,
+		int sizeLimit);
+
+static void appendDictionaryIndex(
+		ParquetColumnChunk chunk,
+		uint8_t *value,
+		int len);
 
 static void initGroupType(
 		FileField_4C *field,
@@ -121,6 +150,10 @@ static int appendValueForFields(
 static int appendParquetColumnNull(
 		ParquetColumnChunk columnChunk);
 
+static void updateColumnChunkMinMax(
+		ParquetColumnChunk chunk,
+		Datum value);
+
 static int appendParquetColumnValue(
 		ParquetColumnChunk columnChunk,
 		Datum value,
@@ -924,8 +957,9 @@ flushRowGroup(ParquetRowGroup rowgroup,
 	/*
 	 * Write out column chunks one by one. For each chunk, we do the following:
 	 * 1. encode the last page.
-	 * 2. write out pages one by one.
-	 * 3. write out chunk's metadata after the last page.
+	 * 2. write out the dictionary page if any data page uses it.
+	 * 3. write out pages one by one.
+	 * 4. write out chunk's metadata after the last page.
 	 */
 	for (int i = 0; i < rowgroup->columnChunkNumber; i++)
 	{
@@ -944,6 +978,31 @@ flushRowGroup(ParquetRowGroup rowgroup,
 		}
 		parquetmd->estimateChunkSizes[i] = (int) (parquetmd->estimateChunkSizes[i] * 1.05);
 
+		/*----------------------------------------------------------------
+		 * write out dictionary page ahead of the data pages
+		 *----------------------------------------------------------------*/
+		if (chunk->dictionaryPageCount > 0)
+		{
+			ParquetDataPage dictionaryPage = encodeDictionaryPage(chunk);
+
+			bytes_added += dictionaryPage->header->uncompressed_page_size;
+
+			chunkmd->dictionaryPageOffset = FileNonVirtualTell(rowgroup->parquetFile);
+			if (chunkmd->dictionaryPageOffset < 0)
+			{
+				ereport(ERROR,
+						(errcode_for_file_access(),
+						 errmsg("file tell position error for segment file: %s", strerror(errno)),
+						 errdetail("%s", HdfsGetLastError())));
+			}
+			flushPage(dictionaryPage);
+			pfree(dictionaryPage);
+
+			chunkmd->pEncodings = repalloc(chunkmd->pEncodings,
+										   (chunkmd->EncodingCount + 1) * sizeof(enum Encoding));
+			chunkmd->pEncodings[chunkmd->EncodingCount++] = PLAIN_DICTIONARY;
+		}
+
 		/*----------------------------------------------------------------
 		 * write out pages one by one
 		 *----------------------------------------------------------------*/
@@ -957,7 +1016,7 @@ flushRowGroup(ParquetRowGroup rowgroup,
 		}
 		for (int pageno = 0; pageno < chunk->pageNumber; ++pageno)
 		{
-			flushDataPage(chunk, pageno);
+			flushPage(&chunk->pages[pageno]);
 		}
 
 		/*----------------------------------------------------------------
@@ -1023,6 +1082,11 @@ freeRowGroup(ParquetRowGroup rowgroup)
 	{
 		pfree(rowgroup->columnChunks[i].pages);
 
+		if (rowgroup->columnChunks[i].dictionary != NULL)
+		{
+			freeDictionary(rowgroup->columnChunks[i].dictionary);
+		}
+
 		/* chunk metadata should be kept util parquet_insert_finish */
 		rowgroup->columnChunks[i].columnChunkMetadata = NULL;
 	}
@@ -1073,9 +1137,14 @@ addSingleColumn(AppendOnlyEntry *catalog,
 		chunkmd->pEncodings[2] 			= PLAIN; /*set data encoding as PLAIN*/
 		chunkmd->file_offset 			= 0;
 		chunkmd->firstDataPage 			= 0;
+		chunkmd->dictionaryPageOffset	= 0;
 		chunkmd->totalSize 				= 0;
 		chunkmd->totalUncompressedSize 	= 0;
 		chunkmd->valueCount 			= 0;
+		chunkmd->hasNullCount			= true;
+		chunkmd->nullCount				= 0;
+		chunkmd->hasMinMax				= false;
+		chunkmd->minMaxLen				= 0;
 
 		if (catalog->compresstype == NULL)
 		{
@@ -1129,17 +1198,39 @@ addSingleColumn(AppendOnlyEntry *catalog,
 		chunk->compresslevel				= catalog->compresslevel;
 		chunk->parquetFile					= parquetFile;
 
+		switch (chunkmd->hawqTypeId)
+		{
+		case HAWQ_TYPE_INT2:
+		case HAWQ_TYPE_INT4:
+		case HAWQ_TYPE_DATE:
+		case HAWQ_TYPE_FLOAT4:
+		case HAWQ_TYPE_INT8:
+		case HAWQ_TYPE_TIME:
+		case HAWQ_TYPE_TIMESTAMP:
+		case HAWQ_TYPE_TIMESTAMPTZ:
+		case HAWQ_TYPE_FLOAT8:
+			chunk->collectMinMax = true;
+			break;
+		default:
+			chunk->collectMinMax = false;
+			break;
+		}
+
+		/* bool values are bit-packed already, a dictionary can't do better */
+		chunk->useDictionary		= gp_parquet_enable_dictionary && chunkmd->type != BOOLEAN;
+		chunk->dictionary			= chunk->useDictionary ? createDictionary() : NULL;
+		chunk->dictionaryPageCount	= 0;
+
 		*colIndex = *colIndex + 1;
 	}
 }
 
 /*
- * Write out a specified data page (page header + page data)
+ * Write out a specified data or dictionary page (page header + page data)
  */
 static void
-flushDataPage(ParquetColumnChunk chunk, int page_number)
+flushPage(ParquetDataPage page)
 {
-	ParquetDataPage page = &chunk->pages[page_number];
 	Assert(page != NULL);
 	Assert(page->finalized);
 	Assert(page->header_buffer != NULL);
@@ -1598,6 +1689,7 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 	ParquetDataPage current_page;
 	ParquetPageHeader header;
 	ColumnChunkMetadata chunkmd;
+	RLEEncoder *dict_index_encoder;
 
 	bytes_added = 0;
 	current_page = chunk->currentPage;
@@ -1609,6 +1701,24 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 	if (current_page->finalized)
 		return 0;
 
+	/*----------------------------------------------------------------
+	 * Replace plain values by dictionary indices if the page has them.
+	 * Size of the value part is reset to the size of encoded indices.
+	 *
+	 * value = <1-byte bit width> + <rle/bitpack encoded indices>
+	 *----------------------------------------------------------------*/
+	dict_index_encoder = NULL;
+	if (current_page->dict_indices != NULL)
+	{
+		dict_index_encoder = encodeDictionaryIndices(chunk, current_page);
+		if (dict_index_encoder != NULL)
+		{
+			header->encoding = PLAIN_DICTIONARY;
+			header->uncompressed_page_size = 1 + RLEEncoder_Size(dict_index_encoder);
+			chunk->dictionaryPageCount++;
+		}
+	}
+
 	/*----------------------------------------------------------------
 	 * Flush RLE/BitPack encoded data. Size of r and d data are
 	 * accumulated into page's uncompressed_page_size in this phase.
@@ -1681,6 +1791,20 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 		pfree(current_page->bool_values->buffer);
 		pfree(current_page->bool_values);
 	}
+	else if (dict_index_encoder != NULL)
+	{
+		uint8_t bit_width = (uint8_t) dict_index_encoder->bitWidth;
+
+		appendBinaryStringInfo(&buf, &bit_width, 1);
+		appendBinaryStringInfo(&buf,
+							   RLEEncoder_Data(dict_index_encoder),
+							   RLEEncoder_Size(dict_index_encoder));
+
+		pfree(dict_index_encoder->writer.buffer);
+		pfree(dict_index_encoder->packBuffer);
+		pfree(dict_index_encoder);
+		pfree(current_page->values_buffer);
+	}
 	else
 	{
 		appendBinaryStringInfo(&buf,
@@ -1690,6 +1814,24 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 		pfree(current_page->values_buffer);
 	}
 
+	compressAndFinalizePage(chunk, current_page, &buf);
+
+	return bytes_added;
+}
+
+/*
+ * Put the page data in `buf` (compressed if needed) in page->data, and
+ * the thrift page header in page->header_buffer, then account the page
+ * in the column chunk's sizes. `buf` holds uncompressed_page_size bytes.
+ */
+static void
+compressAndFinalizePage(ParquetColumnChunk chunk, ParquetDataPage current_page, StringInfo buf)
+{
+	ParquetPageHeader header = current_page->header;
+	ColumnChunkMetadata chunkmd = chunk->columnChunkMetadata;
+
+	Assert(buf->len == header->uncompressed_page_size);
+
 	/*----------------------------------------------------------------
 	 * Compress page data if needed, saved it to current_page->data.
 	 *----------------------------------------------------------------*/
@@ -1697,7 +1839,7 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 	{
 		case UNCOMPRESSED:
 		{
-			current_page->data = (uint8_t*) buf.data;
+			current_page->data = (uint8_t*) buf->data;
 			header->compressed_page_size = header->uncompressed_page_size;
 			break;
 		}
@@ -1707,10 +1849,10 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 			size_t compressedLen = snappy_max_compressed_length(header->uncompressed_page_size);
 			current_page->data = (uint8_t *) palloc(compressedLen);
 
-			if (snappy_compress(buf.data, header->uncompressed_page_size,
+			if (snappy_compress(buf->data, header->uncompressed_page_size,
 								(char *)current_page->data, &compressedLen) == SNAPPY_OK)
 			{
-				pfree(buf.data);
+				pfree(buf->data);
 				header->compressed_page_size = compressedLen;
 			}
 			else
@@ -1733,7 +1875,7 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 			stream.zfree	= Z_NULL;
 			stream.opaque	= Z_NULL;
 			stream.avail_in	= header->uncompressed_page_size;
-			stream.next_in	= (Bytef *) buf.data;
+			stream.next_in	= (Bytef *) buf->data;
 
 			ret = deflateInit2(&stream, chunk->compresslevel, Z_DEFLATED,
 							   windowbits, MAX_MEM_LEVEL, Z_DEFAULT_STRATEGY);
@@ -1780,7 +1922,7 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 			compressedLen = stream.total_out;
 			deflateEnd(&stream);
 
-			pfree(buf.data);
+			pfree(buf->data);
 			header->compressed_page_size = compressedLen;
 			break;
 		}
@@ -1815,8 +1957,208 @@ encodeCurrentPage(ParquetColumnChunk chunk)
 	chunkmd->totalSize				+= current_page->header_len + header->compressed_page_size;
 	
 	current_page->finalized = true;
+}
 
-	return bytes_added;
+/*
+ * Encode the dictionary of a column chunk into a finalized dictionary page.
+ */
+static ParquetDataPage
+encodeDictionaryPage(ParquetColumnChunk chunk)
+{
+	ParquetDictionary dict = chunk->dictionary;
+	ParquetDataPage page;
+	StringInfoData buf;
+
+	Assert(dict != NULL && dict->numEntries > 0);
+
+	page = (ParquetDataPage) palloc0(sizeof(struct ParquetDataPage_S));
+	page->header = (ParquetPageHeader) palloc0(sizeof(PageMetadata_4C));
+	page->header->page_type = DICTIONARY_PAGE;
+	page->header->encoding = PLAIN_DICTIONARY;
+	page->header->num_values = dict->numEntries;
+	page->header->uncompressed_page_size = dict->bufferLen;
+	page->parquetFile = chunk->parquetFile;
+
+	initStringInfoOfSize(&buf, dict->bufferLen + 1);
+	appendBinaryStringInfo(&buf, dict->buffer, dict->bufferLen);
+
+	compressAndFinalizePage(chunk, page, &buf);
+
+	return page;
+}
+
+/*
+ * Encode dictionary indices of `page` with rle/bit-packing hybrid encoding.
+ *
+ * Return NULL if the page should be written plain. That is the case for
+ * a page without non-null values, or for the first page of the chunk if
+ * indices plus dictionary are not smaller than the plain values, in which
+ * case the dictionary is given up for the rest of the chunk.
+ */
+static RLEEncoder *
+encodeDictionaryIndices(ParquetColumnChunk chunk, ParquetDataPage page)
+{
+	ParquetDictionary dict = chunk->dictionary;
+	RLEEncoder *encoder = NULL;
+	int bitWidth;
+
+	if (page->dict_index_count > 0)
+	{
+		bitWidth = dict->numEntries > 1 ? widthFromMaxInt(dict->numEntries - 1) : 1;
+
+		encoder = (RLEEncoder *) palloc0(sizeof(RLEEncoder));
+		RLEEncoder_Init(encoder, bitWidth);
+		for (int i = 0; i < page->dict_index_count; i++)
+		{
+			RLEEncoder_WriteInt(encoder, page->dict_indices[i]);
+		}
+		RLEEncoder_Flush(encoder);
+
+		if (chunk->dictionaryPageCount == 0 &&
+			1 + RLEEncoder_Size(encoder) + dict->bufferLen >= page->header->uncompressed_page_size)
+		{
+			chunk->useDictionary = false;
+
+			pfree(encoder->writer.buffer);
+			pfree(encoder->packBuffer);
+			pfree(encoder);
+			encoder = NULL;
+		}
+	}
+
+	pfree(page->dict_indices);
+	page->dict_indices = NULL;
+
+	return encoder;
+}
+
+static ParquetDictionary
+createDictionary(void)
+{
+	ParquetDictionary dict = (ParquetDictionary) palloc0(sizeof(struct ParquetDictionary_S));
+
+	dict->bufferCapacity	= 1024;
+	dict->buffer			= (uint8_t *) palloc(dict->bufferCapacity);
+	dict->entryCapacity		= 64;
+	dict->entryOffsets		= (int *) palloc(dict->entryCapacity * sizeof(int));
+	dict->entryLens			= (int *) palloc(dict->entryCapacity * sizeof(int));
+	dict->entryHashes		= (uint32 *) palloc(dict->entryCapacity * sizeof(uint32));
+	dict->numSlots			= 2 * dict->entryCapacity;
+	dict->slots				= (int *) palloc0(dict->numSlots * sizeof(int));
+
+	return dict;
+}
+
+static void
+freeDictionary(ParquetDictionary dict)
+{
+	pfree(dict->buffer);
+	pfree(dict->entryOffsets);
+	pfree(dict->entryLens);
+	pfree(dict->entryHashes);
+	pfree(dict->slots);
+	pfree(dict);
+}
+
+/*
+ * Look up plain encoded `value` of `len` bytes in the dictionary, and add
+ * it as a new entry if it's not there.
+ *
+ * Return the entry number, or -1 if adding the value would make the
+ * dictionary larger than `sizeLimit` bytes.
+ */
+static int
+insertDictionaryEntry(ParquetDictionary dict, uint8_t *value, int len, int sizeLimit)
+{
+	uint32	hash;
+	int		slot;
+	int		entry;
+
+	/* keep the hash table at most half full */
+	if (dict->numEntries >= dict->numSlots / 2)
+	{
+		pfree(dict->slots);
+		dict->numSlots *= 2;
+		dict->slots = (int *) palloc0(dict->numSlots * sizeof(int));
+
+		for (entry = 0; entry < dict->numEntries; entry++)
+		{
+			slot = dict->entryHashes[entry] & (dict->numSlots - 1);
+			while (dict->slots[slot] != 0)
+				slot = (slot + 1) & (dict->numSlots - 1);
+			dict->slots[slot] = entry + 1;
+		}
+	}
+
+	hash = DatumGetUInt32(hash_any((unsigned char *) value, len));
+	slot = hash & (dict->numSlots - 1);
+	while (dict->slots[slot] != 0)
+	{
+		entry = dict->slots[slot] - 1;
+		if (dict->entryHashes[entry] == hash &&
+			dict->entryLens[entry] == len &&
+			memcmp(dict->buffer + dict->entryOffsets[entry], value, len) == 0)
+		{
+			return entry;
+		}
+		slot = (slot + 1) & (dict->numSlots - 1);
+	}
+
+	if (dict->bufferLen + len > sizeLimit)
+		return -1;
+
+	if (dict->bufferLen + len > dict->bufferCapacity)
+	{
+		dict->bufferCapacity = Max(dict->bufferCapacity * 2, dict->bufferLen + len);
+		dict->buffer = (uint8_t *) repalloc(dict->buffer, dict->bufferCapacity);
+	}
+
+	if (dict->numEntries == dict->entryCapacity)
+	{
+		dict->entryCapacity *= 2;
+		dict->entryOffsets = (int *) repalloc(dict->entryOffsets, dict->entryCapacity * sizeof(int));
+		dict->entryLens = (int *) repalloc(dict->entryLens, dict->entryCapacity * sizeof(int));
+		dict->entryHashes = (uint32 *) repalloc(dict->entryHashes, dict->entryCapacity * sizeof(uint32));
+	}
+
+	entry = dict->numEntries++;
+	memcpy(dict->buffer + dict->bufferLen, value, len);
+	dict->entryOffsets[entry] = dict->bufferLen;
+	dict->entryLens[entry] = len;
+	dict->entryHashes[entry] = hash;
+	dict->bufferLen += len;
+	dict->slots[slot] = entry + 1;
+
+	return entry;
+}
+
+/*
+ * Record the dictionary index of the plain encoded value just appended to
+ * the current page. If the dictionary is full, the current page and the
+ * rest of the chunk are written plain.
+ */
+static void
+appendDictionaryIndex(ParquetColumnChunk chunk, uint8_t *value, int len)
+{
+	ParquetDataPage page = chunk->currentPage;
+	int index;
+
+	index = insertDictionaryEntry(chunk->dictionary, value, len, chunk->pageSizeLimit);
+	if (index < 0)
+	{
+		chunk->useDictionary = false;
+		pfree(page->dict_indices);
+		page->dict_indices = NULL;
+		return;
+	}
+
+	if (page->dict_index_count == page->dict_index_capacity)
+	{
+		page->dict_index_capacity *= 2;
+		page->dict_indices = (int32_t *) repalloc(page->dict_indices,
+												  page->dict_index_capacity * sizeof(int32_t));
+	}
+	page->dict_indices[page->dict_index_count++] = index;
 }
 
 static void
@@ -1878,6 +2220,14 @@ addDataPage(ParquetColumnChunk chunk)
 			chunk->currentPage->values_buffer_capacity = chunk->estimateChunkSizeRemained;
 		}
 		chunk->currentPage->values_buffer = palloc0(chunk->currentPage->values_buffer_capacity);
+
+		if (chunk->useDictionary)
+		{
+			chunk->currentPage->dict_index_capacity = 256;
+			chunk->currentPage->dict_index_count = 0;
+			chunk->currentPage->dict_indices =
+				(int32_t *) palloc(chunk->currentPage->dict_index_capacity * sizeof(int32_t));
+		}
 	}
 
 	chunk->pageNumber++;
@@ -1909,6 +2259,7 @@ appendParquetColumnNull(ParquetColumnChunk columnChunk)
 
 	columnChunk->currentPage->header->num_values++;
 	columnChunk->columnChunkMetadata->valueCount++;
+	columnChunk->columnChunkMetadata->nullCount++;
 	return bytes_added;
 }
 
@@ -1980,6 +2331,14 @@ appendParquetColumnValue(ParquetColumnChunk chunk,
 
 	bytes_added += encoded_len;
 
+	if (chunk->currentPage->dict_indices != NULL)
+	{
+		appendDictionaryIndex(chunk,
+							  chunk->currentPage->values_buffer +
+							  chunk->currentPage->header->uncompressed_page_size,
+							  encoded_len);
+	}
+
 	if (chunk->currentPage->repetition_level != NULL)
 	{
 		RLEEncoder_WriteInt(chunk->currentPage->repetition_level, r);
@@ -1994,9 +2353,117 @@ appendParquetColumnValue(ParquetColumnChunk chunk,
 
 	chunk->columnChunkMetadata->valueCount++;
 
+	if (chunk->collectMinMax)
+	{
+		updateColumnChunkMinMax(chunk, value);
+	}
+
 	return bytes_added;
 }
 
+/*
+ * Merge `val` of C type `ctype` into the plain encoded min/max statistics
+ * of column chunk metadata `chunkmd`.
+ */
+#define UPDATE_MINMAX(chunkmd, ctype, val) \
+	do { \
+		ctype	min_; \
+		ctype	max_; \
+		if (!(chunkmd)->hasMinMax) \
+		{ \
+			memcpy((chunkmd)->minValue, &(val), sizeof(ctype)); \
+			memcpy((chunkmd)->maxValue, &(val), sizeof(ctype)); \
+			(chunkmd)->minMaxLen = sizeof(ctype); \
+			(chunkmd)->hasMinMax = true; \
+			break; \
+		} \
+		memcpy(&min_, (chunkmd)->minValue, sizeof(ctype)); \
+		memcpy(&max_, (chunkmd)->maxValue, sizeof(ctype)); \
+		if ((val) < min_) \
+			memcpy((chunkmd)->minValue, &(val), sizeof(ctype)); \
+		if ((val) > max_) \
+			memcpy((chunkmd)->maxValue, &(val), sizeof(ctype)); \
+	} while (0)
+
+/*
+ * Update min/max statistics of the column chunk with a non-null value.
+ * Values are kept in the same plain encoding as in data pages.
+ */
+static void
+updateColumnChunkMinMax(ParquetColumnChunk chunk, Datum value)
+{
+	ColumnChunkMetadata chunkmd = chunk->columnChunkMetadata;
+
+	switch (chunkmd->hawqTypeId)
+	{
+	case HAWQ_TYPE_INT2:
+	{
+		int32 val = (int32) DatumGetInt16(value);
+		UPDATE_MINMAX(chunkmd, int32, val);
+		break;
+	}
+	case HAWQ_TYPE_INT4:
+	{
+		int32 val = DatumGetInt32(value);
+		UPDATE_MINMAX(chunkmd, int32, val);
+		break;
+	}
+	case HAWQ_TYPE_DATE:
+	{
+		DateADT val = DatumGetDateADT(value);
+		UPDATE_MINMAX(chunkmd, DateADT, val);
+		break;
+	}
+	case HAWQ_TYPE_INT8:
+	{
+		int64 val = DatumGetInt64(value);
+		UPDATE_MINMAX(chunkmd, int64, val);
+		break;
+	}
+	case HAWQ_TYPE_TIME:
+	{
+		TimeADT val = DatumGetTimeADT(value);
+		UPDATE_MINMAX(chunkmd, TimeADT, val);
+		break;
+	}
+	case HAWQ_TYPE_TIMESTAMP:
+	case HAWQ_TYPE_TIMESTAMPTZ:
+	{
+		Timestamp val = DatumGetTimestamp(value);
+		UPDATE_MINMAX(chunkmd, Timestamp, val);
+		break;
+	}
+	case HAWQ_TYPE_FLOAT4:
+	{
+		float4 val = DatumGetFloat4(value);
+		if (isnan(val))
+		{
+			/* NaN sorts above all values, don't bother tracking it */
+			chunk->collectMinMax = false;
+			chunkmd->hasMinMax = false;
+			break;
+		}
+		UPDATE_MINMAX(chunkmd, float4, val);
+		break;
+	}
+	case HAWQ_TYPE_FLOAT8:
+	{
+		float8 val = DatumGetFloat8(value);
+		if (isnan(val))
+		{
+			chunk->collectMinMax = false;
+			chunkmd->hasMinMax = false;
+			break;
+		}
+		UPDATE_MINMAX(chunkmd, float8, val);
+		break;
+	}
+	default:
+		chunk->collectMinMax = false;
+		break;
+	}
+}
+
 /*
  * Append null for field. 
  *
@@ -148,10 +148,13 @@ int			Gp_interconnect_timer_checking_period=20;
 int			Gp_interconnect_default_rtt=20;
 int			Gp_interconnect_min_rto=20;
 int			Gp_interconnect_fc_method=INTERCONNECT_FC_METHOD_LOSS;
+int			Gp_interconnect_cc_method=INTERCONNECT_CC_METHOD_RENO;
+bool		gp_interconnect_pacing=false;
 int		    Gp_interconnect_transmit_timeout=3600;
 int			Gp_interconnect_min_retries_before_timeout=100;
 
 int			Gp_interconnect_hash_multiplier=2;	/* sets the size of the hash table used by the UDP-IC */
+int			Gp_interconnect_rx_threads=1;	/* number of UDP-IC receive threads */
 
 int			interconnect_setup_timeout=7200;
 
@@ -250,6 +253,7 @@ bool		gp_enable_alter_table_inherit_cols = false;
 
 /* During insertion in a table with parquet partitions, require tuples to be sorted by partition key */
 bool		gp_parquet_insert_sort = true;
+bool		gp_parquet_enable_dictionary = true;
 
 /* The following GUCs is for HAWQ 2.o */
 
@@ -284,6 +288,7 @@ double metadata_cache_flush_ratio;
 double metadata_cache_reduce_ratio;
 
 char *metadata_cache_testfile;
+int metadata_fetch_max_threads;
 bool debug_fake_datalocality;
 bool datalocality_remedy_enable;
 bool get_tmpdir_from_rm;
@@ -406,6 +411,8 @@ bool		gp_enable_motion_deadlock_sanity = FALSE; /* planning time sanity check */
 #ifdef USE_ASSERT_CHECKING
 bool		gp_mk_sort_check = false;
 #endif
+bool		gp_enable_mk_radix_sort = true;
+int			gp_mk_sort_parallel_workers = 0;
 bool 		trace_sort = false;
 int			gp_sort_flags = 0;
 int			gp_dbg_flags = 0;
@@ -1003,6 +1010,45 @@ gpvars_show_gp_interconnect_fc_method(void)
 	}
 }                               /* gpvars_show_gp_interconnect_fc_method */
 
+/*
+ * gpvars_assign_gp_interconnect_cc_method
+ * gpvars_show_gp_interconnect_cc_method
+ */
+const char *
+gpvars_assign_gp_interconnect_cc_method(const char *newval, bool doit, GucSource source __attribute__((unused)) )
+{
+	int newmethod = 0;
+
+	if (newval == NULL || newval[0] == 0 ||
+		!pg_strcasecmp("reno", newval))
+		newmethod = INTERCONNECT_CC_METHOD_RENO;
+	else if (!pg_strcasecmp("dctcp", newval))
+		newmethod = INTERCONNECT_CC_METHOD_DCTCP;
+	else
+		elog(ERROR, "Unknown interconnect congestion control method. (current method is '%s')", gpvars_show_gp_interconnect_cc_method());
+
+	if (doit)
+	{
+		Gp_interconnect_cc_method = newmethod;
+	}
+
+	return newval;
+}                               /* gpvars_assign_gp_interconnect_cc_method */
+
+const char *
+gpvars_show_gp_interconnect_cc_method(void)
+{
+	switch(Gp_interconnect_cc_method)
+	{
+		case INTERCONNECT_CC_METHOD_RENO:
+			return "RENO";
+		case INTERCONNECT_CC_METHOD_DCTCP:
+			return "DCTCP";
+		default:
+			return "RENO";
+	}
+}                               /* gpvars_show_gp_interconnect_cc_method */
+
 /*
  * Parse the string value of gp_autostats_mode and gp_autostats_mode_in_functions
  */
@@ -55,6 +55,9 @@ int			Gp_max_tuple_chunk_size;
  *
  * static TupleChunkListItemData s_eos_chunk_data = {NULL, TUPLE_CHUNK_HEADER_SIZE, NULL, "                "};
  */
+/* Maximal number of tuples converted from the chunks of a receive buffer at once. */
+#define MOTION_RECV_BATCH_SIZE 64
+
 static uint8 s_eos_buffer[sizeof(TupleChunkListItemData) + 8];
 static TupleChunkListItem s_eos_chunk_data = (TupleChunkListItem)s_eos_buffer;
 
@@ -690,6 +693,37 @@ processIncomingChunks(MotionLayerState *mlStates,
 
 	while (tcItem != NULL)
 	{
+		ChunkSorterEntry *chunkSorterEntry;
+		TupleChunkType tcType;
+
+		/*
+		 * Convert a run of chunks each holding a whole tuple in one go,
+		 * straight from the receive buffer.
+		 */
+		GetChunkType(tcItem, &tcType);
+		chunkSorterEntry = getChunkSorterEntry(mlStates, pMNEntry, srcRoute);
+		if ((tcType == TC_WHOLE || tcType == TC_EMPTY) &&
+			chunkSorterEntry->chunk_list.num_chunks == 0)
+		{
+			HeapTuple	tuples[MOTION_RECV_BATCH_SIZE];
+			int			bytes = 0;
+			int			ntuples;
+			int			i;
+
+			ntuples = CvtWholeChunksToHeapTups(&tcItem, &pMNEntry->ser_tup_info,
+											   tuples, MOTION_RECV_BATCH_SIZE, &bytes);
+			for (i = 0; i < ntuples; i++)
+			{
+				htfifo_addtuple(chunkSorterEntry->ready_tuples, tuples[i]);
+				statNewTupleArrived(pMNEntry, chunkSorterEntry);
+			}
+
+			numChunks += ntuples;
+			chunkBytes += bytes;
+			tupleBytes += bytes - ntuples * TUPLE_CHUNK_HEADER_SIZE;
+			continue;
+		}
+
 		numChunks++;
 
 		/* Detach the current chunk off of the front of the list. */
@@ -151,6 +151,36 @@ timeoutArray[] =
 /* 1/4 sec in msec */
 #define RX_THREAD_POLL_TIMEOUT (250)
 
+/*
+ * Packets are sent with sendmmsg() and received with recvmmsg() in
+ * batches of up to IC_MMSG_BATCH_SIZE packets where the platform supports
+ * them, to reduce the number of system calls of high fanout motions.
+ */
+#if defined(__linux__) && defined(MSG_WAITFORONE)
+#define IC_USE_MMSG
+#define IC_MMSG_BATCH_SIZE (32)
+#else
+#define IC_MMSG_BATCH_SIZE (1)
+#endif
+
+/*
+ * Packets can be handled by several rx threads. The first one reads all the
+ * packets from the listener socket, and hands each of them to a thread
+ * chosen by the connection hash of the packet, so the packets of a
+ * connection are always handled by the same thread and keep their order.
+ * The other threads take the packets from their RxWorkerQueue.
+ *
+ * The other threads check the length and CRC of the packets in parallel,
+ * but still handle them under ic_control_info.lock, as the connections are
+ * shared with the main thread, so they add little receive throughput yet.
+ *
+ * The listener socket is not shared with SO_REUSEPORT, as another backend
+ * of the same user could then be given the same ephemeral port and receive
+ * our packets.
+ */
+#define IC_MAX_RX_THREADS (16)
+#define RX_WORKER_QUEUE_SIZE (64)
+
 /*
  * Flags definitions for flag-field of UDP-messages
  *
@@ -370,6 +400,25 @@ struct SendBufferPool
  */
 static SendBufferPool snd_buffer_pool;
 
+/*
+ * ICCongestionControl
+ *
+ * A congestion control algorithm of the loss based flow control. It adjusts
+ * the congestion window shared by all the connections in snd_control_info.
+ */
+typedef struct ICCongestionControl ICCongestionControl;
+struct ICCongestionControl
+{
+	/* Called when a packet of conn sent only once is acked, ackTime is its rtt sample. */
+	void (*onAck)(MotionConn *conn, uint64 ackTime);
+
+	/* Called when receivers report lost packets by disorder messages. */
+	void (*onLoss)(void);
+
+	/* Called when packets are resent because their acks did not arrive in time. */
+	void (*onTimeout)(void);
+};
+
 /*
  * SendControlInfo
  *
@@ -393,6 +442,19 @@ struct SendControlInfo
 	/* slow start threshold */
 	float ssthresh;
 
+	/* congestion control algorithm, see gp_interconnect_cc_method */
+	const ICCongestionControl *cc;
+
+	/* smoothed rtt samples of all the connections (us) */
+	uint64 srtt;
+
+	/* dctcp: estimated fraction of delayed acks and the counters of the current window */
+	float alpha;
+	uint32 ackedInWindow;
+	uint32 delayedInWindow;
+
+	/* time the next packet can be sent if gp_interconnect_pacing is on (us) */
+	uint64 nextSendTime;
 };
 
 /*
@@ -429,6 +491,32 @@ struct UDPSignal
 };
 #endif
 
+/*
+ * RxWorkerQueue
+ *
+ * The packets handed from the first rx thread to another one.
+ */
+typedef struct RxQueuedPacket RxQueuedPacket;
+struct RxQueuedPacket
+{
+	icpkthdr   *pkt;
+	int			len;
+	socklen_t	peerlen;
+	struct sockaddr_storage peer;
+};
+
+typedef struct RxWorkerQueue RxWorkerQueue;
+struct RxWorkerQueue
+{
+	pthread_mutex_t lock;
+	pthread_cond_t notEmpty;
+	pthread_cond_t notFull;
+
+	int			head;
+	int			count;
+	RxQueuedPacket packets[RX_WORKER_QUEUE_SIZE];
+};
+
 /*
  * ICGlobalControlInfo
  *
@@ -439,10 +527,25 @@ struct UDPSignal
 typedef struct ICGlobalControlInfo ICGlobalControlInfo;
 struct ICGlobalControlInfo
 {
-	/* The background thread handle. */
-	pthread_t threadHandle;
+	/* The background thread handles. */
+	pthread_t threadHandles[IC_MAX_RX_THREADS];
+	int numThreads;
+
+	/*
+	 * The queues of the background threads but the first one, indexed by
+	 * the thread number, and the number of packets in all of them.
+	 */
+	RxWorkerQueue *rxQueues;
+	volatile int32 rxQueuedPackets;
+
+	/*
+	 * Signaled under lock when a buffer goes back to rx_buffer_pool while
+	 * the first rx thread waits for one, as all of them are queued.
+	 */
+	pthread_cond_t rxBufferFreed;
+	bool rxBufferWaiting;
 
-	/* flag showing whether the thread is created. */
+	/* flag showing whether the threads are created. */
 	bool threadCreated;
 
 	/* The lock protecting eno field. */
@@ -653,6 +756,9 @@ typedef struct AckSendParam
  * duplicatedPktNum          - duplicate packet number.
  * recvAckNum                - the number of Acks received.
  * statusQueryMsgNum         - the number of status query messages sent.
+ * sndSyscallNum             - the number of system calls used to send sndPktNum packets.
+ * recvSyscallNum            - the number of system calls receiving packets in rx thread.
+ * recvSyscallPktNum         - the number of packets received by recvSyscallNum calls.
  *
  */
 typedef struct ICStatistics
@@ -673,6 +779,9 @@ typedef struct ICStatistics
 	int32   duplicatedPktNum;
 	int32	recvAckNum;
 	int32	statusQueryMsgNum;
+	int32	sndSyscallNum;
+	int32	recvSyscallNum;
+	int32	recvSyscallPktNum;
 } ICStatistics;
 
 /* Statistics for UDP interconnect. */
@@ -781,6 +890,12 @@ static void checkQDConnectionAlive(void);
 
 
 static void *rxThreadFunc(void *arg);
+static void *rxWorkerThreadFunc(void *arg);
+static void dispatchRxPacket(int thread, icpkthdr *pkt, int len,
+							 struct sockaddr_storage *peer, socklen_t peerlen);
+static void wakeRxWorkerThreads(void);
+static void waitForRxBuffer(void);
+static bool handleRxPacket(icpkthdr *pkt, int read_count, struct sockaddr_storage *peer, socklen_t peerlen);
 
 static bool handleMismatch(icpkthdr *pkt, struct sockaddr_storage *peer, int peer_len);
 static void inline handleAckedPacket(MotionConn *ackConn, ICBuffer *buf, uint64 now);
@@ -796,6 +911,7 @@ static inline void addCRC(icpkthdr *pkt);
 static inline bool checkCRC(icpkthdr *pkt);
 static void sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn);
 static void sendOnce(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer *buf, MotionConn * conn);
+static void sendBatch(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer **bufs, int count, MotionConn *conn);
 static inline uint64 computeExpirationPeriod(MotionConn *conn, uint32 retry);
 
 static ICBuffer *getSndBuffer(MotionConn *conn);
@@ -820,6 +936,20 @@ static void aggregateStatistics(ChunkTransportStateEntry *pEntry);
 
 static inline bool pollAcks(ChunkTransportState *transportStates, int fd, int timeout);
 
+static void renoOnAck(MotionConn *conn, uint64 ackTime);
+static void renoOnLoss(void);
+static void renoOnTimeout(void);
+static void dctcpOnAck(MotionConn *conn, uint64 ackTime);
+static inline bool pacingDelayed(uint64 now);
+static inline void pacingSent(uint64 now);
+
+/* Congestion control algorithms, indexed by Gp_interconnect_cc_method. */
+static const ICCongestionControl ic_congestion_controls[] =
+{
+	{renoOnAck, renoOnLoss, renoOnTimeout},		/* INTERCONNECT_CC_METHOD_RENO */
+	{dctcpOnAck, renoOnLoss, renoOnTimeout}		/* INTERCONNECT_CC_METHOD_DCTCP */
+};
+
 
 #if defined(__darwin__) && !defined(IC_USE_PTHREAD_SYNCHRONIZATION)
 static int udpSignalTimeoutWait(UDPSignal *sig, pthread_cond_t *cond, pthread_mutex_t *mutex, const struct timespec *ts);
@@ -1391,6 +1521,8 @@ InitMotionUDP(int *listenerSocketFd, uint16 *listenerPort)
 {
 	int pthread_err;
 	int txFamily = -1;
+	int numRxThreads = 1;
+	int i;
 
 	/* attributes of the thread we're creating */
 	pthread_attr_t t_atts;
@@ -1423,6 +1555,23 @@ InitMotionUDP(int *listenerSocketFd, uint16 *listenerPort)
 	 */
 	setupUDPListeningSocket(listenerSocketFd, listenerPort, &txFamily);
 
+	/* queues of the rx threads handling the packets read by the first one. */
+	numRxThreads = Min(Gp_interconnect_rx_threads, IC_MAX_RX_THREADS);
+	ic_control_info.rxQueuedPackets = 0;
+	ic_control_info.rxQueues = NULL;
+	ic_control_info.rxBufferWaiting = false;
+	pthread_cond_init(&ic_control_info.rxBufferFreed, NULL);
+	if (numRxThreads > 1)
+	{
+		ic_control_info.rxQueues = palloc0(numRxThreads * sizeof(RxWorkerQueue));
+		for (i = 1; i < numRxThreads; i++)
+		{
+			initMutex(&ic_control_info.rxQueues[i].lock);
+			pthread_cond_init(&ic_control_info.rxQueues[i].notEmpty, NULL);
+			pthread_cond_init(&ic_control_info.rxQueues[i].notFull, NULL);
+		}
+	}
+
 #if defined(__darwin__) && !defined(IC_USE_PTHREAD_SYNCHRONIZATION)
 	setupUDPSignal(&ic_control_info.usig);
 #endif
@@ -1461,11 +1610,31 @@ InitMotionUDP(int *listenerSocketFd, uint16 *listenerPort)
 #else
 	pthread_attr_setstacksize(&t_atts, Max(PTHREAD_STACK_MIN, (128*1024)));
 #endif
-	pthread_err = pthread_create(&ic_control_info.threadHandle, &t_atts, rxThreadFunc, NULL);
+	/* numThreads is read by the first thread to dispatch packets. */
+	ic_control_info.numThreads = numRxThreads;
+	pthread_err = 0;
+	for (i = 1; i < numRxThreads; i++)
+	{
+		pthread_err = pthread_create(&ic_control_info.threadHandles[i], &t_atts,
+									 rxWorkerThreadFunc, &ic_control_info.rxQueues[i]);
+		if (pthread_err != 0)
+			break;
+	}
+	if (pthread_err == 0)
+		pthread_err = pthread_create(&ic_control_info.threadHandles[0], &t_atts,
+									 rxThreadFunc, NULL);
 
 	pthread_attr_destroy(&t_atts);
 	if (pthread_err != 0)
 	{
+		int		started = i;
+
+		/* stop the worker threads already started, 1 .. started - 1. */
+		compare_and_swap_32(&ic_control_info.shutdown, 0, 1);
+		wakeRxWorkerThreads();
+		for (i = 1; i < started; i++)
+			pthread_join(ic_control_info.threadHandles[i], NULL);
+		ic_control_info.numThreads = 0;
 		ic_control_info.threadCreated = false;
 		ereport(FATAL, (errcode(ERRCODE_INTERNAL_ERROR),
 						errmsg("InitMotionLayerIPC: failed to create thread"),
@@ -1498,7 +1667,13 @@ CleanupMotionUDP(void)
 
 	if(ic_control_info.threadCreated)
 	{
-		pthread_join(ic_control_info.threadHandle, NULL);
+		int		i;
+
+		wakeRxWorkerThreads();
+		for (i = 0; i < ic_control_info.numThreads; i++)
+			pthread_join(ic_control_info.threadHandles[i], NULL);
+		ic_control_info.numThreads = 0;
+		ic_control_info.threadCreated = false;
 	}
 
 	elog(DEBUG2, "udp-ic: receiver thread shutdown.");
@@ -2139,6 +2314,9 @@ putRxBufferToFreeList(RxBufferPool *p, icpkthdr *buf)
 	/* return the buffer into the free list. */
 	*(char **)buf = p->freeList;
 	p->freeList = (char *)buf;
+
+	if (ic_control_info.rxBufferWaiting)
+		pthread_cond_signal(&ic_control_info.rxBufferFreed);
 }
 
 /*
@@ -2182,6 +2360,9 @@ freeRxBuffer(RxBufferPool *p, icpkthdr *buf)
 {
 	free(buf);
 	p->count--;
+
+	if (ic_control_info.rxBufferWaiting)
+		pthread_cond_signal(&ic_control_info.rxBufferFreed);
 }
 
 /*
@@ -2985,6 +3166,7 @@ startOutgoingUDPConnections(ChunkTransportState *transportStates,
 			Assert(conn->curBuff != NULL);
 
 			conn->rtt = DEFAULT_RTT;
+			conn->minRtt = 0;
 			conn->dev = DEFAULT_DEV;
 			conn->deadlockCheckBeginTime = 0;
 			conn->tupleCount = 0;
@@ -3474,6 +3656,12 @@ SetupUDPInterconnect_Internal(EState *estate)
 	snd_control_info.cwnd = 0;
 	snd_control_info.minCwnd = 0;
 	snd_control_info.ssthresh = 0;
+	snd_control_info.cc = &ic_congestion_controls[Gp_interconnect_cc_method];
+	snd_control_info.srtt = 0;
+	snd_control_info.alpha = 0;
+	snd_control_info.ackedInWindow = 0;
+	snd_control_info.delayedInWindow = 0;
+	snd_control_info.nextSendTime = 0;
 
 	/* Initiate outgoing connections. */
 	if (mySlice->parentIndex != -1)
@@ -3882,7 +4070,8 @@ TeardownUDPInterconnect_Internal(ChunkTransportState *transportStates,
 			" freebuf_avg %f "
 			"mismatch_pkt_num %d disordered_pkt_num %d duplicated_pkt_num %d"
 			" rtt/dev [" UINT64_FORMAT "/" UINT64_FORMAT ", %f/%f, " UINT64_FORMAT "/" UINT64_FORMAT "] "
-			" cwnd %f status_query_msg_num %d",
+			" cwnd %f status_query_msg_num %d"
+			" snd_pkts_per_syscall %f recv_pkts_per_syscall %f",
 			ic_control_info.isSender, isReceiver,
 			Gp_interconnect_snd_queue_depth, Gp_interconnect_queue_depth, Gp_max_packet_size,
 			UNACK_QUEUE_RING_SLOTS_NUM, TIMER_SPAN, DEFAULT_RTT,
@@ -3895,7 +4084,9 @@ TeardownUDPInterconnect_Internal(ChunkTransportState *transportStates,
 			(double)((double)ic_statistics.totalBuffers)/((double)ic_statistics.bufferCountingTime),
 			ic_statistics.mismatchNum, ic_statistics.disorderedPktNum, ic_statistics.duplicatedPktNum,
 			(minRtt == ~((uint64)0) ? 0 : minRtt), (minDev == ~((uint64)0) ? 0 : minDev), avgRtt, avgDev, maxRtt, maxDev,
-			snd_control_info.cwnd, ic_statistics.statusQueryMsgNum);
+			snd_control_info.cwnd, ic_statistics.statusQueryMsgNum,
+			(ic_statistics.sndSyscallNum == 0 ? 0 : (double)ic_statistics.sndPktNum/(double)ic_statistics.sndSyscallNum),
+			(ic_statistics.recvSyscallNum == 0 ? 0 : (double)ic_statistics.recvSyscallPktNum/(double)ic_statistics.recvSyscallNum));
 
 	ic_control_info.isSender = false;
 	memset(&ic_statistics, 0, sizeof(ICStatistics));
@@ -4363,6 +4554,122 @@ logPkt(char *prefix, icpkthdr *pkt)
 			pkt->flags);
 }
 
+/*
+ * renoOnAck
+ * 		Grow the congestion window, exponentially in slow start and by one
+ * 		packet per window afterwards.
+ */
+static void
+renoOnAck(MotionConn *conn, uint64 ackTime)
+{
+	if (snd_control_info.cwnd < snd_control_info.ssthresh)
+		snd_control_info.cwnd += 1;
+	else
+		snd_control_info.cwnd += 1/snd_control_info.cwnd;
+}
+
+/*
+ * renoOnLoss
+ * 		Halve the congestion window when receivers report lost packets.
+ */
+static void
+renoOnLoss(void)
+{
+	snd_control_info.ssthresh = Max(snd_control_info.cwnd/2, snd_control_info.minCwnd);
+	snd_control_info.cwnd = snd_control_info.ssthresh;
+}
+
+/*
+ * renoOnTimeout
+ * 		Restart from the minimal congestion window after packets expired.
+ */
+static void
+renoOnTimeout(void)
+{
+	snd_control_info.ssthresh = Max(snd_control_info.cwnd/2, snd_control_info.minCwnd);
+	snd_control_info.cwnd = snd_control_info.minCwnd;
+}
+
+/*
+ * The weight of a window in the estimated fraction of delayed acks, and the
+ * extra rtt over the minimal one of the connection which marks an ack as
+ * delayed by queueing. Peers are at different distances, so each ack is
+ * compared with the minimal rtt of its own connection.
+ */
+#define DCTCP_GAIN (1.0 / 16)
+#define DCTCP_DELAYED(conn, ackTime) ((ackTime) > 2 * (conn)->minRtt)
+
+/*
+ * dctcpOnAck
+ * 		DCTCP style congestion control.
+ *
+ * UDP sockets give no access to the ECN marks of the acks, so an ack is
+ * treated as marked if its rtt shows the packet waited in a queue as long
+ * as the minimal rtt. Once per window, the window is reduced in proportion
+ * to the estimated fraction of marked acks. Under incast this shrinks the
+ * windows of all the senders before the receiver's queues overflow, while
+ * reno only backs off after the losses and retransmits.
+ */
+static void
+dctcpOnAck(MotionConn *conn, uint64 ackTime)
+{
+	bool delayed = DCTCP_DELAYED(conn, ackTime);
+
+	snd_control_info.ackedInWindow++;
+	if (delayed)
+		snd_control_info.delayedInWindow++;
+	else
+		renoOnAck(conn, ackTime);
+
+	if (snd_control_info.ackedInWindow >= snd_control_info.cwnd)
+	{
+		float fraction = (float) snd_control_info.delayedInWindow / snd_control_info.ackedInWindow;
+
+		snd_control_info.alpha = snd_control_info.alpha * (1 - DCTCP_GAIN) + fraction * DCTCP_GAIN;
+		if (snd_control_info.delayedInWindow > 0)
+		{
+			snd_control_info.cwnd = Max(snd_control_info.cwnd * (1 - snd_control_info.alpha / 2), snd_control_info.minCwnd);
+			snd_control_info.ssthresh = snd_control_info.cwnd;
+		}
+
+		snd_control_info.ackedInWindow = 0;
+		snd_control_info.delayedInWindow = 0;
+	}
+}
+
+/*
+ * Number of packets that can be sent back to back after the sender was idle
+ * when pacing.
+ */
+#define PACING_BURST (4)
+
+/*
+ * pacingDelayed
+ * 		Whether the next packet has to wait to be sent at the pacing rate of
+ * 		one congestion window per rtt.
+ */
+static inline bool
+pacingDelayed(uint64 now)
+{
+	return now < snd_control_info.nextSendTime;
+}
+
+/*
+ * pacingSent
+ * 		Schedule the time of the next packet after a packet is sent.
+ */
+static inline void
+pacingSent(uint64 now)
+{
+	uint64 interval;
+
+	if (snd_control_info.srtt == 0 || snd_control_info.cwnd < 1)
+		return;
+
+	interval = (uint64) (snd_control_info.srtt / snd_control_info.cwnd);
+	snd_control_info.nextSendTime = Max(snd_control_info.nextSendTime, now - PACING_BURST * interval) + interval;
+}
+
 /*
  * handleAckedPacket
  * 		Called by sender to process acked packet.
@@ -4410,11 +4717,16 @@ handleAckedPacket(MotionConn *ackConn, ICBuffer *buf, uint64 now)
 	        	newDEV = Min(MAX_DEV, Max(newDEV, MIN_DEV));
 	        	buf->conn->dev = newDEV;
 
-	        	/* adjust the conjestion control window. */
-	        	if (snd_control_info.cwnd < snd_control_info.ssthresh)
-	        		snd_control_info.cwnd += 1;
+	        	/* rtt of all the connections, used by congestion control and pacing. */
+	        	if (snd_control_info.srtt == 0)
+	        		snd_control_info.srtt = ackTime;
 	        	else
-	        		snd_control_info.cwnd += 1/snd_control_info.cwnd;
+	        		snd_control_info.srtt = snd_control_info.srtt - (snd_control_info.srtt >> RTT_SHIFT_COEFFICIENT) + (ackTime >> RTT_SHIFT_COEFFICIENT);
+	        	if (buf->conn->minRtt == 0 || ackTime < buf->conn->minRtt)
+	        		buf->conn->minRtt = Max(ackTime, 1);
+
+	        	/* adjust the conjestion control window. */
+	        	snd_control_info.cc->onAck(buf->conn, ackTime);
 	        	snd_control_info.cwnd = Min(snd_control_info.cwnd, snd_buffer_pool.maxCount);
 	        }
 		}
@@ -4785,6 +5097,94 @@ xmit_retry:
 }
 
 
+/*
+ * sendBatch
+ * 		Send a batch of packets of a connection.
+ *
+ * With sendmmsg(), the packets are passed to the kernel in one system call
+ * unless the socket buffer is full or the call is interrupted.
+ */
+static void
+sendBatch(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, ICBuffer **bufs, int count, MotionConn *conn)
+{
+#ifdef IC_USE_MMSG
+	struct mmsghdr	msgs[IC_MMSG_BATCH_SIZE];
+	struct iovec	iovs[IC_MMSG_BATCH_SIZE];
+	int				num = 0;
+	int				sent = 0;
+	int				i;
+
+	Assert(count <= IC_MMSG_BATCH_SIZE);
+
+	for (i = 0; i < count; i++)
+	{
+#ifdef USE_ASSERT_CHECKING
+		if (testmode_inject_fault(gp_udpic_dropxmit_percent))
+		{
+		#ifdef AMS_VERBOSE_LOGGING
+			write_log("THROW PKT with seq %d srcpid %d despid %d", bufs[i]->pkt->seq, bufs[i]->pkt->srcPid, bufs[i]->pkt->dstPid);
+		#endif
+			continue;
+		}
+#endif
+
+		iovs[num].iov_base = bufs[i]->pkt;
+		iovs[num].iov_len = bufs[i]->pkt->len;
+		memset(&msgs[num], 0, sizeof(struct mmsghdr));
+		msgs[num].msg_hdr.msg_name = &conn->peer;
+		msgs[num].msg_hdr.msg_namelen = conn->peer_len;
+		msgs[num].msg_hdr.msg_iov = &iovs[num];
+		msgs[num].msg_hdr.msg_iovlen = 1;
+		num++;
+	}
+
+	while (sent < num)
+	{
+		int n = sendmmsg(pEntry->txfd, msgs + sent, num - sent, 0);
+
+		if (n < 0)
+		{
+			if (errno == EINTR)
+				continue;
+
+			/* no space ? not an error, the rest packets will be retransmitted. */
+			if (errno == EAGAIN)
+				return;
+
+			ereport(ERROR, (errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+							errmsg("Interconnect error writing an outgoing packet: %m"),
+							errdetail("error during sendmmsg() call (error:%d).\n"
+									  "For Remote Connection: contentId=%d at %s",
+									  errno, conn->remoteContentId,
+									  conn->remoteHostAndPort)));
+			/* not reached */
+		}
+
+		ic_statistics.sndSyscallNum++;
+
+		for (i = sent; i < sent + n; i++)
+		{
+			if (msgs[i].msg_len != iovs[i].iov_len && DEBUG1 >= log_min_messages)
+				write_log("Interconnect error writing an outgoing packet [seq %d]: short transmit (given %d sent %d) during sendmmsg() call."
+					  "For Remote Connection: contentId=%d at %s", ((icpkthdr *) iovs[i].iov_base)->seq,
+					  (int) iovs[i].iov_len, (int) msgs[i].msg_len,
+					  conn->remoteContentId,
+					  conn->remoteHostAndPort);
+		}
+
+		sent += n;
+	}
+#else
+	int		i;
+
+	for (i = 0; i < count; i++)
+	{
+		sendOnce(transportStates, pEntry, bufs[i], conn);
+		ic_statistics.sndSyscallNum++;
+	}
+#endif
+}
+
 /*
  * handleStopMsgs
  *		handle stop messages.
@@ -4893,6 +5293,9 @@ handleStopMsgs(ChunkTransportState *transportStates, ChunkTransportStateEntry *p
 static void
 sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEntry, MotionConn *conn)
 {
+	ICBuffer   *batch[IC_MMSG_BATCH_SIZE];
+	int			batchCount = 0;
+
 	while (conn->capacity > 0 && icBufferListLength(&conn->sndQueue) > 0)
 	{
 		ICBuffer *buf = NULL;
@@ -4905,9 +5308,18 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 		if (conn->state == mcsSetupOutgoingConnection && icBufferListLength(&conn->unackQueue) >= 1)
 			break;
 
+		uint64 now = getCurrentTime();
+
+		/*
+		 * Like the congestion window, pacing never stops a connection without
+		 * outstanding packets, the acks of which trigger sending again.
+		 */
+		if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS && gp_interconnect_pacing
+				&& icBufferListLength(&conn->unackQueue) > 0 && pacingDelayed(now))
+			break;
+
 		buf = icBufferListPop(&conn->sndQueue);
 
-		uint64 now = getCurrentTime();
 		buf->sentTime = now;
 		buf->unackQueueRingSlot = -1;
 		buf->nRetry = 0;
@@ -4923,13 +5335,16 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 				unack_queue_ring.numSharedOutStanding++;
 
 			putIntoUnackQueueRing(&unack_queue_ring, buf, computeExpirationPeriod(buf->conn, buf->nRetry), now);
+
+			if (gp_interconnect_pacing)
+				pacingSent(now);
 		}
 
 		/*
-		 * Note the place of sendOnce here.
+		 * Note the place of sendBatch here.
 		 * If we send before appending it to the unack queue and
 		 * putting it into unack queue ring, and there is a
-		 * network error occurred in the sendOnce function, error
+		 * network error occurred in the sendBatch function, error
 		 * message will be output. In the time of error message output,
 		 * interrupts is potentially checked, if there is a pending query cancel,
 		 * it will lead to a dangled buffer (memory leak).
@@ -4938,7 +5353,7 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 		updateStats(TPE_DATA_PKT_SEND, conn, buf->pkt);
 #endif
 
-		sendOnce(transportStates, pEntry, buf, conn);
+		batch[batchCount++] = buf;
 		ic_statistics.sndPktNum++;
 
 #ifdef AMS_VERBOSE_LOGGING
@@ -4946,7 +5361,16 @@ sendBuffers(ChunkTransportState *transportStates, ChunkTransportStateEntry *pEnt
 #endif
 
 		buf->conn->sentSeq = buf->pkt->seq;
+
+		if (batchCount == IC_MMSG_BATCH_SIZE)
+		{
+			sendBatch(transportStates, pEntry, batch, batchCount, conn);
+			batchCount = 0;
+		}
 	}
+
+	if (batchCount > 0)
+		sendBatch(transportStates, pEntry, batch, batchCount, conn);
 }
 
 /*
@@ -5130,10 +5554,7 @@ handleAckForDisorderPkt(ChunkTransportState *transportStates, ChunkTransportStat
 		}
 	}
 	if (Gp_interconnect_fc_method == INTERCONNECT_FC_METHOD_LOSS)
-	{
-		snd_control_info.ssthresh = Max(snd_control_info.cwnd/2, snd_control_info.minCwnd);
-		snd_control_info.cwnd = snd_control_info.ssthresh;
-	}
+		snd_control_info.cc->onLoss();
 #ifdef AMS_VERBOSE_LOGGING
 	write_log("After DISORDER: sndQ %d unackQ %d", icBufferListLength(&conn->sndQueue), icBufferListLength(&conn->unackQueue));
 	if (gp_log_interconnect >= GPVARS_VERBOSITY_DEBUG)
@@ -5273,10 +5694,7 @@ checkExpiration(ChunkTransportState *transportStates, ChunkTransportStateEntry *
 	 */
 	unack_queue_ring.currentTime = now - (now % TIMER_SPAN);
 	if (retransmits > 0 )
-	{
-		snd_control_info.ssthresh = Max(snd_control_info.cwnd/2, snd_control_info.minCwnd);
-		snd_control_info.cwnd = snd_control_info.minCwnd;
-	}
+		snd_control_info.cc->onTimeout();
 }
 
 /*
@@ -6219,6 +6637,198 @@ handleDataPacket(MotionConn *conn, icpkthdr *pkt, struct sockaddr_storage *peer,
 	return true;
 }
 
+/*
+ * dispatchRxPacket
+ * 		Hand a packet read by the first rx thread to the queue of another one.
+ *
+ * Wait while the queue is full, so the packets of a connection are never
+ * reordered. The packet buffer is freed if the interconnect is shutting down.
+ */
+static void
+dispatchRxPacket(int thread, icpkthdr *pkt, int len,
+				 struct sockaddr_storage *peer, socklen_t peerlen)
+{
+	RxWorkerQueue *queue = &ic_control_info.rxQueues[thread];
+	RxQueuedPacket *item;
+
+	pthread_mutex_lock(&queue->lock);
+	while (queue->count == RX_WORKER_QUEUE_SIZE &&
+		   !compare_and_swap_32(&ic_control_info.shutdown, 1, 1))
+		pthread_cond_wait(&queue->notFull, &queue->lock);
+
+	if (queue->count == RX_WORKER_QUEUE_SIZE)
+	{
+		pthread_mutex_unlock(&queue->lock);
+
+		pthread_mutex_lock(&ic_control_info.lock);
+		freeRxBuffer(&rx_buffer_pool, pkt);
+		pthread_mutex_unlock(&ic_control_info.lock);
+		return;
+	}
+
+	item = &queue->packets[(queue->head + queue->count) % RX_WORKER_QUEUE_SIZE];
+	item->pkt = pkt;
+	item->len = len;
+	item->peerlen = peerlen;
+	memcpy(&item->peer, peer, peerlen);
+	queue->count++;
+	gp_atomic_add_32(&ic_control_info.rxQueuedPackets, 1);
+	pthread_cond_signal(&queue->notEmpty);
+	pthread_mutex_unlock(&queue->lock);
+}
+
+/*
+ * wakeRxWorkerThreads
+ * 		Wake up the rx threads waiting on their queues to notice the shutdown.
+ */
+static void
+wakeRxWorkerThreads(void)
+{
+	int		i;
+
+	if (ic_control_info.rxQueues == NULL)
+		return;
+
+	pthread_cond_broadcast(&ic_control_info.rxBufferFreed);
+
+	for (i = 1; i < ic_control_info.numThreads; i++)
+	{
+		RxWorkerQueue *queue = &ic_control_info.rxQueues[i];
+
+		pthread_mutex_lock(&queue->lock);
+		pthread_cond_broadcast(&queue->notEmpty);
+		pthread_cond_broadcast(&queue->notFull);
+		pthread_mutex_unlock(&queue->lock);
+	}
+}
+
+/*
+ * waitForRxBuffer
+ * 		Wait for a buffer to go back to rx_buffer_pool, while all of them are
+ * 		in the queues of the other rx threads, for at most
+ * 		RX_THREAD_POLL_TIMEOUT ms.
+ *
+ * Called by the first rx thread, the same restrictions as rxThreadFunc()
+ * apply.
+ */
+static void
+waitForRxBuffer(void)
+{
+	struct timespec ts;
+
+#ifdef __darwin__
+	ts.tv_sec = 0;
+	ts.tv_nsec = RX_THREAD_POLL_TIMEOUT * 1000000L;
+#else
+	struct timeval tv;
+
+	gettimeofday(&tv, NULL);
+	ts.tv_sec = tv.tv_sec;
+	ts.tv_nsec = tv.tv_usec * 1000L + RX_THREAD_POLL_TIMEOUT * 1000000L;
+	if (ts.tv_nsec >= 1000000000L)
+	{
+		ts.tv_sec++;
+		ts.tv_nsec -= 1000000000L;
+	}
+#endif
+
+	pthread_mutex_lock(&ic_control_info.lock);
+	if (rx_buffer_pool.freeList == NULL &&
+		rx_buffer_pool.count > rx_buffer_pool.maxCount &&
+		ic_control_info.rxQueuedPackets > 0 &&
+		!compare_and_swap_32(&ic_control_info.shutdown, 1, 1))
+	{
+		ic_control_info.rxBufferWaiting = true;
+#ifdef __darwin__
+		pthread_cond_timedwait_relative_np(&ic_control_info.rxBufferFreed,
+										   &ic_control_info.lock, &ts);
+#else
+		pthread_cond_timedwait(&ic_control_info.rxBufferFreed,
+							   &ic_control_info.lock, &ts);
+#endif
+		ic_control_info.rxBufferWaiting = false;
+	}
+	pthread_mutex_unlock(&ic_control_info.lock);
+}
+
+/*
+ * rxWorkerThreadFunc
+ * 		Main function of the rx threads but the first one, arg is the queue
+ * 		the first thread hands their packets to.
+ *
+ * The same restrictions as rxThreadFunc() apply.
+ */
+static void *
+rxWorkerThreadFunc(void *arg)
+{
+	RxWorkerQueue *queue = (RxWorkerQueue *) arg;
+	RxQueuedPacket items[IC_MMSG_BATCH_SIZE];
+	icpkthdr   *dropped[IC_MMSG_BATCH_SIZE];
+
+	gp_set_thread_sigmasks();
+
+	for (;;)
+	{
+		int		n = 0;
+		int		ndropped = 0;
+		int		i;
+
+		pthread_mutex_lock(&queue->lock);
+		while (queue->count == 0 &&
+			   !compare_and_swap_32(&ic_control_info.shutdown, 1, 1))
+			pthread_cond_wait(&queue->notEmpty, &queue->lock);
+
+		if (compare_and_swap_32(&ic_control_info.shutdown, 1, 1))
+		{
+			pthread_mutex_unlock(&queue->lock);
+			break;
+		}
+
+		while (queue->count > 0 && n < IC_MMSG_BATCH_SIZE)
+		{
+			items[n++] = queue->packets[queue->head];
+			queue->head = (queue->head + 1) % RX_WORKER_QUEUE_SIZE;
+			queue->count--;
+		}
+		gp_atomic_add_32(&ic_control_info.rxQueuedPackets, -n);
+		pthread_cond_signal(&queue->notFull);
+		pthread_mutex_unlock(&queue->lock);
+
+		for (i = 0; i < n; i++)
+		{
+			if (!handleRxPacket(items[i].pkt, items[i].len,
+								&items[i].peer, items[i].peerlen))
+				dropped[ndropped++] = items[i].pkt;
+		}
+
+		if (ndropped > 0)
+		{
+			pthread_mutex_lock(&ic_control_info.lock);
+			for (i = 0; i < ndropped; i++)
+				freeRxBuffer(&rx_buffer_pool, dropped[i]);
+			pthread_mutex_unlock(&ic_control_info.lock);
+		}
+	}
+
+	if (DEBUG1 >= log_min_messages)
+		write_log("udp-ic: rx-thread shutting down");
+
+	/* Before retrun, we release the packets left in the queue. */
+	pthread_mutex_lock(&queue->lock);
+	pthread_mutex_lock(&ic_control_info.lock);
+	while (queue->count > 0)
+	{
+		freeRxBuffer(&rx_buffer_pool, queue->packets[queue->head].pkt);
+		queue->head = (queue->head + 1) % RX_WORKER_QUEUE_SIZE;
+		queue->count--;
+		gp_atomic_add_32(&ic_control_info.rxQueuedPackets, -1);
+	}
+	pthread_mutex_unlock(&ic_control_info.lock);
+	pthread_mutex_unlock(&queue->lock);
+
+	return NULL;
+}
+
 /*
  * rxThreadFunc
  * 		Main function of the receive background thread.
@@ -6230,11 +6840,23 @@ handleDataPacket(MotionConn *conn, icpkthdr *pkt, struct sockaddr_storage *peer,
  *		write_log("my brilliant log statement here.");
  *
  * NOTE: In threads, we cannot use palloc/pfree, because it's not thread safe.
+ *
+ * This is the only thread reading the listener socket. With several rx
+ * threads, it hands the packets of the other threads to their queues.
+ * The shutdown flag is not reset by the threads, as all of them check it.
  */
 static void *
 rxThreadFunc(void *arg)
 {
-	icpkthdr *pkt=NULL;
+	icpkthdr   *pkts[IC_MMSG_BATCH_SIZE];
+	struct sockaddr_storage peers[IC_MMSG_BATCH_SIZE];
+	socklen_t	peerlens[IC_MMSG_BATCH_SIZE];
+	int			lens[IC_MMSG_BATCH_SIZE];
+#ifdef IC_USE_MMSG
+	struct mmsghdr msgs[IC_MMSG_BATCH_SIZE];
+	struct iovec iovs[IC_MMSG_BATCH_SIZE];
+#endif
+	int			nbufs = 0;
 	bool	skip_poll=false;
 
 	gp_set_thread_sigmasks();
@@ -6243,10 +6865,11 @@ rxThreadFunc(void *arg)
 	{
 		struct pollfd nfd;
 		int		n;
+		int		i;
 
 		/* check shutdown condition*/
 
-		if (compare_and_swap_32(&ic_control_info.shutdown, 1, 0))
+		if (compare_and_swap_32(&ic_control_info.shutdown, 1, 1))
 		{
 			if (DEBUG1 >= log_min_messages)
 			{
@@ -6255,15 +6878,35 @@ rxThreadFunc(void *arg)
 			break;
 		}
 
-		/* Try to get a buffer */
-		if (pkt == NULL)
+		/*
+		 * Try to get buffers. Buffers beyond the first one are only taken
+		 * when the pool has spare ones, so that batching never starves the
+		 * receive queues.
+		 */
+		if (nbufs < IC_MMSG_BATCH_SIZE)
 		{
 			pthread_mutex_lock(&ic_control_info.lock);
-			pkt = getRxBuffer(&rx_buffer_pool);
+			while (nbufs < IC_MMSG_BATCH_SIZE)
+			{
+				if (nbufs > 0 && rx_buffer_pool.freeList == NULL &&
+					rx_buffer_pool.count >= rx_buffer_pool.maxCount)
+					break;
+
+				pkts[nbufs] = getRxBuffer(&rx_buffer_pool);
+				if (pkts[nbufs] == NULL)
+					break;
+				nbufs++;
+			}
 			pthread_mutex_unlock(&ic_control_info.lock);
 
-			if (pkt == NULL)
+			if (nbufs == 0)
 			{
+				/* the buffers are waiting in the queues of the other threads. */
+				if (ic_control_info.rxQueuedPackets > 0)
+				{
+					waitForRxBuffer();
+					continue;
+				}
 				setRxThreadError(ENOMEM);
 				continue;
 			}
@@ -6277,7 +6920,7 @@ rxThreadFunc(void *arg)
 
 			n = poll(&nfd, 1, RX_THREAD_POLL_TIMEOUT);
 
-			if (compare_and_swap_32(&ic_control_info.shutdown, 1, 0))
+			if (compare_and_swap_32(&ic_control_info.shutdown, 1, 1))
 			{
 				if (DEBUG1 >= log_min_messages)
 				{
@@ -6311,17 +6954,37 @@ rxThreadFunc(void *arg)
 			/* we've got something interesting to read */
 			/* handle incoming */
 			/* ready to read on our socket */
-			MotionConn *conn = NULL;
-			int read_count = 0;
+			int		read_num = 0;
+			int		kept = 0;
 
-			struct sockaddr_storage peer;
-			socklen_t peerlen;
+#ifdef IC_USE_MMSG
+			/* drain as many packets as we have buffers for in one call. */
+			for (i = 0; i < nbufs; i++)
+			{
+				iovs[i].iov_base = pkts[i];
+				iovs[i].iov_len = Gp_max_packet_size;
+				memset(&msgs[i], 0, sizeof(struct mmsghdr));
+				msgs[i].msg_hdr.msg_name = &peers[i];
+				msgs[i].msg_hdr.msg_namelen = sizeof(peers[i]);
+				msgs[i].msg_hdr.msg_iov = &iovs[i];
+				msgs[i].msg_hdr.msg_iovlen = 1;
+			}
 
-			peerlen = sizeof(peer);
-			read_count = recvfrom(UDP_listenerFd, (char *)pkt, Gp_max_packet_size, 0,
-								  (struct sockaddr *)&peer, &peerlen);
+			read_num = recvmmsg(UDP_listenerFd, msgs, nbufs, MSG_DONTWAIT, NULL);
+
+			for (i = 0; i < read_num; i++)
+			{
+				lens[i] = msgs[i].msg_len;
+				peerlens[i] = msgs[i].msg_hdr.msg_namelen;
+			}
+#else
+			peerlens[0] = sizeof(peers[0]);
+			lens[0] = recvfrom(UDP_listenerFd, (char *)pkts[0], Gp_max_packet_size, 0,
+							   (struct sockaddr *)&peers[0], &peerlens[0]);
+			read_num = lens[0] < 0 ? -1 : 1;
+#endif
 
-			if (compare_and_swap_32(&ic_control_info.shutdown, 1, 0))
+			if (compare_and_swap_32(&ic_control_info.shutdown, 1, 1))
 			{
 				if (DEBUG1 >= log_min_messages)
 				{
@@ -6330,10 +6993,7 @@ rxThreadFunc(void *arg)
 				break;
 			}
 
-			if (DEBUG5 >= log_min_messages)
-				write_log("received inbound len %d", read_count);
-
-			if (read_count < 0)
+			if (read_num < 0)
 			{
 				skip_poll = false;
 
@@ -6352,110 +7012,49 @@ rxThreadFunc(void *arg)
 				continue;
 			}
 
-			if (read_count < sizeof(icpkthdr))
-			{
-				if (DEBUG1 >= log_min_messages)
-					write_log("Interconnect error: short conn receive (%d)", read_count);
-				continue;
-			}
+			gp_atomic_add_32(&ic_statistics.recvSyscallNum, 1);
+			gp_atomic_add_32(&ic_statistics.recvSyscallPktNum, read_num);
 
 			/* when we get a "good" recvfrom() result, we can skip poll() until we get a bad one. */
 			skip_poll = true;
 
-			/* length must be >= 0 */
-			if (pkt->len < 0)
+			for (i = 0; i < read_num; i++)
 			{
-				if (DEBUG3 >= log_min_messages)
-					write_log("received inbound with negative length");
-				continue;
-			}
+				int		thread = 0;
 
-			if (pkt->len != read_count)
-			{
-				if (DEBUG3 >= log_min_messages)
-					write_log("received inbound packet [%d], short: read %d bytes, pkt->len %d", pkt->seq, read_count, pkt->len);
-				continue;
-			}
+				if (ic_control_info.numThreads > 1 && lens[i] >= sizeof(icpkthdr))
+					thread = CONN_HASH_VALUE(pkts[i]) % ic_control_info.numThreads;
 
-			/*
-			 * check the CRC of the payload.
-			 */
-			if (gp_interconnect_full_crc)
-			{
-				if (!checkCRC(pkt))
+				if (thread != 0)
 				{
-					gp_atomic_add_32(&ic_statistics.crcErrors, 1);
-					if (DEBUG2 >= log_min_messages)
-						write_log("received network data error, dropping bad packet, user data unaffected.");
-					continue;
+					dispatchRxPacket(thread, pkts[i], lens[i], &peers[i], peerlens[i]);
+					pkts[i] = NULL;
 				}
+				else if (handleRxPacket(pkts[i], lens[i], &peers[i], peerlens[i]))
+					pkts[i] = NULL;
 			}
 
-			#ifdef AMS_VERBOSE_LOGGING
-				logPkt("GOT MESSAGE", pkt);
-			#endif
-
-			AckSendParam param;
-			memset(&param, 0, sizeof(AckSendParam));
-
-			/*
-			 * Get the connection for the pkt.
-			 *
-			 * 	The connection hash table should be locked until
-			 * 	finishing the processing of the packet to avoid
-			 *  the connection addition/removal from the hash table
-			 *  during the mean time.
-			 */
-
-			pthread_mutex_lock(&ic_control_info.lock);
-			conn = findConnByHeader(&ic_control_info.connHtab, pkt);
-
-			if (conn != NULL)
+			/* compact the buffers which are not kept by the interconnect. */
+			for (i = 0; i < nbufs; i++)
 			{
-				/* Handling a regular packet */
-				if (handleDataPacket(conn, pkt, &peer, &peerlen, &param))
-					pkt = NULL;
-				ic_statistics.recvPktNum++;
+				if (pkts[i] != NULL)
+					pkts[kept++] = pkts[i];
 			}
-			else
-			{
-				/*
-				 * There may have two kinds of Mismatched packets:
-				 *    a) Past packets from previous command after I was torn down
-				 *    b) Future packets from current command before my connections are built.
-				 *
-				 * The handling logic is to "Ack the past and Nak the future".
-				 */
-				if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
-				{
-					if (DEBUG1 >= log_min_messages)
-						write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
-
-				#ifdef AMS_VERBOSE_LOGGING
-					logPkt("Got a Mismatched Packet", pkt);
-				#endif
-
-					if (handleMismatch(pkt, &peer, peerlen))
-						pkt = NULL;
-					ic_statistics.mismatchNum++;
-				}
-			}
-			pthread_mutex_unlock(&ic_control_info.lock);
-
-			/* real ack sending is after lock release to decrease the lock holding time. */
-			if (param.msg.len != 0)
-				sendAckWithParam(&param);
+			nbufs = kept;
 		}
 
 		/* pthread_yield(); */
 	}
 
-	/* Before retrun, we release the packet. */
-	if (pkt)
+	/* Before retrun, we release the packets. */
+	if (nbufs > 0)
 	{
+		int		i;
+
 		pthread_mutex_lock(&ic_control_info.lock);
-		freeRxBuffer(&rx_buffer_pool, pkt);
-		pkt = NULL;
+		for (i = 0; i < nbufs; i++)
+			freeRxBuffer(&rx_buffer_pool, pkts[i]);
+		nbufs = 0;
 		pthread_mutex_unlock(&ic_control_info.lock);
 	}
 
@@ -6463,6 +7062,116 @@ rxThreadFunc(void *arg)
 	return NULL;
 }
 
+/*
+ * handleRxPacket
+ * 		Called by rx thread to handle a packet read from the listener socket.
+ *
+ * Return true if the packet buffer is kept by the interconnect, the caller
+ * should not reuse it then.
+ */
+static bool
+handleRxPacket(icpkthdr *pkt, int read_count, struct sockaddr_storage *peer, socklen_t peerlen)
+{
+	MotionConn *conn = NULL;
+	bool		kept = false;
+
+	if (DEBUG5 >= log_min_messages)
+		write_log("received inbound len %d", read_count);
+
+	if (read_count < sizeof(icpkthdr))
+	{
+		if (DEBUG1 >= log_min_messages)
+			write_log("Interconnect error: short conn receive (%d)", read_count);
+		return false;
+	}
+
+	/* length must be >= 0 */
+	if (pkt->len < 0)
+	{
+		if (DEBUG3 >= log_min_messages)
+			write_log("received inbound with negative length");
+		return false;
+	}
+
+	if (pkt->len != read_count)
+	{
+		if (DEBUG3 >= log_min_messages)
+			write_log("received inbound packet [%d], short: read %d bytes, pkt->len %d", pkt->seq, read_count, pkt->len);
+		return false;
+	}
+
+	/*
+	 * check the CRC of the payload.
+	 */
+	if (gp_interconnect_full_crc)
+	{
+		if (!checkCRC(pkt))
+		{
+			gp_atomic_add_32(&ic_statistics.crcErrors, 1);
+			if (DEBUG2 >= log_min_messages)
+				write_log("received network data error, dropping bad packet, user data unaffected.");
+			return false;
+		}
+	}
+
+	#ifdef AMS_VERBOSE_LOGGING
+		logPkt("GOT MESSAGE", pkt);
+	#endif
+
+	AckSendParam param;
+	memset(&param, 0, sizeof(AckSendParam));
+
+	/*
+	 * Get the connection for the pkt.
+	 *
+	 * 	The connection hash table should be locked until
+	 * 	finishing the processing of the packet to avoid
+	 *  the connection addition/removal from the hash table
+	 *  during the mean time.
+	 */
+
+	pthread_mutex_lock(&ic_control_info.lock);
+	conn = findConnByHeader(&ic_control_info.connHtab, pkt);
+
+	if (conn != NULL)
+	{
+		/* Handling a regular packet */
+		if (handleDataPacket(conn, pkt, peer, &peerlen, &param))
+			kept = true;
+		ic_statistics.recvPktNum++;
+	}
+	else
+	{
+		/*
+		 * There may have two kinds of Mismatched packets:
+		 *    a) Past packets from previous command after I was torn down
+		 *    b) Future packets from current command before my connections are built.
+		 *
+		 * The handling logic is to "Ack the past and Nak the future".
+		 */
+		if ((pkt->flags & UDPIC_FLAGS_RECEIVER_TO_SENDER) == 0)
+		{
+			if (DEBUG1 >= log_min_messages)
+				write_log("mismatched packet received, seq %d, srcpid %d, dstpid %d, icid %d, sid %d", pkt->seq, pkt->srcPid, pkt->dstPid, pkt->icId, pkt->sessionId);
+
+		#ifdef AMS_VERBOSE_LOGGING
+			logPkt("Got a Mismatched Packet", pkt);
+		#endif
+
+			if (handleMismatch(pkt, peer, peerlen))
+				kept = true;
+			ic_statistics.mismatchNum++;
+		}
+	}
+	pthread_mutex_unlock(&ic_control_info.lock);
+
+	/* real ack sending is after lock release to decrease the lock holding time. */
+	if (param.msg.len != 0)
+		sendAckWithParam(&param);
+
+	return kept;
+}
+
 /*
  * handleMismatch
  * 		If the mismatched packet is from an old connection, we may need to
@@ -6941,8 +7650,16 @@ WaitInterconnectQuitUDP(void)
 
 	if (ic_control_info.threadCreated)
 	{
+		int		i;
+
+		/*
+		 * The dummy packet wakes up the rx thread polling the listener
+		 * socket, the others wait for packets on their queues.
+		 */
 		SendDummyPacket();
-		pthread_join(ic_control_info.threadHandle, NULL);
+		wakeRxWorkerThreads();
+		for (i = 0; i < ic_control_info.numThreads; i++)
+			pthread_join(ic_control_info.threadHandles[i], NULL);
 	}
 	ic_control_info.threadCreated = false;
 }
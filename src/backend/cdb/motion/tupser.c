@@ -1047,6 +1047,105 @@ DeserializeTuple(SerTupInfo * pSerInfo, StringInfo serialTup)
 	return htup;
 }
 
+/*
+ * Form a HeapTuple from the data of a serialized tuple, i.e. the contents of
+ * its chunks without their headers.
+ */
+static HeapTuple
+cvtSerialDataToHeapTup(StringInfo serData, SerTupInfo * pSerInfo)
+{
+	HeapTuple	htup;
+	TupSerHeader *tshp;
+	unsigned int	datalen;
+	unsigned int	nullslen;
+	unsigned int	hoff;
+	HeapTupleHeader t_data;
+	char *pos = (char *)serData->data;
+
+	tshp = (TupSerHeader *)pos;
+
+	if ((tshp->tuplen & MEMTUP_LEAD_BIT) != 0)
+	{
+		uint32 tuplen = memtuple_size_from_uint32(tshp->tuplen);
+		htup = (HeapTuple) palloc(tuplen);
+		memcpy(htup, pos, tuplen);
+
+		pos += TYPEALIGN(TUPLE_CHUNK_ALIGN,tuplen);
+	}
+	else
+	{
+		pos += sizeof(TupSerHeader);	
+		/* if the tuple had toasted elements we have to deserialize
+		 * the old slow way. */
+		if ((tshp->infomask & (HEAP_HASEXTERNAL | HEAP_HASEXTENDED)) != 0)
+		{
+			serData->cursor += sizeof(TupSerHeader);
+
+			return DeserializeTuple(pSerInfo, serData);
+		}
+
+		/* reconstruct lengths of null bitmap and data part */
+		if (tshp->infomask & HEAP_HASNULL)
+			nullslen = BITMAPLEN(tshp->natts);
+		else
+			nullslen = 0;
+
+		if (tshp->tuplen < sizeof(TupSerHeader) + nullslen)
+			ereport(ERROR, (errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
+							errmsg("Interconnect error: cannot convert chunks to a  heap tuple."),
+							errdetail("tuple len %d < nullslen %d + headersize (%d)",
+									  tshp->tuplen, nullslen, (int)sizeof(TupSerHeader))));
+
+		datalen = tshp->tuplen - sizeof(TupSerHeader) - TYPEALIGN(TUPLE_CHUNK_ALIGN, nullslen);
+
+		/* determine overhead size of tuple (should match heap_form_tuple) */
+		hoff = offsetof(HeapTupleHeaderData, t_bits) + TYPEALIGN(TUPLE_CHUNK_ALIGN, nullslen);
+		if (tshp->infomask & HEAP_HASOID)
+			hoff += sizeof(Oid);
+		hoff = MAXALIGN(hoff);
+
+		/* Allocate the space in one chunk, like heap_form_tuple */
+		htup = (HeapTuple)palloc(HEAPTUPLESIZE + hoff + datalen);
+
+		t_data = (HeapTupleHeader) ((char *)htup + HEAPTUPLESIZE);
+
+		/* make sure unused header fields are zeroed */
+		MemSetAligned(t_data, 0, hoff);
+
+		/* reconstruct the HeapTupleData fields */
+		htup->t_len = hoff + datalen;
+		ItemPointerSetInvalid(&(htup->t_self));
+		htup->t_data = t_data;
+
+		/* reconstruct the HeapTupleHeaderData fields */
+		ItemPointerSetInvalid(&(t_data->t_ctid));
+		HeapTupleHeaderSetNatts(t_data, tshp->natts);
+		t_data->t_infomask = tshp->infomask & ~HEAP_XACT_MASK;
+		t_data->t_infomask |= HEAP_XMIN_INVALID | HEAP_XMAX_INVALID;
+		t_data->t_hoff = hoff;
+
+		if (nullslen)
+		{
+			memcpy((void *)t_data->t_bits, pos, nullslen);
+			pos += TYPEALIGN(TUPLE_CHUNK_ALIGN,nullslen);
+		}
+
+		/* does the tuple descriptor expect an OID ? Note: we don't
+		 * have to set the oid itself, just the flag! (see heap_formtuple()) */
+		if (pSerInfo->tupdesc->tdhasoid)		/* else leave infomask = 0 */
+		{
+			t_data->t_infomask |= HEAP_HASOID;
+		}
+
+		/* and now the data proper (it would be nice if we could just
+		 * point our caller into our existing buffer in-place, but
+		 * we'll leave that for another day) */
+		memcpy((char *)t_data + hoff, pos, datalen);
+	}
+
+	return htup;
+}
+
 HeapTuple
 CvtChunksToHeapTup(TupleChunkList tcList, SerTupInfo * pSerInfo)
 {
@@ -1155,102 +1254,72 @@ CvtChunksToHeapTup(TupleChunkList tcList, SerTupInfo * pSerInfo)
 	/* we've finished with the TCList, free it now. */
 	clearTCList(NULL, tcList);
 
-	{
-		TupSerHeader *tshp;
-		unsigned int	datalen;
-		unsigned int	nullslen;
-		unsigned int	hoff;
-		HeapTupleHeader t_data;
-		char *pos = (char *)serData.data;
-
-		tshp = (TupSerHeader *)pos;
-
-		if ((tshp->tuplen & MEMTUP_LEAD_BIT) != 0)
-		{
-			uint32 tuplen = memtuple_size_from_uint32(tshp->tuplen);
-			htup = (HeapTuple) palloc(tuplen);
-			memcpy(htup, pos, tuplen);
-
-			pos += TYPEALIGN(TUPLE_CHUNK_ALIGN,tuplen);
-		}
-		else
-		{
-			pos += sizeof(TupSerHeader);	
-			/* if the tuple had toasted elements we have to deserialize
-			 * the old slow way. */
-			if ((tshp->infomask & (HEAP_HASEXTERNAL | HEAP_HASEXTENDED)) != 0)
-			{
-				serData.cursor += sizeof(TupSerHeader);
-
-				htup = DeserializeTuple(pSerInfo, &serData);
-
-				/* Free up memory we used. */
-				pfree(serData.data);
-				return htup;
-			}
-
-			/* reconstruct lengths of null bitmap and data part */
-			if (tshp->infomask & HEAP_HASNULL)
-				nullslen = BITMAPLEN(tshp->natts);
-			else
-				nullslen = 0;
-
-			if (tshp->tuplen < sizeof(TupSerHeader) + nullslen)
-				ereport(ERROR, (errcode(ERRCODE_GP_INTERCONNECTION_ERROR),
-								errmsg("Interconnect error: cannot convert chunks to a  heap tuple."),
-								errdetail("tuple len %d < nullslen %d + headersize (%d)",
-										  tshp->tuplen, nullslen, (int)sizeof(TupSerHeader))));
+	htup = cvtSerialDataToHeapTup(&serData, pSerInfo);
 
-			datalen = tshp->tuplen - sizeof(TupSerHeader) - TYPEALIGN(TUPLE_CHUNK_ALIGN, nullslen);
-
-			/* determine overhead size of tuple (should match heap_form_tuple) */
-			hoff = offsetof(HeapTupleHeaderData, t_bits) + TYPEALIGN(TUPLE_CHUNK_ALIGN, nullslen);
-			if (tshp->infomask & HEAP_HASOID)
-				hoff += sizeof(Oid);
-			hoff = MAXALIGN(hoff);
-
-			/* Allocate the space in one chunk, like heap_form_tuple */
-			htup = (HeapTuple)palloc(HEAPTUPLESIZE + hoff + datalen);
+	/* Free up memory we used. */
+	pfree(serData.data);
 
-			t_data = (HeapTupleHeader) ((char *)htup + HEAPTUPLESIZE);
+	return htup;
+}
 
-			/* make sure unused header fields are zeroed */
-			MemSetAligned(t_data, 0, hoff);
+/*
+ * Convert a run of TC_WHOLE and TC_EMPTY chunks, starting at *tcItem, into
+ * HeapTuples.
+ *
+ * Unlike CvtChunksToHeapTup(), the tuples are formed straight from the chunk
+ * data, without collecting the chunks into a list and copying them into a
+ * contiguous buffer first.  At most maxTuples chunks are converted and freed,
+ * and *tcItem is left at the first chunk which is not converted.  The total
+ * size of the converted chunks, including their headers, is added to
+ * *chunkBytes.
+ */
+int
+CvtWholeChunksToHeapTups(TupleChunkListItem *tcItem, SerTupInfo * pSerInfo,
+						 HeapTuple *tuples, int maxTuples, int *chunkBytes)
+{
+	int			ntuples = 0;
 
-			/* reconstruct the HeapTupleData fields */
-			htup->t_len = hoff + datalen;
-			ItemPointerSetInvalid(&(htup->t_self));
-			htup->t_data = t_data;
+	AssertArg(tcItem != NULL);
+	AssertArg(pSerInfo != NULL);
 
-			/* reconstruct the HeapTupleHeaderData fields */
-			ItemPointerSetInvalid(&(t_data->t_ctid));
-			HeapTupleHeaderSetNatts(t_data, tshp->natts);
-			t_data->t_infomask = tshp->infomask & ~HEAP_XACT_MASK;
-			t_data->t_infomask |= HEAP_XMIN_INVALID | HEAP_XMAX_INVALID;
-			t_data->t_hoff = hoff;
+	while (*tcItem != NULL && ntuples < maxTuples)
+	{
+		TupleChunkListItem item = *tcItem;
+		TupleChunkType tcType;
+		StringInfoData serData;
 
-			if (nullslen)
-			{
-				memcpy((void *)t_data->t_bits, pos, nullslen);
-				pos += TYPEALIGN(TUPLE_CHUNK_ALIGN,nullslen);
-			}
+		if (item->chunk_length < TUPLE_CHUNK_HEADER_SIZE)
+			elog(ERROR, "Received tuple-chunk of size %u; smaller than"
+				 " chunk header size %d!", item->chunk_length,
+				 TUPLE_CHUNK_HEADER_SIZE);
 
-			/* does the tuple descriptor expect an OID ? Note: we don't
-			 * have to set the oid itself, just the flag! (see heap_formtuple()) */
-			if (pSerInfo->tupdesc->tdhasoid)		/* else leave infomask = 0 */
-			{
-				t_data->t_infomask |= HEAP_HASOID;
-			}
+		GetChunkType(item, &tcType);
+		if (tcType == TC_EMPTY)
+		{
+			/*
+			 * the sender is indicating that there was a row with no
+			 * attributes: return a NULL tuple
+			 */
+			tuples[ntuples++] = heap_form_tuple(pSerInfo->tupdesc, pSerInfo->values, pSerInfo->nulls);
+		}
+		else if (tcType == TC_WHOLE)
+		{
+			/* The chunk data is only read, point at it in place. */
+			serData.data = GetChunkDataPtr(item) + TUPLE_CHUNK_HEADER_SIZE;
+			serData.len = item->chunk_length - TUPLE_CHUNK_HEADER_SIZE;
+			serData.maxlen = serData.len;
+			serData.cursor = 0;
 
-			/* and now the data proper (it would be nice if we could just
-			 * point our caller into our existing buffer in-place, but
-			 * we'll leave that for another day) */
-			memcpy((char *)t_data + hoff, pos, datalen);
+			tuples[ntuples++] = cvtSerialDataToHeapTup(&serData, pSerInfo);
 		}
-	}
+		else
+			break;
 
-	/* Free up memory we used. */
-	pfree(serData.data);
+		*chunkBytes += item->chunk_length;
+		*tcItem = item->p_next;
+		pfree(item);
+	}
 
-	return htup;
+	return ntuples;
 }
+
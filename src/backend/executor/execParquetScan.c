@@ -27,6 +27,7 @@
 #include "executor/executor.h"
 #include "nodes/execnodes.h"
 #include "cdb/cdbparquetam.h"
+#include "lib/stringinfo.h"
 
 static void
 InitParquetScanOpaque(ScanState *scanState)
@@ -78,6 +79,36 @@ FreeParquetScanOpaque(ScanState *scanState)
 }
 
 
+/*
+ * Report the row groups skipped by column chunk statistics for
+ * EXPLAIN ANALYZE.
+ */
+static void
+ParquetScanExplainEnd(PlanState *planstate, struct StringInfoData *buf)
+{
+	TableScanState *node = (TableScanState *)planstate;
+	ParquetScanOpaqueData *opaque = (ParquetScanOpaqueData *)node->opaque;
+	int64 scanned = node->rowGroupsScanned;
+	int64 skipped = node->rowGroupsSkipped;
+
+	/* The scan may not have been ended yet */
+	if (opaque != NULL &&
+		opaque->scandesc != NULL &&
+		opaque->scandesc->rowGroupFilter != NULL)
+	{
+		scanned += opaque->scandesc->rowGroupFilter->rowGroupsScanned;
+		skipped += opaque->scandesc->rowGroupFilter->rowGroupsSkipped;
+	}
+
+	if (scanned + skipped > 0)
+	{
+		appendStringInfo(buf,
+						 "Row groups skipped by statistics: " INT64_FORMAT
+						 " of " INT64_FORMAT ".\n",
+						 skipped, scanned + skipped);
+	}
+}
+
 TupleTableSlot *
 ParquetScanNext(ScanState *scanState)
 {
@@ -87,11 +118,13 @@ ParquetScanNext(ScanState *scanState)
 	Assert(node->opaque != NULL &&
 		   node->opaque->scandesc != NULL);
 
-	/* push down Bloom filter */
+	/* push down Bloom filter and join key ranges */
 	if (node->opaque->scandesc->rfState == NULL &&
 			scanState->runtimeFilter != NULL)
 	{
 		node->opaque->scandesc->rfState = scanState->runtimeFilter;
+		node->opaque->scandesc->rowGroupFilter = ParquetRowGroupFilter_AddRuntimeFilter(
+				node->opaque->scandesc->rowGroupFilter, scanState->runtimeFilter);
 	}
 	parquet_getnext(node->opaque->scandesc, node->ss.ps.state->es_direction, node->ss.ss_ScanTupleSlot);
 	return node->ss.ss_ScanTupleSlot;
@@ -117,6 +150,19 @@ BeginScanParquetRelation(ScanState *scanState)
 	/* push down Bloom filter */
 	node->opaque->scandesc->rfState = scanState->runtimeFilter;
 
+	/* skip row groups by checking scan quals against column statistics */
+	node->opaque->scandesc->rowGroupFilter = ParquetRowGroupFilter_Create(
+			scanState->ps.plan->qual,
+			RelationGetDescr(node->ss.ss_currentRelation));
+	node->opaque->scandesc->rowGroupFilter = ParquetRowGroupFilter_AddRuntimeFilter(
+			node->opaque->scandesc->rowGroupFilter, scanState->runtimeFilter);
+
+	if (scanState->ps.instrument &&
+		scanState->ps.cdbexplainfun == NULL)
+	{
+		scanState->ps.cdbexplainfun = ParquetScanExplainEnd;
+	}
+
 	node->opaque->scandesc->splits = scanState->splits;
 	node->ss.scan_state = SCAN_SCAN;
 }
@@ -132,6 +178,13 @@ EndScanParquetRelation(ScanState *scanState)
 	Assert(node->opaque != NULL &&
 		   node->opaque->scandesc != NULL);
 
+	ParquetRowGroupFilter *rowGroupFilter = node->opaque->scandesc->rowGroupFilter;
+	if (rowGroupFilter != NULL)
+	{
+		((TableScanState *)scanState)->rowGroupsScanned += rowGroupFilter->rowGroupsScanned;
+		((TableScanState *)scanState)->rowGroupsSkipped += rowGroupFilter->rowGroupsSkipped;
+	}
+
 	parquet_endscan(node->opaque->scandesc);
 
 	FreeParquetScanOpaque(scanState);
@@ -45,6 +45,9 @@
 #include <limits.h>
 
 #include "access/hash.h"
+#include "access/nbtree.h"
+#include "catalog/pg_am.h"
+#include "commands/defrem.h"
 #include "executor/execdebug.h"
 #include "executor/hashjoin.h"
 #include "executor/instrument.h"
@@ -52,6 +55,7 @@
 #include "executor/nodeHashjoin.h"
 #include "miscadmin.h"
 #include "parser/parse_expr.h"
+#include "utils/datum.h"
 #include "utils/memutils.h"
 #include "utils/lsyscache.h"
 #include "utils/debugbreak.h"
@@ -70,6 +74,9 @@ ExecHashTableExplainBatches(HashJoinTable   hashtable,
                             const char     *title);
 static void ExecHashTableReallocBatchData(HashJoinTable hashtable, int new_nbatch);
 static int ExecChoosePrimeNBuckets(int nbuckets);
+static RuntimeFilterKeyRange *ExecHashInitKeyRanges(List *hashOperators);
+static void ExecHashUpdateKeyRanges(HashJoinTable hashtable, ExprContext *econtext,
+									List *hashkeys);
 
 void ExecChooseHashTableSize(double ntuples, int tupwidth,
 						int *numbuckets,
@@ -129,6 +136,14 @@ MultiExecHash(HashState *node)
 	hashkeys = node->hashkeys;
 	econtext = node->ps.ps_ExprContext;
 
+	/* collect the value ranges of the join keys for the runtime filter */
+	if (hashtable->bloomfilter != NULL && hashtable->keyranges == NULL)
+	{
+		MemoryContext oldcxt = MemoryContextSwitchTo(hashtable->bloomfilterCtx);
+		hashtable->keyranges = ExecHashInitKeyRanges(hashtable->hjstate->hj_HashOperators);
+		MemoryContextSwitchTo(oldcxt);
+	}
+
 #ifdef FAULT_INJECTOR
     FaultInjector_InjectFaultIfSet(
     		MultiExecHashLargeVmem,
@@ -161,6 +176,8 @@ MultiExecHash(HashState *node)
 				InsertBloomFilter(node->hashtable->bloomfilter, hashvalue);
 				node->hashtable->bloomfilter->nInserted++;
 			}
+			if (hashtable->keyranges != NULL)
+				ExecHashUpdateKeyRanges(hashtable, econtext, hashkeys);
 		}
 
 		if (hashkeys_null)
@@ -192,6 +209,230 @@ MultiExecHash(HashState *node)
 	return NULL;
 }
 
+/*
+ * Set up the value ranges of the join keys. Only keys whose join operator
+ * compares two values of the same type in its default btree opclass get a
+ * range, the scan compares the range with values of the outer key.
+ */
+static RuntimeFilterKeyRange *
+ExecHashInitKeyRanges(List *hashOperators)
+{
+	RuntimeFilterKeyRange *ranges;
+	ListCell   *ho;
+	int			i = 0;
+
+	ranges = (RuntimeFilterKeyRange *)
+		palloc0(list_length(hashOperators) * sizeof(RuntimeFilterKeyRange));
+
+	foreach(ho, hashOperators)
+	{
+		Oid			hashop = lfirst_oid(ho);
+		RuntimeFilterKeyRange *range = &ranges[i++];
+		Oid			lefttype;
+		Oid			righttype;
+		Oid			opclass;
+		Oid			subtype;
+		Oid			cmpfunc;
+		int			strategy;
+		bool		recheck;
+
+		op_input_types(hashop, &lefttype, &righttype);
+		if (lefttype != righttype)
+			continue;
+
+		opclass = GetDefaultOpClass(lefttype, BTREE_AM_OID);
+		if (!OidIsValid(opclass) || !op_in_opclass(hashop, opclass))
+			continue;
+
+		get_op_opclass_properties(hashop, opclass, &strategy, &subtype, &recheck);
+		if (recheck || strategy != BTEqualStrategyNumber)
+			continue;
+
+		cmpfunc = get_opclass_proc(opclass, subtype, BTORDER_PROC);
+		if (!OidIsValid(cmpfunc))
+			continue;
+
+		range->valid = true;
+		range->typeId = lefttype;
+		get_typlenbyval(lefttype, &range->typlen, &range->typbyval);
+		fmgr_info(cmpfunc, &range->cmpProc);
+		if (hawq_hashjoin_runtimefilter_max_values > 0)
+			range->values = (Datum *)
+				palloc(hawq_hashjoin_runtimefilter_max_values * sizeof(Datum));
+		else
+			range->nvalues = -1;
+	}
+
+	return ranges;
+}
+
+/*
+ * Add the join key values of the inner tuple in econtext to the value
+ * ranges. The distinct values are kept sorted until there are more than
+ * hawq_hashjoin_runtimefilter_max_values of them.
+ */
+static void
+ExecHashUpdateKeyRanges(HashJoinTable hashtable, ExprContext *econtext,
+						List *hashkeys)
+{
+	MemoryContext oldContext;
+	ListCell   *hk;
+	int			i = 0;
+
+	oldContext = MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+
+	foreach(hk, hashkeys)
+	{
+		ExprState  *keyexpr = (ExprState *) lfirst(hk);
+		RuntimeFilterKeyRange *range = &hashtable->keyranges[i++];
+		Datum		keyval;
+		bool		isNull = false;
+		int			lo;
+		int			hi;
+
+		if (!range->valid)
+			continue;
+
+		keyval = ExecEvalExpr(keyexpr, econtext, &isNull, NULL);
+		if (isNull)
+			continue;
+
+		MemoryContextSwitchTo(hashtable->bloomfilterCtx);
+		if (!range->hasValue)
+		{
+			range->minValue = datumCopy(keyval, range->typbyval, range->typlen);
+			range->maxValue = datumCopy(keyval, range->typbyval, range->typlen);
+			range->hasValue = true;
+		}
+		else if (DatumGetInt32(FunctionCall2(&range->cmpProc, keyval, range->minValue)) < 0)
+		{
+			if (!range->typbyval)
+				pfree(DatumGetPointer(range->minValue));
+			range->minValue = datumCopy(keyval, range->typbyval, range->typlen);
+		}
+		else if (DatumGetInt32(FunctionCall2(&range->cmpProc, keyval, range->maxValue)) > 0)
+		{
+			if (!range->typbyval)
+				pfree(DatumGetPointer(range->maxValue));
+			range->maxValue = datumCopy(keyval, range->typbyval, range->typlen);
+		}
+
+		if (range->nvalues < 0)
+		{
+			MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+			continue;
+		}
+
+		/* binary search the position of the value */
+		lo = 0;
+		hi = range->nvalues;
+		while (lo < hi)
+		{
+			int			mid = (lo + hi) / 2;
+			int32		cmp = DatumGetInt32(FunctionCall2(&range->cmpProc,
+														  range->values[mid], keyval));
+
+			if (cmp == 0)
+			{
+				lo = -1;
+				break;
+			}
+			if (cmp < 0)
+				lo = mid + 1;
+			else
+				hi = mid;
+		}
+
+		if (lo >= 0)
+		{
+			if (range->nvalues == hawq_hashjoin_runtimefilter_max_values)
+			{
+				/* too many distinct values, keep the min/max only */
+				if (!range->typbyval)
+				{
+					for (int j = 0; j < range->nvalues; j++)
+						pfree(DatumGetPointer(range->values[j]));
+				}
+				pfree(range->values);
+				range->values = NULL;
+				range->nvalues = -1;
+			}
+			else
+			{
+				memmove(&range->values[lo + 1], &range->values[lo],
+						(range->nvalues - lo) * sizeof(Datum));
+				range->values[lo] = datumCopy(keyval, range->typbyval, range->typlen);
+				range->nvalues++;
+			}
+		}
+		MemoryContextSwitchTo(econtext->ecxt_per_tuple_memory);
+	}
+
+	MemoryContextSwitchTo(oldContext);
+}
+
+/*
+ * Copy the value ranges of the join keys of the hash table into the current
+ * memory context, for the runtime filter of the outer scan.
+ */
+RuntimeFilterKeyRange *
+ExecHashCopyKeyRanges(HashJoinTable hashtable)
+{
+	RuntimeFilterKeyRange *ranges;
+	int			nkeys = list_length(hashtable->hjstate->hj_HashOperators);
+
+	Assert(hashtable->keyranges != NULL);
+
+	ranges = (RuntimeFilterKeyRange *) palloc(nkeys * sizeof(RuntimeFilterKeyRange));
+	memcpy(ranges, hashtable->keyranges, nkeys * sizeof(RuntimeFilterKeyRange));
+	for (int i = 0; i < nkeys; i++)
+	{
+		RuntimeFilterKeyRange *range = &ranges[i];
+
+		if (!range->hasValue)
+		{
+			range->nvalues = -1;
+			range->values = NULL;
+			continue;
+		}
+		range->minValue = datumCopy(range->minValue, range->typbyval, range->typlen);
+		range->maxValue = datumCopy(range->maxValue, range->typbyval, range->typlen);
+		if (range->nvalues < 0)
+			continue;
+		range->values = (Datum *) palloc(Max(range->nvalues, 1) * sizeof(Datum));
+		for (int j = 0; j < range->nvalues; j++)
+			range->values[j] = datumCopy(hashtable->keyranges[i].values[j],
+										 range->typbyval, range->typlen);
+	}
+
+	return ranges;
+}
+
+/*
+ * Free the value ranges made by ExecHashCopyKeyRanges().
+ */
+void
+ExecHashFreeKeyRanges(RuntimeFilterKeyRange *ranges, int nkeys)
+{
+	for (int i = 0; i < nkeys; i++)
+	{
+		RuntimeFilterKeyRange *range = &ranges[i];
+
+		if (!range->hasValue)
+			continue;
+		if (!range->typbyval)
+		{
+			pfree(DatumGetPointer(range->minValue));
+			pfree(DatumGetPointer(range->maxValue));
+			for (int j = 0; j < range->nvalues; j++)
+				pfree(DatumGetPointer(range->values[j]));
+		}
+		if (range->values != NULL)
+			pfree(range->values);
+	}
+	pfree(ranges);
+}
+
 /* ----------------------------------------------------------------
  *		ExecInitHash
  *
@@ -328,6 +569,7 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 	hashtable = (HashJoinTable)palloc0(sizeof(HashJoinTableData));
 	hashtable->buckets = NULL;
 	hashtable->bloomfilter = NULL;
+	hashtable->keyranges = NULL;
 	hashtable->curbatch = 0;
 	hashtable->growEnabled = true;
 	hashtable->totalTuples = 0;
@@ -489,7 +731,7 @@ ExecHashTableCreate(HashState *hashState, HashJoinState *hjstate, List *hashOper
 		max_size = UpperPowerTwo(max_size);
 
 		int size = UpperPowerTwo(hjstate->estimatedInnerNum);
-		hashtable->bloomfilter = InitBloomFilter(min(size, max_size));
+		hashtable->bloomfilter = InitBloomFilter(Min((uint64_t) size, max_size));
 		MemoryContextSwitchTo(oldcxt);
 	}
 
@@ -853,9 +853,23 @@ CreateRuntimeFilterState(HashJoinState *hjstate, ProjectionInfo* projInfo)
 	}
 	rf->hashfunctions = (FmgrInfo *) palloc(i * sizeof(FmgrInfo));
 	memcpy(rf->hashfunctions, hjstate->hj_HashTable->hashfunctions, i*sizeof(FmgrInfo));
-	size_t size = offsetof(BloomFilterData, data) + hjstate->hj_HashTable->bloomfilter->data_size;
-	rf->bloomfilter = palloc0(size);
-	memcpy(rf->bloomfilter, hjstate->hj_HashTable->bloomfilter, size);
+	rf->bloomfilter = CopyBloomFilter(hjstate->hj_HashTable->bloomfilter);
+	if (hjstate->hj_HashTable->keyranges != NULL)
+	{
+		rf->keyranges = ExecHashCopyKeyRanges(hjstate->hj_HashTable);
+
+		/* the scan compares the ranges with the column of the outer key */
+		i = 0;
+		foreach(hk, hjstate->hj_OuterHashKeys)
+		{
+			Expr	   *keyexpr = ((ExprState *) lfirst(hk))->expr;
+
+			if (!IsA(keyexpr, Var) ||
+				((Var *) keyexpr)->vartype != rf->keyranges[i].typeId)
+				rf->keyranges[i].valid = false;
+			i++;
+		}
+	}
 	rf->hasRuntimeFilter = true;
 	rf->stopRuntimeFilter = false;
 	rf->checkedSamples = false;
@@ -906,7 +920,7 @@ ExecHashJoinOuterGetTuple(PlanState *outerNode,
 			&& !rf->stopRuntimeFilter && !rf->checkedSamples
 			&& rf->bloomfilter->nTested >= hawq_hashjoin_bloomfilter_sampling_number)
 	{
-		double real_ratio = (rf->bloomfilter->nMatched) / (rf->bloomfilter->nTested);
+		double real_ratio = (double) rf->bloomfilter->nMatched / rf->bloomfilter->nTested;
 		if(real_ratio > hawq_hashjoin_bloomfilter_ratio)
 		{
 			rf->stopRuntimeFilter = true;
@@ -27,6 +27,7 @@
 #include "executor/executor.h"
 #include "nodes/execnodes.h"
 #include "executor/nodeTableScan.h"
+#include "executor/nodeHash.h"
 #include "utils/elog.h"
 #include "parser/parsetree.h"
 
@@ -86,6 +87,10 @@ FreeScanRuntimefilterState(RuntimeFilterState* rfstate)
 			 bf->nTested == 0 ? 0 : (float)((float)(bf->nTested - bf->nMatched)/(float)(bf->nTested)));
 		DestroyBloomFilter(rfstate->bloomfilter);
 	}
+	if (rfstate->keyranges != NULL)
+	{
+		ExecHashFreeKeyRanges(rfstate->keyranges, list_length(rfstate->joinkeys));
+	}
 	if (rfstate->joinkeys != NIL)
 	{
 		list_free(rfstate->joinkeys);
@@ -54,6 +54,8 @@ static const struct{
 {
     {{"none", "false", "no", "off", "0", 0}, bfz_nothing_init},
     {{"zlib", 0}, bfz_zlib_init},
+    {{"lz4", 0}, bfz_lz4_init},
+    {{"snappy", 0}, bfz_snappy_init},
     {{0}}
 };
 
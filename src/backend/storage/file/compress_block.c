@@ -0,0 +1,374 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/* compress_block.c */
+
+#include "postgres.h"
+
+#include "c.h"
+#include <fcntl.h>
+#include <unistd.h>
+#include <lz4.h>
+#include <snappy-c.h>
+#include <storage/bfz.h>
+#include <storage/fd.h>
+
+/*
+ * This file implements the bfz compression algorithms "lz4" and "snappy".
+ *
+ * Unlike zlib, which compresses the file as one stream, every buffer passed
+ * to write_ex is compressed on its own and written as a frame:
+ *
+ *   uint32 raw size | uint32 stored size | stored data
+ *
+ * If compressing does not make the buffer smaller, the raw data is stored
+ * and the stored size equals the raw size. Since the frames are self
+ * contained, reading them back does not need the state of a stream, and
+ * the scan reads ahead several frames with one system call.
+ */
+
+typedef struct BfzBlockCodec
+{
+	/* The maximal size of the compressed data of rawSize bytes. */
+	int			(*bound) (int rawSize);
+
+	/* Return the size of the compressed data, or -1 if it failed. */
+	int			(*compress) (const char *src, int srcSize, char *dst, int dstCapacity);
+
+	/* Return the size of the decompressed data, or -1 if it is corrupted. */
+	int			(*decompress) (const char *src, int srcSize, char *dst, int dstCapacity);
+} BfzBlockCodec;
+
+typedef struct BfzBlockHeader
+{
+	uint32		rawSize;
+	uint32		storedSize;
+} BfzBlockHeader;
+
+/* Number of the largest frames read ahead by one read. */
+#define BFZ_BLOCK_READAHEAD 8
+
+struct bfz_block_freeable_stuff
+{
+	struct bfz_freeable_stuff super;
+	const BfzBlockCodec *codec;
+
+	/* Size of the largest frame, i.e. the header and the bound of a buffer. */
+	int			frameCapacity;
+
+	/* Frame being written, or the frames read ahead when scanning. */
+	char	   *frames;
+	int			framesCapacity;
+	int			framesBegin;
+	int			framesEnd;
+	bool		eof;
+
+	/* Decompressed data of a frame not yet returned by read_ex. */
+	char		block[BFZ_BUFFER_SIZE];
+	int			blockBegin;
+	int			blockEnd;
+};
+
+static int
+lz4_bound(int rawSize)
+{
+	return LZ4_compressBound(rawSize);
+}
+
+static int
+lz4_compress(const char *src, int srcSize, char *dst, int dstCapacity)
+{
+	int			size = LZ4_compress_default(src, dst, srcSize, dstCapacity);
+
+	return size > 0 ? size : -1;
+}
+
+static int
+lz4_decompress(const char *src, int srcSize, char *dst, int dstCapacity)
+{
+	int			size = LZ4_decompress_safe(src, dst, srcSize, dstCapacity);
+
+	return size >= 0 ? size : -1;
+}
+
+static int
+snappy_bound(int rawSize)
+{
+	return snappy_max_compressed_length(rawSize);
+}
+
+static int
+snappy_compress_block(const char *src, int srcSize, char *dst, int dstCapacity)
+{
+	size_t		size = dstCapacity;
+
+	if (snappy_compress(src, srcSize, dst, &size) != SNAPPY_OK)
+		return -1;
+	return size;
+}
+
+static int
+snappy_decompress_block(const char *src, int srcSize, char *dst, int dstCapacity)
+{
+	size_t		size;
+
+	if (snappy_uncompressed_length(src, srcSize, &size) != SNAPPY_OK ||
+		size > dstCapacity)
+		return -1;
+	if (snappy_uncompress(src, srcSize, dst, &size) != SNAPPY_OK)
+		return -1;
+	return size;
+}
+
+static const BfzBlockCodec lz4_codec = {lz4_bound, lz4_compress, lz4_decompress};
+static const BfzBlockCodec snappy_codec = {snappy_bound, snappy_compress_block, snappy_decompress_block};
+
+/*
+ * bfz_block_close_ex
+ *  Close a file and freeing up descriptor, buffers etc.
+ *
+ *  This is also called from an xact end callback, hence it should
+ *  not contain any elog(ERROR) calls.
+ */
+static void
+bfz_block_close_ex(bfz_t * thiz)
+{
+	struct bfz_block_freeable_stuff *fs = (void *) thiz->freeable_stuff;
+
+	gp_retry_close(thiz->fd);
+	thiz->fd = -1;
+	free(fs->frames);
+	free(fs);
+	thiz->freeable_stuff = NULL;
+}
+
+static void
+write_fully(bfz_t * thiz, const char *buffer, int size)
+{
+	while (size)
+	{
+		int			i = writeAndRetry(thiz->fd, buffer, size);
+
+		if (i < 0)
+			ereport(ERROR,
+					(errcode(ERRCODE_IO_ERROR),
+					errmsg("could not write to temporary file: %m")));
+		buffer += i;
+		size -= i;
+	}
+}
+
+static void
+bfz_block_write_ex(bfz_t * thiz, const char *buffer, int size)
+{
+	struct bfz_block_freeable_stuff *fs = (void *) thiz->freeable_stuff;
+
+	while (size)
+	{
+		BfzBlockHeader header;
+		int			storedSize;
+
+		header.rawSize = Min(size, BFZ_BUFFER_SIZE);
+		storedSize = fs->codec->compress(buffer, header.rawSize,
+										 fs->frames + sizeof(header),
+										 fs->frameCapacity - sizeof(header));
+		if (storedSize < 0 || storedSize >= header.rawSize)
+		{
+			storedSize = header.rawSize;
+			memcpy(fs->frames + sizeof(header), buffer, storedSize);
+		}
+		header.storedSize = storedSize;
+		memcpy(fs->frames, &header, sizeof(header));
+
+		write_fully(thiz, fs->frames, sizeof(header) + storedSize);
+
+		buffer += header.rawSize;
+		size -= header.rawSize;
+	}
+}
+
+/*
+ * Read ahead as many frames as fit into the frames buffer, keeping the
+ * part of a frame that has not been consumed yet.
+ */
+static void
+read_frames(bfz_t * thiz)
+{
+	struct bfz_block_freeable_stuff *fs = (void *) thiz->freeable_stuff;
+
+	memmove(fs->frames, fs->frames + fs->framesBegin, fs->framesEnd - fs->framesBegin);
+	fs->framesEnd -= fs->framesBegin;
+	fs->framesBegin = 0;
+
+	while (!fs->eof && fs->framesEnd < fs->framesCapacity)
+	{
+		int			i = readAndRetry(thiz->fd, fs->frames + fs->framesEnd,
+									 fs->framesCapacity - fs->framesEnd);
+
+		if (i < 0)
+			ereport(ERROR,
+					(errcode(ERRCODE_IO_ERROR),
+					errmsg("could not read from temporary file: %m")));
+		if (i == 0)
+			fs->eof = true;
+		fs->framesEnd += i;
+	}
+}
+
+/*
+ * Decompress the next frame into dst, which has room for at least
+ * BFZ_BUFFER_SIZE bytes. Returns 0 at the end of the file.
+ */
+static int
+read_next_frame(bfz_t * thiz, char *dst)
+{
+	struct bfz_block_freeable_stuff *fs = (void *) thiz->freeable_stuff;
+	BfzBlockHeader header;
+	const char *stored;
+	int			rawSize;
+
+	if (fs->framesEnd - fs->framesBegin < sizeof(header))
+		read_frames(thiz);
+	if (fs->framesEnd == fs->framesBegin)
+		return 0;
+	if (fs->framesEnd - fs->framesBegin < sizeof(header))
+		ereport(ERROR,
+				(errcode(ERRCODE_IO_ERROR),
+				errmsg("unexpected end of temporary file")));
+
+	memcpy(&header, fs->frames + fs->framesBegin, sizeof(header));
+	if (header.rawSize > BFZ_BUFFER_SIZE || header.storedSize > header.rawSize)
+		ereport(ERROR,
+				(errcode(ERRCODE_IO_ERROR),
+				errmsg("invalid block in temporary file: raw size %u, stored size %u",
+					   header.rawSize, header.storedSize)));
+
+	if (fs->framesEnd - fs->framesBegin < sizeof(header) + header.storedSize)
+	{
+		read_frames(thiz);
+		if (fs->framesEnd < sizeof(header) + header.storedSize)
+			ereport(ERROR,
+					(errcode(ERRCODE_IO_ERROR),
+					errmsg("unexpected end of temporary file")));
+	}
+
+	stored = fs->frames + fs->framesBegin + sizeof(header);
+	fs->framesBegin += sizeof(header) + header.storedSize;
+
+	if (header.storedSize == header.rawSize)
+	{
+		memcpy(dst, stored, header.rawSize);
+		return header.rawSize;
+	}
+
+	rawSize = fs->codec->decompress(stored, header.storedSize, dst, BFZ_BUFFER_SIZE);
+	if (rawSize != header.rawSize)
+		ereport(ERROR,
+				(errcode(ERRCODE_IO_ERROR),
+				errmsg("could not decompress block of temporary file")));
+
+	return rawSize;
+}
+
+static int
+bfz_block_read_ex(bfz_t * thiz, char *buffer, int size)
+{
+	struct bfz_block_freeable_stuff *fs = (void *) thiz->freeable_stuff;
+	int			orig_size = size;
+
+	while (size)
+	{
+		int			i;
+
+		if (fs->blockBegin < fs->blockEnd)
+		{
+			i = Min(size, fs->blockEnd - fs->blockBegin);
+			memcpy(buffer, fs->block + fs->blockBegin, i);
+			fs->blockBegin += i;
+		}
+		else if (size >= BFZ_BUFFER_SIZE)
+		{
+			/* The whole frame is wanted, decompress it in place. */
+			i = read_next_frame(thiz, buffer);
+			if (i == 0)
+				break;
+		}
+		else
+		{
+			fs->blockBegin = 0;
+			fs->blockEnd = read_next_frame(thiz, fs->block);
+			if (fs->blockEnd == 0)
+				break;
+			continue;
+		}
+		buffer += i;
+		size -= i;
+	}
+	return orig_size - size;
+}
+
+static void
+bfz_block_init(bfz_t * thiz, const BfzBlockCodec *codec)
+{
+	struct bfz_block_freeable_stuff *fs = malloc(sizeof *fs);
+
+	if (!fs)
+		ereport(ERROR,
+			(errcode(ERRCODE_OUT_OF_MEMORY),
+			 errmsg("out of memory")));
+
+	fs->codec = codec;
+	fs->frameCapacity = sizeof(BfzBlockHeader) + Max(codec->bound(BFZ_BUFFER_SIZE), BFZ_BUFFER_SIZE);
+	if (thiz->mode == BFZ_MODE_APPEND)
+		fs->framesCapacity = fs->frameCapacity;
+	else
+		fs->framesCapacity = fs->frameCapacity * BFZ_BLOCK_READAHEAD;
+	fs->frames = malloc(fs->framesCapacity);
+	if (!fs->frames)
+	{
+		free(fs);
+		ereport(ERROR,
+			(errcode(ERRCODE_OUT_OF_MEMORY),
+			 errmsg("out of memory")));
+	}
+	fs->framesBegin = fs->framesEnd = 0;
+	fs->eof = false;
+	fs->blockBegin = fs->blockEnd = 0;
+
+	thiz->freeable_stuff = &fs->super;
+	fs->super.read_ex = bfz_block_read_ex;
+	fs->super.write_ex = bfz_block_write_ex;
+	fs->super.close_ex = bfz_block_close_ex;
+
+#ifdef POSIX_FADV_SEQUENTIAL
+	if (thiz->mode == BFZ_MODE_SCAN)
+		(void) posix_fadvise(thiz->fd, 0, 0, POSIX_FADV_SEQUENTIAL);
+#endif
+}
+
+void
+bfz_lz4_init(bfz_t * thiz)
+{
+	bfz_block_init(thiz, &lz4_codec);
+}
+
+void
+bfz_snappy_init(bfz_t * thiz)
+{
+	bfz_block_init(thiz, &snappy_codec);
+}
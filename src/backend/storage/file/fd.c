@@ -64,10 +64,12 @@
 #include <sys/stat.h>
 #include <unistd.h>
 #include <fcntl.h>
+#include <pthread.h>
 
 #include "access/xact.h"
 #include "cdb/cdbfilerep.h"
 #include "cdb/cdbfilesystemcredential.h"
+#include "cdb/cdbgang.h"
 #include "cdb/cdbvars.h"
 #include "miscadmin.h"
 #include "storage/fd.h"
@@ -3699,6 +3701,121 @@ HdfsGetFileBlockLocations(const char *path, int64 length, int *block_num)
     return HdfsGetFileBlockLocations2(path, 0, length, block_num);
 }
 
+/*
+ * Files whose block locations are being fetched, handed out one by one to
+ * the backend and the fetch threads.
+ */
+typedef struct HdfsBlockLocationFetch
+{
+	hdfsFS	   *fs;
+	char	  **relative_paths;
+	const int64 *lengths;
+	BlockLocation **locations;
+	int		   *block_nums;
+	int			count;
+	int			next;
+	pthread_mutex_t lock;
+} HdfsBlockLocationFetch;
+
+static void
+HdfsFetchBlockLocations(HdfsBlockLocationFetch *fetch)
+{
+	while (true)
+	{
+		int i;
+
+		pthread_mutex_lock(&fetch->lock);
+		i = fetch->next < fetch->count ? fetch->next++ : -1;
+		pthread_mutex_unlock(&fetch->lock);
+
+		if (i < 0)
+			break;
+
+		if (fetch->fs[i] != NULL)
+			fetch->locations[i] = hdfsGetFileBlockLocations(fetch->fs[i],
+					fetch->relative_paths[i], 0, fetch->lengths[i],
+					&fetch->block_nums[i]);
+	}
+}
+
+static void *
+HdfsFetchBlockLocationsThread(void *arg)
+{
+	gp_set_thread_sigmasks();
+
+	HdfsFetchBlockLocations((HdfsBlockLocationFetch *) arg);
+	return NULL;
+}
+
+/*
+ * HdfsGetFileBlockLocationsParallel: fetch the block locations of count
+ * files with up to nthreads requests to the namenode in flight.
+ *
+ * The connections are looked up on the backend thread, the extra threads
+ * only call libhdfs3. On return locations[i] and block_nums[i] hold what
+ * HdfsGetFileBlockLocations() returns for paths[i]; locations[i] is NULL if
+ * the fetch failed.
+ */
+void
+HdfsGetFileBlockLocationsParallel(const char **paths, const int64 *lengths,
+		int count, int nthreads, BlockLocation **locations, int *block_nums)
+{
+	HdfsBlockLocationFetch fetch;
+	pthread_t  *threads;
+	int			nstarted = 0;
+	int			i;
+
+	if (count <= 0)
+		return;
+
+	fetch.fs = (hdfsFS *) palloc0(sizeof(hdfsFS) * count);
+	fetch.relative_paths = (char **) palloc0(sizeof(char *) * count);
+	fetch.lengths = lengths;
+	fetch.locations = locations;
+	fetch.block_nums = block_nums;
+	fetch.count = count;
+	fetch.next = 0;
+
+	for (i = 0; i < count; i++)
+	{
+		locations[i] = NULL;
+		block_nums[i] = 0;
+
+		fetch.relative_paths[i] = (char *) palloc(MAXPGPATH + 1);
+		if (NULL == ConvertToUnixPath(paths[i], fetch.relative_paths[i], MAXPGPATH + 1))
+			continue;
+		fetch.fs[i] = HdfsGetConnection(paths[i], false);
+	}
+
+	pthread_mutex_init(&fetch.lock, NULL);
+
+	nthreads = Min(nthreads, count) - 1;
+	threads = (pthread_t *) palloc(sizeof(pthread_t) * Max(nthreads, 1));
+	for (i = 0; i < nthreads; i++)
+	{
+		/* Just fetch with fewer threads if we cannot get one */
+		if (gp_pthread_create(&threads[nstarted], HdfsFetchBlockLocationsThread,
+							  &fetch, "HdfsGetFileBlockLocationsParallel") != 0)
+			break;
+		nstarted++;
+	}
+
+	HdfsFetchBlockLocations(&fetch);
+
+	for (i = 0; i < nstarted; i++)
+		pthread_join(threads[i], NULL);
+
+	pthread_mutex_destroy(&fetch.lock);
+
+	for (i = 0; i < count; i++)
+		pfree(fetch.relative_paths[i]);
+	pfree(fetch.relative_paths);
+	pfree(fetch.fs);
+	pfree(threads);
+
+	CHECK_FOR_INTERRUPTS();
+}
+
 /*
  *  TDE UDF
  *
@@ -23,7 +23,19 @@
 #include "lib/stringinfo.h"
 #include <assert.h>
 
-const static uint32_t HASH_SEEDS[8] = { 0x14EBCDFFU,
+/*
+ * The AVX2 probe is compiled for the target with a function attribute and
+ * only chosen at runtime if the CPU supports it, see FindBloomFilterBatch().
+ */
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define USE_AVX2_BLOOMFILTER 1
+#include <immintrin.h>
+#endif
+
+/* number of values whose buckets are prefetched ahead by a batch probe */
+#define BLOOMFILTER_PREFETCH_BATCH 16
+
+const static uint32_t HASH_SEEDS[8] __attribute__((aligned(32))) = { 0x14EBCDFFU,
         0x2A1C1A99U, 0x85CB78FBU, 0x6E8F82DDU, 0xF8464DFFU, 0x1028FEADU,
         0x74F04A4DU, 0x1832DB75U };
 
@@ -48,25 +60,50 @@ int64_t UpperPowerTwo(int64_t v) {
     return v;
 }
 
+/*
+ * Allocate a Bloom filter with the buckets aligned to a cache line.
+ */
+static BloomFilter AllocBloomFilter(size_t size)
+{
+    BloomFilter bf = palloc0(sizeof(BloomFilterData) + BLOOMFILTER_ALIGNMENT + size);
+    bf->data = (BUCKET *) TYPEALIGN(BLOOMFILTER_ALIGNMENT,
+                                    (char *) bf + sizeof(BloomFilterData));
+    bf->data_size = size;
+    return bf;
+}
+
 /*
  * Initialize a Bloom filter structure with the memory size of Bloom filter.
+ * The number of buckets is rounded up to a power of two.
  */
 BloomFilter InitBloomFilter(int memory_size)
 {
     BloomFilter bf;
-    uint32_t nBuckets = max(1, memory_size/(sizeof(BucketWord)*NUM_BUCKET_WORDS));
+    uint32_t nBuckets = UpperPowerTwo(Max(1, memory_size/(sizeof(BucketWord)*NUM_BUCKET_WORDS)));
     size_t size = nBuckets*NUM_BUCKET_WORDS*sizeof(BucketWord);
-    bf = palloc0(offsetof(BloomFilterData, data)  + size);
+    bf = AllocBloomFilter(size);
     bf->nInserted = bf->nTested = bf->nMatched = 0;
     bf->nBuckets = nBuckets;
     bf->data_mask = bf->nBuckets - 1;
-    bf->data_size = size;
     bf->isCreated = true;
     elog(DEBUG3, "Create a Bloom filter with number of buckets:%d, size:%d",
                  bf->nBuckets, size);
     return bf;
 }
 
+/*
+ * Copy a Bloom filter into the current memory context.
+ */
+BloomFilter CopyBloomFilter(BloomFilter bf)
+{
+    BloomFilter copy = AllocBloomFilter(bf->data_size);
+    BUCKET *data = copy->data;
+    memcpy(copy, bf, sizeof(BloomFilterData));
+    copy->data = data;
+    memcpy(copy->data, bf->data, bf->data_size);
+    return copy;
+}
+
 /*
  * Insert a value into Bloom filter.
  */
@@ -105,6 +142,121 @@ bool FindBloomFilter(BloomFilter bf, uint32_t value)
     return true;
 }
 
+/*
+ * Prefetch the buckets of values[0..n-1] and store their indexes in idx.
+ */
+static inline void PrefetchBloomFilterBuckets(BloomFilter bf,
+        const uint32_t *values, int n, uint32_t *idx)
+{
+    for (int i = 0; i < n; ++i)
+    {
+        idx[i] = getBucketIdx(values[i], bf->data_mask);
+        __builtin_prefetch(bf->data[idx[i]]);
+    }
+}
+
+static int FindBloomFilterBatchScalar(BloomFilter bf, const uint32_t *values,
+        int n, bool *found)
+{
+    uint32_t idx[BLOOMFILTER_PREFETCH_BATCH];
+    int nfound = 0;
+
+    for (int start = 0; start < n; start += BLOOMFILTER_PREFETCH_BATCH)
+    {
+        int count = Min(n - start, BLOOMFILTER_PREFETCH_BATCH);
+        PrefetchBloomFilterBuckets(bf, values + start, count, idx);
+        for (int j = 0; j < count; ++j)
+        {
+            uint32_t value = values[start + j];
+            bool match = true;
+            for (int i = 0; i < NUM_BUCKET_WORDS; ++i)
+            {
+                BucketWord hval = (HASH_SEEDS[i] * value) >> (32 - LOG_BUCKET_WORD_BITS);
+                if (!(bf->data[idx[j]][i] & (1U << hval)))
+                {
+                    match = false;
+                    break;
+                }
+            }
+            found[start + j] = match;
+            nfound += match;
+        }
+    }
+    return nfound;
+}
+
+#ifdef USE_AVX2_BLOOMFILTER
+/*
+ * The 8 bit masks of a value are computed and tested against its bucket
+ * with a single 256 bit operation each.
+ */
+__attribute__((target("avx2")))
+static int FindBloomFilterBatchAVX2(BloomFilter bf, const uint32_t *values,
+        int n, bool *found)
+{
+    uint32_t idx[BLOOMFILTER_PREFETCH_BATCH];
+    const __m256i seeds = _mm256_load_si256((const __m256i *) HASH_SEEDS);
+    const __m256i ones = _mm256_set1_epi32(1);
+    int nfound = 0;
+
+    for (int start = 0; start < n; start += BLOOMFILTER_PREFETCH_BATCH)
+    {
+        int count = Min(n - start, BLOOMFILTER_PREFETCH_BATCH);
+        PrefetchBloomFilterBuckets(bf, values + start, count, idx);
+        for (int j = 0; j < count; ++j)
+        {
+            __m256i hval = _mm256_srli_epi32(
+                    _mm256_mullo_epi32(seeds, _mm256_set1_epi32(values[start + j])),
+                    32 - LOG_BUCKET_WORD_BITS);
+            __m256i mask = _mm256_sllv_epi32(ones, hval);
+            __m256i bucket = _mm256_load_si256((const __m256i *) bf->data[idx[j]]);
+            bool match = _mm256_testc_si256(bucket, mask);
+            found[start + j] = match;
+            nfound += match;
+        }
+    }
+    return nfound;
+}
+#endif
+
+static int FindBloomFilterBatchChoose(BloomFilter bf, const uint32_t *values,
+        int n, bool *found);
+
+static int (*FindBloomFilterBatchImpl)(BloomFilter bf, const uint32_t *values,
+        int n, bool *found) = FindBloomFilterBatchChoose;
+
+/*
+ * Pick the probe implementation on the first call.
+ */
+static int FindBloomFilterBatchChoose(BloomFilter bf, const uint32_t *values,
+        int n, bool *found)
+{
+#ifdef USE_AVX2_BLOOMFILTER
+    if (__builtin_cpu_supports("avx2"))
+        FindBloomFilterBatchImpl = FindBloomFilterBatchAVX2;
+    else
+#endif
+        FindBloomFilterBatchImpl = FindBloomFilterBatchScalar;
+
+    return FindBloomFilterBatchImpl(bf, values, n, found);
+}
+
+/*
+ * Check whether values[0..n-1] are in this Bloom filter or not, found[i] is
+ * set for the values which may be in it. Returns the number of those.
+ *
+ * The buckets of a run of values are prefetched before they are tested, so
+ * the cache misses of a batch overlap instead of being paid one by one.
+ */
+int FindBloomFilterBatch(BloomFilter bf, const uint32_t *values, int n,
+        bool *found)
+{
+    int nfound = FindBloomFilterBatchImpl(bf, values, n, found);
+    bf->nTested += n;
+    bf->nMatched += nfound;
+    return nfound;
+}
+
 void PrintBloomFilter(BloomFilter bf)
 {
     StringInfo bfinfo = makeStringInfo();
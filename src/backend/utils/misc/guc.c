@@ -552,6 +552,7 @@ static char *gp_log_gang_str;
 static char *gp_log_interconnect_str;
 static char *gp_interconnect_type_str;
 static char *gp_interconnect_fc_method_str;
+static char *gp_interconnect_cc_method_str;
 
 /* should be static, but commands/variable.c needs to get at these */
 char	   *role_string;
@@ -741,6 +742,7 @@ double  locality_upper_bound;
 double  net_disk_ratio;
 double hawq_hashjoin_bloomfilter_ratio;
 int hawq_hashjoin_bloomfilter_sampling_number;
+int hawq_hashjoin_runtimefilter_max_values;
 bool		optimizer_cte_inlining;
 int		optimizer_cte_inlining_bound;
 double 	optimizer_damping_factor_filter;
@@ -1995,6 +1997,16 @@ static struct config_bool ConfigureNamesBool[] =
 		true, NULL, NULL
 	},
 
+	{
+		{"gp_parquet_enable_dictionary", PGC_USERSET, APPENDONLY_TABLES,
+			gettext_noop("Enable dictionary encoding of column chunks when inserting into parquet tables."),
+			gettext_noop("Column chunks fall back to plain encoding when the dictionary is not smaller."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&gp_parquet_enable_dictionary,
+		true, NULL, NULL
+	},
+
 	{
 		{"gp_enable_mk_sort", PGC_USERSET, QUERY_TUNING_METHOD,
 			gettext_noop("Enable multi-key sort."),
@@ -2017,6 +2029,17 @@ static struct config_bool ConfigureNamesBool[] =
 		true, NULL, NULL
 	},
 
+	{
+		{"gp_enable_mk_radix_sort", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Enable radix sort on normalized keys in multi-key sort."),
+			gettext_noop("Used for in-memory sorts whose first key is an integer, date, "
+						 "timestamp or, in C locale, text type."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&gp_enable_mk_radix_sort,
+		true, NULL, NULL
+	},
+
 
 #ifdef USE_ASSERT_CHECKING
 	{
@@ -2293,6 +2316,16 @@ static struct config_bool ConfigureNamesBool[] =
 		true, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_pacing", PGC_USERSET, GP_ARRAY_TUNING,
+			gettext_noop("Paces the packets sent by the UDP interconnect over the round trip time."),
+			gettext_noop("Only used by the loss based flow control."),
+            GUC_GPDB_ADDOPT
+		},
+		&gp_interconnect_pacing,
+		false, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_log_stats", PGC_USERSET, QUERY_TUNING_OTHER,
 			gettext_noop("Emit statistics from the UDP-IC at the end of every statement."),
@@ -5668,6 +5701,17 @@ static struct config_int ConfigureNamesInt[] =
         2, 1, 256, NULL, NULL
 	},
 
+	{
+		{"gp_interconnect_rx_threads", PGC_BACKEND, GP_ARRAY_TUNING,
+            gettext_noop("Sets the number of threads receiving packets in the UDP interconnect."),
+            gettext_noop("One thread reads the packets, the others check them in parallel but "
+                         "handle them under one lock, so more threads do not scale receive throughput yet."),
+            GUC_GPDB_ADDOPT
+        },
+        &Gp_interconnect_rx_threads,
+        1, 1, 16, NULL, NULL
+	},
+
 	{
 		{"gp_command_count", PGC_INTERNAL, CLIENT_CONN_OTHER,
 			gettext_noop("Shows the number of commands received from the client in this session."),
@@ -5749,6 +5793,16 @@ static struct config_int ConfigureNamesInt[] =
 		20000, 0, INT_MAX, NULL, NULL
 	},
 
+	{
+		{"gp_mk_sort_parallel_workers", PGC_USERSET, QUERY_TUNING_METHOD,
+			gettext_noop("Sets the number of extra threads used by an in-memory multi-key radix sort."),
+			gettext_noop("0 sorts on the backend's own thread only."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE | GUC_GPDB_ADDOPT
+		},
+		&gp_mk_sort_parallel_workers,
+		0, 0, 64, NULL, NULL
+	},
+
 	{
 		{"gp_interconnect_setup_timeout", PGC_USERSET, DEPRECATED_OPTIONS,
 			gettext_noop("Timeout (in seconds) on interconnect setup that occurs at query start"),
@@ -6435,6 +6489,16 @@ static struct config_int ConfigureNamesInt[] =
 			1, 1, 2 ,NULL, NULL
 	},
 
+	{
+		{"metadata_fetch_max_threads", PGC_USERSET, DEVELOPER_OPTIONS,
+			gettext_noop("Sets the maximum number of concurrent HDFS block location requests when planning a query."),
+			gettext_noop("0 or 1 fetches the block locations of one file at a time."),
+			GUC_NO_SHOW_ALL | GUC_NOT_IN_SAMPLE
+		},
+		&metadata_fetch_max_threads,
+		8, 0, 64, NULL, NULL
+	},
+
 	{
 		  {"hash_to_random_flag", PGC_USERSET, DEVELOPER_OPTIONS,
 				gettext_noop("Sets whether convert hash to random, 0: HASH_TO_RANDOM_BASEDON_DATALOCALITY, "
@@ -6731,6 +6795,16 @@ static struct config_int ConfigureNamesInt[] =
 		10000, 100, INT_MAX, NULL, NULL
 	},
 
+	{
+		{"hawq_hashjoin_runtimefilter_max_values", PGC_USERSET, PRESET_OPTIONS,
+			gettext_noop("Sets the maximum number of distinct join key values kept for the runtime filter of hash join."),
+			gettext_noop("Zero keeps only the min/max values of the join keys."),
+			GUC_NO_SHOW_ALL
+		},
+		&hawq_hashjoin_runtimefilter_max_values,
+		64, 0, 1024, NULL, NULL
+	},
+
 	/* End-of-list marker */
 	{
 		{NULL, 0, 0, NULL, NULL}, NULL, 0, 0, 0, NULL, NULL
@@ -7200,7 +7274,7 @@ static struct config_string ConfigureNamesString[] =
 	{
 		{"gp_workfile_compress_algorithm", PGC_USERSET, DEVELOPER_OPTIONS,
 			gettext_noop("Specify the compression algorithm that work files in the query executor use."),
-			gettext_noop("Valid values are \"NONE\", \"ZLIB\"."),
+			gettext_noop("Valid values are \"NONE\", \"ZLIB\", \"LZ4\", \"SNAPPY\"."),
 			GUC_GPDB_ADDOPT
 		},
 		&gp_workfile_compress_algorithm_str,
@@ -7969,6 +8043,16 @@ static struct config_string ConfigureNamesString[] =
 		"loss", gpvars_assign_gp_interconnect_fc_method, gpvars_show_gp_interconnect_fc_method
 	},
 
+	{
+		{"gp_interconnect_cc_method", PGC_USERSET, GP_ARRAY_TUNING,
+		 gettext_noop("Sets the congestion control method used by the loss based flow control of UDP interconnect."),
+		 gettext_noop("Valid values are \"reno\" and \"dctcp\"."),
+		 GUC_GPDB_ADDOPT
+		},
+		&gp_interconnect_cc_method_str,
+		"reno", gpvars_assign_gp_interconnect_cc_method, gpvars_show_gp_interconnect_cc_method
+	},
+
 	{
 		{"debug_dtm_action", PGC_SUSET, DEVELOPER_OPTIONS,
 			gettext_noop("Sets the debug DTM action."),
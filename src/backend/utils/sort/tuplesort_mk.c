@@ -137,6 +137,8 @@
 #include "utils/tuplesort.h"
 #include "utils/pg_locale.h"
 #include "utils/builtins.h"
+#include "utils/date.h"
+#include "utils/timestamp.h"
 #include "utils/tuplesort_mk.h"
 #include "utils/string_wrapper.h"
 #include "utils/faultinjector.h"
@@ -735,6 +737,27 @@ create_mksort_context(
             sinfo->typByVal = tbyv;
             sinfo->typLen = tlen;
         }
+
+        sinfo->normkeytype = MKNK_NONE;
+        if (sinfo->sortfnkind == SORTFUNC_CMP || sinfo->sortfnkind == SORTFUNC_REVCMP)
+        {
+            PGFunction cmp = sinfo->fmgrinfo.fn_addr;
+
+            if (cmp == btint2cmp)
+                sinfo->normkeytype = MKNK_INT16;
+            else if (cmp == btint4cmp || cmp == date_cmp)
+                sinfo->normkeytype = MKNK_INT32;
+            else if (cmp == btint8cmp)
+                sinfo->normkeytype = MKNK_INT64;
+#ifdef HAVE_INT64_TIMESTAMP
+            else if (cmp == timestamp_cmp)
+                sinfo->normkeytype = MKNK_INT64;
+#endif
+            else if (lc_collate_is_c() && cmp == bttextcmp)
+                sinfo->normkeytype = MKNK_TEXT;
+            else if (lc_collate_is_c() && cmp == bpcharcmp)
+                sinfo->normkeytype = MKNK_BPCHAR;
+        }
         sinfo->mkctxt = mkctxt;
     }
 }
@@ -1293,7 +1316,12 @@ tuplesort_performsort_mk(Tuplesortstate_mk *state)
              * amount of memory.  Just qsort 'em and we're done.
              */
             if(state->mkctxt.limit == 0)
-                mk_qsort(state->entries, state->entry_count, &state->mkctxt);
+            {
+                if (gp_enable_mk_radix_sort)
+                    mk_radixsort(state->entries, state->entry_count, &state->mkctxt);
+                else
+                    mk_qsort(state->entries, state->entry_count, &state->mkctxt);
+            }
             else
                 tuplesort_limit_sort(state);
 
@@ -3483,6 +3511,9 @@ tuplesort_inmem_nolimit_insert(Tuplesortstate_mk *state, MKEntry *entry)
 		state->mkctxt.estimatedExtraForPrep += estimateMaxPrepareSizeForEntry(&state->entries[state->entry_count],
 				&state->mkctxt);
 	}
+	/* The radix sort allocates an 8 byte normalized key for every entry */
+	if (gp_enable_mk_radix_sort && state->mkctxt.lvctxt[0].normkeytype != MKNK_NONE)
+		state->mkctxt.estimatedExtraForPrep += sizeof(uint64);
 	state->entry_count++;
 	state->numTuplesInMem++;
 
@@ -0,0 +1,466 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+/*
+ * tuplesort_mkradix.c
+ * 		Multi level key radix sort.
+ *
+ * Encode the first level datum of each entry into a binary-comparable 64 bit
+ * normalized key (sign-flipped integers, big endian prefix of C locale
+ * strings, inverted for descending order), and MSD radix sort the entries on
+ * it in place.  NULLs are moved to the end of the array they sort to before
+ * that.
+ *
+ * Only runs of entries with equal normalized keys still need comparisons:
+ * for integer keys these are real ties and are sorted on the remaining levels,
+ * for string prefixes the run is handed back to mk_qsort at the first level.
+ *
+ * The radix sort itself only moves entries and keys around, so with
+ * gp_mk_sort_parallel_workers set the buckets of the first partition are
+ * sorted by several threads.  Everything that touches backend state (prepare,
+ * comparators, memory, interrupts) stays on the backend's own thread.
+ */
+
+#include "postgres.h"
+
+#include <pthread.h>
+
+#include "access/tuptoaster.h"
+#include "cdb/cdbgang.h"
+#include "cdb/cdbvars.h"
+#include "utils/tuplesort.h"
+#include "utils/tuplesort_mk.h"
+
+#include "miscadmin.h"
+#include "utils/memutils.h"
+
+/* Below this many entries mk_qsort is faster than the histogram passes */
+#define MK_RADIX_MIN_ENTRIES	1024
+
+#define MK_RADIX_BITS			8
+#define MK_RADIX_BUCKETS		(1 << MK_RADIX_BITS)
+#define MK_RADIX_MASK			(MK_RADIX_BUCKETS - 1)
+
+/* Buckets smaller than this are finished with an insertion sort */
+#define MK_RADIX_INSERTION		32
+
+/* Below this many entries the threads cost more than they save */
+#define MK_RADIX_PARALLEL_MIN_ENTRIES	(128 * 1024)
+#define MK_RADIX_MAX_WORKERS			64
+
+/* "True" length (not counting trailing blanks) of a BpChar */
+static inline int mk_radix_bctruelen(char *p, int len)
+{
+	int			i;
+
+	for (i = len - 1; i >= 0; i--)
+	{
+		if (p[i] != ' ')
+			break;
+	}
+	return i + 1;
+}
+
+/**
+ * Normalized key of a non null entry prepared at level 0.  Comparing two keys
+ * as unsigned integers orders them as the level comparator does, except that
+ * equal keys of a string type only mean equal prefixes.
+ */
+static uint64 mk_radix_normkey(MKEntry *e, MKLvContext *lvctxt)
+{
+	uint64		key = 0;
+
+	switch (lvctxt->normkeytype)
+	{
+		case MKNK_INT16:
+			key = ((uint64) (int64) DatumGetInt16(e->d)) ^ (UINT64CONST(1) << 63);
+			break;
+		case MKNK_INT32:
+			key = ((uint64) (int64) DatumGetInt32(e->d)) ^ (UINT64CONST(1) << 63);
+			break;
+		case MKNK_INT64:
+			key = ((uint64) DatumGetInt64(e->d)) ^ (UINT64CONST(1) << 63);
+			break;
+		case MKNK_TEXT:
+		case MKNK_BPCHAR:
+			{
+				char	   *p;
+				int			len;
+				void	   *toFree;
+				int			i;
+
+				varattrib_untoast_ptr_len(e->d, &p, &len, &toFree);
+				if (lvctxt->normkeytype == MKNK_BPCHAR)
+					len = mk_radix_bctruelen(p, len);
+
+				for (i = 0; i < (int) sizeof(uint64); i++)
+				{
+					key <<= 8;
+					if (i < len)
+						key |= (unsigned char) p[i];
+				}
+
+				if (toFree)
+					pfree(toFree);
+			}
+			break;
+		default:
+			Assert(!"Never reach here");
+	}
+
+	return lvctxt->sortfnkind == SORTFUNC_REVCMP ? ~key : key;
+}
+
+static inline bool mk_radix_key_exact(MKLvContext *lvctxt)
+{
+	return lvctxt->normkeytype == MKNK_INT16 ||
+		lvctxt->normkeytype == MKNK_INT32 ||
+		lvctxt->normkeytype == MKNK_INT64;
+}
+
+static inline void mk_radix_swap(MKEntry *a, uint64 *keys, int i, int j)
+{
+	MKEntry		tmp = a[i];
+	uint64		k = keys[i];
+
+	a[i] = a[j];
+	a[j] = tmp;
+	keys[i] = keys[j];
+	keys[j] = k;
+}
+
+static void mk_radix_insertion(MKEntry *a, uint64 *keys, int n)
+{
+	int			i;
+	int			j;
+
+	for (i = 1; i < n; i++)
+	{
+		MKEntry		tmp = a[i];
+		uint64		k = keys[i];
+
+		for (j = i; j > 0 && keys[j - 1] > k; j--)
+		{
+			a[j] = a[j - 1];
+			keys[j] = keys[j - 1];
+		}
+		a[j] = tmp;
+		keys[j] = k;
+	}
+}
+
+/**
+ * Partition a[0..n-1] in place on the first digit, starting at shift, that not
+ * all keys share (American flag sort).  Entries are swapped together with
+ * their keys, so every bucket is filled sequentially and no permutation pass
+ * is needed.  Fills count with the bucket sizes and returns the shift of the
+ * digit used, or -1 if all keys are equal.
+ */
+static int mk_radix_partition(MKEntry *a, uint64 *keys, int n, int shift, int *count)
+{
+	int			head[MK_RADIX_BUCKETS];
+	int			tail[MK_RADIX_BUCKETS];
+	int			offset;
+	int			b;
+	int			i;
+
+	/* Skip the digits all keys share */
+	while (true)
+	{
+		memset(count, 0, MK_RADIX_BUCKETS * sizeof(int));
+		for (i = 0; i < n; i++)
+			count[(keys[i] >> shift) & MK_RADIX_MASK]++;
+
+		if (count[(keys[0] >> shift) & MK_RADIX_MASK] < n)
+			break;
+		if (shift == 0)
+			return -1;
+		shift -= MK_RADIX_BITS;
+	}
+
+	offset = 0;
+	for (b = 0; b < MK_RADIX_BUCKETS; b++)
+	{
+		head[b] = offset;
+		offset += count[b];
+		tail[b] = offset;
+	}
+
+	/* Swap every entry straight into the next free slot of its bucket */
+	for (b = 0; b < MK_RADIX_BUCKETS; b++)
+	{
+		while (head[b] < tail[b])
+		{
+			int			d = (keys[head[b]] >> shift) & MK_RADIX_MASK;
+
+			if (d == b)
+				head[b]++;
+			else
+				mk_radix_swap(a, keys, head[b], head[d]++);
+		}
+	}
+
+	return shift;
+}
+
+/**
+ * In place MSD radix sort of a[0..n-1] on keys, starting at the digit at
+ * shift.  Worker threads must pass interruptible false: they may not touch
+ * any backend state.
+ */
+static void mk_radix_msd(MKEntry *a, uint64 *keys, int n, int shift, bool interruptible)
+{
+	int			count[MK_RADIX_BUCKETS];
+	int			offset;
+	int			b;
+
+	if (n < MK_RADIX_INSERTION)
+	{
+		mk_radix_insertion(a, keys, n);
+		return;
+	}
+
+	if (interruptible)
+		CHECK_FOR_INTERRUPTS();
+
+	shift = mk_radix_partition(a, keys, n, shift, count);
+	if (shift <= 0)
+		return;
+
+	offset = 0;
+	for (b = 0; b < MK_RADIX_BUCKETS; b++)
+	{
+		if (count[b] > 1)
+			mk_radix_msd(a + offset, keys + offset, count[b], shift - MK_RADIX_BITS, interruptible);
+		offset += count[b];
+	}
+}
+
+/*
+ * Buckets of the first partition, handed out to the backend thread and the
+ * worker threads largest first.
+ */
+typedef struct MKRadixParallel
+{
+	MKEntry    *a;
+	uint64	   *keys;
+	int			shift;		/* shift of the next digit within a bucket */
+	int			count[MK_RADIX_BUCKETS];
+	int			offset[MK_RADIX_BUCKETS];
+	int			order[MK_RADIX_BUCKETS];	/* bucket numbers, largest first */
+	int			norder;
+	int			next;		/* next position in order to hand out */
+	pthread_mutex_t lock;
+} MKRadixParallel;
+
+static MKRadixParallel *mk_radix_cmp_ctxt;
+
+static int mk_radix_bucket_cmp(const void *x, const void *y)
+{
+	int			cx = mk_radix_cmp_ctxt->count[*(const int *) x];
+	int			cy = mk_radix_cmp_ctxt->count[*(const int *) y];
+
+	return cx > cy ? -1 : (cx < cy ? 1 : 0);
+}
+
+static void mk_radix_sort_buckets(MKRadixParallel *par)
+{
+	while (true)
+	{
+		int			b;
+
+		pthread_mutex_lock(&par->lock);
+		b = par->next < par->norder ? par->order[par->next++] : -1;
+		pthread_mutex_unlock(&par->lock);
+
+		if (b < 0)
+			break;
+
+		mk_radix_msd(par->a + par->offset[b], par->keys + par->offset[b],
+					 par->count[b], par->shift, false);
+	}
+}
+
+static void *mk_radix_worker(void *arg)
+{
+	gp_set_thread_sigmasks();
+
+	mk_radix_sort_buckets((MKRadixParallel *) arg);
+	return NULL;
+}
+
+/**
+ * MSD radix sort with the buckets of the first partition sorted concurrently
+ * by the backend and up to nworkers threads.  The buckets are disjoint ranges
+ * of a and keys and sorting them needs no memory and no backend state, so the
+ * threads need no synchronization beyond taking the next bucket.  Interrupts
+ * are only checked once all threads are joined.
+ */
+static void mk_radix_msd_parallel(MKEntry *a, uint64 *keys, int n, int nworkers)
+{
+	MKRadixParallel par;
+	pthread_t	threads[MK_RADIX_MAX_WORKERS];
+	int			nthreads = 0;
+	int			offset;
+	int			b;
+	int			i;
+
+	par.shift = mk_radix_partition(a, keys, n, 64 - MK_RADIX_BITS, par.count);
+	if (par.shift <= 0)
+		return;
+	par.shift -= MK_RADIX_BITS;
+	par.a = a;
+	par.keys = keys;
+	par.norder = 0;
+	par.next = 0;
+
+	offset = 0;
+	for (b = 0; b < MK_RADIX_BUCKETS; b++)
+	{
+		par.offset[b] = offset;
+		offset += par.count[b];
+		if (par.count[b] > 1)
+			par.order[par.norder++] = b;
+	}
+
+	mk_radix_cmp_ctxt = &par;
+	qsort(par.order, par.norder, sizeof(int), mk_radix_bucket_cmp);
+
+	pthread_mutex_init(&par.lock, NULL);
+
+	nworkers = Min(Min(nworkers, MK_RADIX_MAX_WORKERS), par.norder - 1);
+	for (i = 0; i < nworkers; i++)
+	{
+		/* Just sort with fewer threads if we cannot get one */
+		if (gp_pthread_create(&threads[nthreads], mk_radix_worker, &par, "mk_radixsort") != 0)
+			break;
+		nthreads++;
+	}
+
+	mk_radix_sort_buckets(&par);
+
+	for (i = 0; i < nthreads; i++)
+		pthread_join(threads[i], NULL);
+
+	pthread_mutex_destroy(&par.lock);
+
+	CHECK_FOR_INTERRUPTS();
+}
+
+void mk_radixsort(MKEntry *a, int n, MKContext *ctxt)
+{
+	MKLvContext *lvctxt = ctxt->lvctxt;
+	bool		exact;
+	int			nullLeft;
+	int			nullRight;
+	int			left;
+	int			right;
+	int			nkeys;
+	int			i;
+	int			j;
+	uint64	   *keys;
+
+	if (n < MK_RADIX_MIN_ENTRIES ||
+		lvctxt->normkeytype == MKNK_NONE ||
+		(Size) n > MaxAllocSize / sizeof(uint64))
+	{
+		mk_qsort(a, n, ctxt);
+		return;
+	}
+
+	CHECK_FOR_INTERRUPTS();
+
+	mk_prepare_array(a, 0, n - 1, 0, ctxt);
+
+	/* Move NULLs to the end they sort to, they are not radix sorted */
+	left = 0;
+	right = n - 1;
+	if (lvctxt->nullfirst)
+	{
+		for (i = 0; i < n; i++)
+		{
+			if (mke_is_null(a + i))
+			{
+				MKEntry		tmp = a[i];
+
+				a[i] = a[left];
+				a[left++] = tmp;
+			}
+		}
+		nullLeft = 0;
+		nullRight = left - 1;
+	}
+	else
+	{
+		for (i = n - 1; i >= 0; i--)
+		{
+			if (mke_is_null(a + i))
+			{
+				MKEntry		tmp = a[i];
+
+				a[i] = a[right];
+				a[right--] = tmp;
+			}
+		}
+		nullLeft = right + 1;
+		nullRight = n - 1;
+	}
+
+	/* Radix sort the non null entries */
+	nkeys = right - left + 1;
+	exact = mk_radix_key_exact(lvctxt);
+	if (nkeys > 1)
+	{
+		keys = (uint64 *) palloc(nkeys * sizeof(uint64));
+		for (i = 0; i < nkeys; i++)
+			keys[i] = mk_radix_normkey(a + left + i, lvctxt);
+
+		if (gp_mk_sort_parallel_workers > 0 && nkeys >= MK_RADIX_PARALLEL_MIN_ENTRIES)
+			mk_radix_msd_parallel(a + left, keys, nkeys, gp_mk_sort_parallel_workers);
+		else
+			mk_radix_msd(a + left, keys, nkeys, 64 - MK_RADIX_BITS, true);
+
+		/*
+		 * Sort each run of equal keys with the comparators.  Integer ties are
+		 * equal at this level, so go on with the next level; if this is the
+		 * last level only a unique sort has something left to do.  String
+		 * ties only share a prefix and need the first level compared.
+		 */
+		for (i = 0; i < nkeys; i = j)
+		{
+			for (j = i + 1; j < nkeys && keys[j] == keys[i]; j++)
+				;
+
+			if (j - i < 2)
+				continue;
+
+			if (!exact)
+				mk_qsort_impl(a, left + i, left + j - 1, 0, false, ctxt, false);
+			else if (ctxt->total_lv > 1)
+				mk_qsort_impl(a, left + i, left + j - 1, 1, true, ctxt, false);
+			else if (ctxt->unique || ctxt->enforceUnique)
+				mk_qsort_impl(a, left + i, left + j - 1, 0, false, ctxt, false);
+		}
+
+		pfree(keys);
+	}
+
+	/* NULLs are all equal at this level, sort them on the remaining ones */
+	if (nullRight > nullLeft)
+		mk_qsort_impl(a, nullLeft, nullRight, 0, false, ctxt, false);
+}
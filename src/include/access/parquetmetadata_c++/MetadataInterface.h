@@ -35,7 +35,8 @@ typedef enum CompressionCodecName
 
 typedef enum Encoding
 {
-	PLAIN, GROUP_VAR_INT, PLAIN_DICTIONARY, RLE, BIT_PACKED
+	PLAIN, GROUP_VAR_INT, PLAIN_DICTIONARY, RLE, BIT_PACKED,
+	RLE_DICTIONARY = 8	/*dictionary indices, written by newer parquet writers*/
 } Encoding;// Encoding;
 
 typedef enum PrimitiveTypeName
@@ -102,6 +103,10 @@ typedef struct ColumnChunkMetadata_4C
 	int64_t file_offset;
 
 	int64_t firstDataPage;
+
+	/* Byte offset of the dictionary page, 0 if the column chunk has none */
+	int64_t dictionaryPageOffset;
+
 	long valueCount;
 
     /* total byte size of all compressed pages in this column chunk (including the headers) */
@@ -110,6 +115,14 @@ typedef struct ColumnChunkMetadata_4C
     /* total byte size of all uncompressed pages in this column chunk (including the headers) */
 	int64_t totalUncompressedSize;
 
+	/* statistics of this column chunk, used to skip row groups during scan */
+	int hasNullCount;
+	int64_t nullCount;
+	int hasMinMax;	/*min/max are only kept for fixed width types*/
+	int minMaxLen;	/*length of plain encoded min/max value, 4 or 8*/
+	uint8_t minValue[8];	/*plain encoded min value*/
+	uint8_t maxValue[8];	/*plain encoded max value*/
+
 } ColumnChunkMetadata_4C;
 
 /* rowgroup metadata */
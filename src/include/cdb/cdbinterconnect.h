@@ -222,6 +222,7 @@ struct MotionConn
 	uint32 consumedSeq;
 
 	uint64 rtt;
+	uint64 minRtt;	/* minimal rtt sample, 0 before the first ack */
 	uint64 dev;
 	uint64 deadlockCheckBeginTime;
 
@@ -52,6 +52,10 @@ void DestroyHdfsFileInfo(HdfsFileInfo *file_info);
 
 BlockLocation *GetHdfsFileBlockLocations(const HdfsFileInfo *file_info, uint64_t filesize, int *block_num, double *hit_ratio);
 
+bool HdfsFileBlockLocationsCached(const HdfsFileInfo *file_info, uint64_t filesize);
+
+BlockLocation *CacheHdfsFileBlockLocations(const HdfsFileInfo *file_info, uint64_t filesize, BlockLocation *hdfs_locations, int *block_num);
+
 void FreeHdfsFileBlockLocations(BlockLocation *locations, int block_num);
 
 void DumpHdfsFileBlockLocations(BlockLocation *locations, int block_num);
@@ -86,6 +86,8 @@ typedef struct ParquetScanDescData {
 	bool toCloseFile; // identify if it's ready to close segment file
 
 	RuntimeFilterState *rfState; /* Bloom filter */
+
+	ParquetRowGroupFilter *rowGroupFilter; /* skip row groups by statistics */
 } ParquetScanDescData;
 
 typedef ParquetScanDescData *ParquetScanDesc;
@@ -81,6 +81,32 @@ typedef struct ParquetColumnReader
     char                            *pageBuffer;
     int32                           pageBufferLen;
 
+    /*
+     * Dictionary page of the current column chunk. For uncompressed chunk,
+     * `dictionaryData` points into `dataBuffer`, otherwise it points to
+     * `dictionaryBuffer` which is reused accross row groups.
+     *
+     * Entries are decoded into `dictionary` on first use, since the plain
+     * decoding depends on the type the caller reads the column as.
+     */
+    uint8_t                         *dictionaryData;
+    char                            *dictionaryBuffer;
+    int32                           dictionaryBufferLen;
+    int                             dictionarySize;     /* number of entries */
+    Datum                           *dictionary;
+    int                             dictionaryCapacity; /* palloced size of dictionary */
+    bool                            dictionaryDecoded;
+
+    /*
+     * Values of the current page of a non-repeatable column, decoded all at
+     * once by ParquetColumnReader_prepareValues(). `pageInts` is scratch
+     * space for definition levels and dictionary indices of the page.
+     */
+    Datum                           *pageValues;
+    bool                            *pageNulls;
+    int                             *pageInts;
+    int                             pageValueCapacity;
+
 	/*buffer reused for embedded type, avoid palloc each time for each tuple*/
     void                            *geoval;
 } ParquetColumnReader;
@@ -93,6 +119,12 @@ extern void ParquetExecutorReadColumn(
 extern void ParquetColumnReader_readValue(ParquetColumnReader *columnReader,
 		Datum *value, bool *null, int hawqTypeID);
 
+extern int ParquetColumnReader_prepareValues(ParquetColumnReader *columnReader,
+		int hawqTypeID);
+
+extern void ParquetColumnReader_readValues(ParquetColumnReader *columnReader,
+		Datum *values, bool *nulls, int count);
+
 extern void ParquetColumnReader_readPoint(ParquetColumnReader readers[], Datum *value, bool *null);
 extern void ParquetColumnReader_readLSEG(ParquetColumnReader readers[], Datum *value, bool *null);
 extern void ParquetColumnReader_readPATH(ParquetColumnReader readers[], Datum *value, bool *null);
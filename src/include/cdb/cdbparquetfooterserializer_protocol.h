@@ -114,6 +114,7 @@ uint32_t readI16(CompactProtocol *prot, int16_t *i16);
 uint32_t readI32(CompactProtocol *prot, int32_t *i32);
 uint32_t readI64(CompactProtocol *prot, int64_t *i64);
 uint32_t readString(CompactProtocol *prot, char **str);
+uint32_t readBinary(CompactProtocol *prot, char **buf, int32_t *len);
 uint32_t skipType(CompactProtocol *prot, TType type);
 
 
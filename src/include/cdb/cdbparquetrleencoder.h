@@ -133,10 +133,11 @@ typedef struct RLEDecoder
     int rleValue;
 
     /*
-     * for bit-packed-run, we unpacked all values in a buffer
+     * for bit-packed-run, we unpack one group of 8 values at a time,
+     * since runs written by other writers may exceed 63 groups
      */
-    int bitpackBuffer[BITPACK_RUN_MAX_VALUE_COUNT];
-    int bitpackBufferSize;
+    int bitpackBuffer[8];
+    int bitpackBufferPos;
 
 } RLEDecoder;
 
@@ -174,4 +175,6 @@ extern void RLEDecoder_Init(RLEDecoder *decoder, int bitWidth, uint8_t *in, int
 
 extern int  RLEDecoder_ReadInt(RLEDecoder *decoder);
 
+extern void RLEDecoder_ReadInts(RLEDecoder *decoder, int *values, int count);
+
 #endif /* CDBPARQUETRLEENCODER_H_ */
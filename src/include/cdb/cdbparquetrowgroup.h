@@ -34,6 +34,10 @@
 #include "access/htup.h"
 #include "executor/tuptable.h"
 #include "nodes/execnodes.h"
+#include "access/skey.h"
+
+/* number of rows decoded at a time by ParquetRowGroupReader_ScanNextTuple */
+#define PARQUET_SCAN_BATCH_SIZE 1024
 
 typedef struct ParquetRowGroupReader
 {
@@ -43,10 +47,58 @@ typedef struct ParquetRowGroupReader
 	int					rowRead;
 	ParquetColumnReader	*columnReaders;
 	int					columnReaderCount;
+	/* rows decoded but not returned yet by ParquetRowGroupReader_ScanNextTuple */
+	Datum				**batchValues;
+	bool				**batchNulls;
+	int					batchRows;
+	int					batchRowIndex;
+	/* copies of the geometric values of the batch, reset for every batch */
+	MemoryContext		batchContext;
+	/* runtime filter result of the rows of the batch, if batchFiltered */
+	bool				batchFiltered;
+	bool				*batchPass;
+	uint32				*batchHashes;
 	/* synthetic system attributes */
 	ItemPointerData 	cdb_fake_ctid;
 } ParquetRowGroupReader;
 
+/*
+ * A scan qual of the form "column op constant", "column IS NULL" or
+ * "column IS NOT NULL", which can be checked against the statistics of
+ * a column chunk to skip the whole row group.
+ */
+typedef struct ParquetRowGroupFilterKey
+{
+	int				attno;			/* zero based hawq attribute number */
+	Oid				typeId;			/* type of the column */
+	bool			isNullTest;
+	NullTestType	nullTestType;	/* valid if isNullTest */
+	StrategyNumber	strategy;		/* btree strategy of the operator */
+	Datum			value;			/* the constant compared with */
+	FmgrInfo		cmpProc;		/* btree comparison of column and constant */
+} ParquetRowGroupFilterKey;
+
+typedef struct ParquetRowGroupFilter
+{
+	int							nkeys;
+	ParquetRowGroupFilterKey	*keys;
+	RuntimeFilterState			*rfState;	/* join key ranges of hash join */
+	int64						rowGroupsScanned;	/* row groups read */
+	int64						rowGroupsSkipped;	/* row groups skipped */
+} ParquetRowGroupFilter;
+
+/* Build row group filter from scan quals, NULL if no qual is usable */
+ParquetRowGroupFilter *
+ParquetRowGroupFilter_Create(
+	List					*quals,
+	TupleDesc				hawqTupleDesc);
+
+/* Also skip row groups by the join key ranges of a runtime filter */
+ParquetRowGroupFilter *
+ParquetRowGroupFilter_AddRuntimeFilter(
+	ParquetRowGroupFilter	*filter,
+	RuntimeFilterState		*rfState);
+
 /* read row group initialization*/
 void
 ParquetRowGroupReader_Init(
@@ -58,13 +110,26 @@ ParquetRowGroupReader_Init(
 bool ParquetRowGroupReader_GetRowGroupInfo(
     FileSplit split, ParquetStorageRead *storageRead,
     ParquetRowGroupReader *rowGroupReader, bool *projs, TupleDesc hawqTupleDesc,
-    int *hawqAttrToParquetColChunks, bool toCloseFile);
+    int *hawqAttrToParquetColChunks, bool toCloseFile,
+    ParquetRowGroupFilter *rowGroupFilter);
 
 /* Get contents of row group*/
 void
 ParquetRowGroupReader_GetContents(
 	ParquetRowGroupReader	*rowGroupReader);
 
+/* Get next batch of rows of current row group into column arrays*/
+int
+ParquetRowGroupReader_ScanNextBatch(
+	TupleDesc 				pqs_tupDesc,
+	ParquetRowGroupReader 	*rowGroupReader,
+	int						*hawqAttrToParquetColNum,
+	bool 					*projs,
+	int						natts,
+	int						maxRows,
+	Datum					**values,
+	bool					**nulls);
+
 /* Get next tuple of current row group*/
 bool
 ParquetRowGroupReader_ScanNextTuple(
@@ -95,6 +95,7 @@ typedef struct FileField_4C* ParquetFileField;
 #define DEFAULT_DATAPAGE_COUNT	1
 
 typedef struct ParquetDataPage_S    *ParquetDataPage;
+typedef struct ParquetDictionary_S  *ParquetDictionary;
 typedef struct ParquetColumnChunk_S *ParquetColumnChunk;
 typedef struct ParquetRowGroup_S    *ParquetRowGroup;
 
@@ -117,6 +118,18 @@ struct ParquetDataPage_S
 	uint8_t						*values_buffer;
     int                         values_buffer_capacity; /* palloced size for values_buffer */
 
+	/*
+	 * For dictionary encoded page, the dictionary index of each value in
+	 * values_buffer. Indices are bit-packed when the page is finalized, since
+	 * the bit width depends on the dictionary size at that time.
+	 */
+	int32_t						*dict_indices;
+	int							dict_index_count;
+	int							dict_index_capacity;
+
+	/* For read, decodes dictionary indices of a dictionary encoded page */
+	RLEDecoder					*dict_index_reader;
+
     /*
      * For write, this is the page data to write, may be compressed.
      * For read, this is the page data to read, may be decompressed.
@@ -136,6 +149,27 @@ struct ParquetDataPage_S
 	File 						parquetFile;
 };
 
+/*
+ * Distinct plain encoded values of a column chunk, which become the
+ * payload of the chunk's dictionary page. Entries are looked up through
+ * an open addressing hash table on the encoded bytes.
+ */
+struct ParquetDictionary_S
+{
+	uint8_t						*buffer;		/* plain encoded entries */
+	int							bufferLen;
+	int							bufferCapacity;
+
+	int							*entryOffsets;	/* offset of each entry in buffer */
+	int							*entryLens;
+	uint32						*entryHashes;
+	int							numEntries;
+	int							entryCapacity;
+
+	int							*slots;			/* entry number + 1, 0 for empty */
+	int							numSlots;		/* power of 2 */
+};
+
 struct ParquetColumnChunk_S
 {
 	ColumnChunkMetadata 		columnChunkMetadata;
@@ -164,6 +198,18 @@ struct ParquetColumnChunk_S
     char    					*compresstype;
     int     					compresslevel;
 
+	/* false if the column type has no min/max statistics, or a NaN was seen */
+	bool						collectMinMax;
+
+	/*
+	 * Dictionary of the column chunk. Values are added while `useDictionary`
+	 * is true; it is turned off for the rest of the chunk once the dictionary
+	 * outgrows a page or turns out not to save space.
+	 */
+	ParquetDictionary			dictionary;
+	bool						useDictionary;
+	int							dictionaryPageCount;	/* data pages encoded with dictionary */
+
 	File 						parquetFile;
 };
 
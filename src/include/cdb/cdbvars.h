@@ -437,6 +437,29 @@ extern int Gp_interconnect_fc_method;
 extern const char *gpvars_assign_gp_interconnect_fc_method(const char *newval, bool doit, GucSource source __attribute__((unused)) );
 extern const char *gpvars_show_gp_interconnect_fc_method(void);
 
+/*
+ * Congestion control algorithms of the loss based flow control.
+ *
+ * reno:  slow start and additive increase, halve the window on losses.
+ * dctcp: like reno, but also shrink the window in proportion to the fraction
+ *        of acks delayed by queueing, before the queues overflow.
+ */
+#define INTERCONNECT_CC_METHOD_RENO  (0)
+#define INTERCONNECT_CC_METHOD_DCTCP (1)
+
+extern int Gp_interconnect_cc_method;
+
+extern const char *gpvars_assign_gp_interconnect_cc_method(const char *newval, bool doit, GucSource source __attribute__((unused)) );
+extern const char *gpvars_show_gp_interconnect_cc_method(void);
+
+/*
+ * Parameter gp_interconnect_pacing
+ *
+ * Spread the packets of a congestion window over a round trip time
+ * instead of sending them in bursts (loss based flow control only).
+ */
+extern bool gp_interconnect_pacing;
+
 /*
  * Parameter Gp_interconnect_queue_depth
  *
@@ -480,6 +503,18 @@ extern int 	Gp_udp_bufsize_k;
  */
 extern int	Gp_interconnect_hash_multiplier;
 
+/*
+ * Parameter Gp_interconnect_rx_threads
+ *
+ * The number of background threads receiving packets on the listener port.
+ * One thread reads the listener socket and hands the packets of each
+ * connection to the same thread, the others handle them.
+ *
+ * This guc is specific to the UDP-interconnect.
+ *
+ */
+extern int	Gp_interconnect_rx_threads;
+
 /*
  * Parameter gp_interconnect_aggressive_retry
  *
@@ -854,6 +889,8 @@ extern bool gp_enable_sort_distinct;
 /* Greenplum MK Sort */
 extern bool gp_enable_mk_sort;
 extern bool gp_enable_motion_mk_sort;
+extern bool gp_enable_mk_radix_sort;
+extern int gp_mk_sort_parallel_workers;
 
 #ifdef USE_ASSERT_CHECKING
 extern bool gp_mk_sort_check;
@@ -953,6 +990,11 @@ extern double hawq_hashjoin_bloomfilter_ratio;
  * hawq_hashjoin_bloomfilter_ratio, the remain tuples will not be checked by Bloom filter.
  */
 extern int hawq_hashjoin_bloomfilter_sampling_number;
+/*
+ * Maximum number of distinct join key values the hash join build side keeps
+ * for the runtime filter, besides the min/max values of the keys.
+ */
+extern int hawq_hashjoin_runtimefilter_max_values;
 
 /* Get statistics for partitioned parent from a child */
 extern bool 	gp_statistics_pullup_from_child_partition;
@@ -1149,6 +1191,7 @@ extern double metadata_cache_flush_ratio;
 extern double metadata_cache_reduce_ratio;
 
 extern char *metadata_cache_testfile;
+extern int metadata_fetch_max_threads;
 extern bool debug_fake_datalocality;
 extern bool datalocality_remedy_enable;
 extern bool get_tmpdir_from_rm;
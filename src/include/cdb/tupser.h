@@ -119,4 +119,8 @@ extern HeapTuple DeserializeTuple(SerTupInfo * pSerInfo, StringInfo serialTup);
  */
 extern HeapTuple CvtChunksToHeapTup(TupleChunkList tclist, SerTupInfo * pSerInfo);
 
+/* Convert a run of chunks each containing a whole tuple into HeapTuples. */
+extern int CvtWholeChunksToHeapTups(TupleChunkListItem *tcItem, SerTupInfo * pSerInfo,
+									HeapTuple *tuples, int maxTuples, int *chunkBytes);
+
 #endif   /* TUPSER_H */
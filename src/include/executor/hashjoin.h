@@ -169,6 +169,8 @@ typedef struct HashJoinTableData
 	struct HashJoinTupleData **buckets;
 
 	BloomFilter bloomfilter;
+	/* value ranges of the inner join keys, an array of nkeys entries */
+	struct RuntimeFilterKeyRange *keyranges;
 
 	/* buckets array is per-batch storage, as are all the tuples */
 
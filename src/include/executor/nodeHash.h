@@ -65,6 +65,8 @@ extern void ExecHashTableReset(HashState *hashState, HashJoinTable hashtable);
 extern void ExecHashTableExplainInit(HashState *hashState, HashJoinState *hjstate,
                                      HashJoinTable  hashtable);
 extern void ExecHashTableExplainBatchEnd(HashState *hashState, HashJoinTable hashtable);
+extern RuntimeFilterKeyRange *ExecHashCopyKeyRanges(HashJoinTable hashtable);
+extern void ExecHashFreeKeyRanges(RuntimeFilterKeyRange *ranges, int nkeys);
 
 enum 
 {
@@ -1495,6 +1495,29 @@ typedef enum
 	TableTypeInvalid,
 } TableType;
 
+/*
+ * Range of the values of one join key on the inner side of a hash join.
+ * 	valid: if the key type has a btree ordering, false means no range
+ * 	hasValue: if any inner row has a non-null key
+ * 	cmpProc: btree comparison function of the key type
+ * 	minValue, maxValue: smallest and largest key value
+ * 	nvalues: number of distinct key values, -1 if there are too many
+ * 	values: the distinct key values in ascending order
+ */
+typedef struct RuntimeFilterKeyRange
+{
+	bool valid;
+	bool hasValue;
+	Oid typeId;
+	int16 typlen;
+	bool typbyval;
+	FmgrInfo cmpProc;
+	Datum minValue;
+	Datum maxValue;
+	int nvalues;
+	Datum *values;
+} RuntimeFilterKeyRange;
+
 /*
  * Runtime filter information passed down to scan.
  * 	hasRuntimeFilter: if this runtime filter has a created Bloom filter
@@ -1502,6 +1525,7 @@ typedef enum
  * 	joinkeys: column position of join keys
  *	hashfunctions: hash functions to hash join key
  *	bloomfilter: BloomFilter instance
+ *	keyranges: value ranges of the join keys, NULL if unknown
  */
 typedef struct RuntimeFilterState
 {
@@ -1511,6 +1535,7 @@ typedef struct RuntimeFilterState
 	List* joinkeys;
 	FmgrInfo *hashfunctions;
 	BloomFilter bloomfilter;
+	RuntimeFilterKeyRange *keyranges;
 } RuntimeFilterState;
 
 /* ----------------
@@ -1931,6 +1956,13 @@ typedef struct TableScanState
 	 * Opaque data that is associated with different table type.
 	 */
 	void *opaque;
+
+	/*
+	 * Parquet row groups read and skipped by column chunk statistics
+	 * in the finished scans, reported by EXPLAIN ANALYZE.
+	 */
+	int64 rowGroupsScanned;
+	int64 rowGroupsSkipped;
 	
 } TableScanState;
 
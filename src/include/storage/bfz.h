@@ -86,6 +86,8 @@ typedef struct bfz
 extern void bfz_nothing_init(bfz_t * thiz);
 extern void bfz_zlib_init(bfz_t * thiz);
 extern void bfz_lzop_init(bfz_t * thiz);
+extern void bfz_lz4_init(bfz_t * thiz);
+extern void bfz_snappy_init(bfz_t * thiz);
 extern void bfz_write_ex(bfz_t * thiz, const char *buffer, int size);
 extern int	bfz_read_ex(bfz_t * thiz, char *buffer, int size);
 
@@ -205,6 +205,9 @@ extern BlockLocation *HdfsGetFileBlockLocations(const char *path, int64 lenght,
 
 extern BlockLocation *HdfsGetFileBlockLocations2(const char *path, int64 offset, int64 lenght, int *block_num);
 
+extern void HdfsGetFileBlockLocationsParallel(const char **paths, const int64 *lengths,
+		int count, int nthreads, BlockLocation **locations, int *block_nums);
+
 extern void HdfsFreeFileBlockLocations(BlockLocation *locations, int block_num);
 
 extern FileName FileGetName(File file);
@@ -27,6 +27,9 @@
  * The idea is to divide Bloom filter into several buckets(blocks), each value inserted
  * into the Bloom filter, will be hashed into one bucket. A bucket contains fixed-length bits.
  * This implementation refers to Impala's Bloom filter.
+ *
+ * A bucket is 32 bytes and the buckets start at a cache line boundary, so
+ * testing a value touches exactly one cache line.
  */
 #define NUM_BUCKET_WORDS 8
 typedef uint32_t BucketWord;
@@ -35,6 +38,8 @@ typedef BucketWord BUCKET[NUM_BUCKET_WORDS];
 /* log2(number of bits in a BucketWord) */
 #define LOG_BUCKET_WORD_BITS 5
 
+#define BLOOMFILTER_ALIGNMENT 64
+
 typedef struct BloomFilterData
 {
     bool     isCreated;
@@ -44,14 +49,17 @@ typedef struct BloomFilterData
     uint32_t nMatched;
     size_t   data_size;
     uint32_t data_mask;
-    BUCKET   data[1];
+    BUCKET   *data;     /* points into the same allocation, after the header */
 } BloomFilterData;
 typedef BloomFilterData *BloomFilter;
 
 extern int64_t UpperPowerTwo(int64_t v);
 extern BloomFilter InitBloomFilter(int memory_size);
+extern BloomFilter CopyBloomFilter(BloomFilter bf);
 extern void InsertBloomFilter(BloomFilter bf, uint32_t value);
 extern bool FindBloomFilter(BloomFilter bf, uint32_t value);
+extern int FindBloomFilterBatch(BloomFilter bf, const uint32_t *values, int n,
+                                bool *found);
 extern void PrintBloomFilter(BloomFilter bf);
 extern void DestroyBloomFilter(BloomFilter bf);
 
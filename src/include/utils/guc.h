@@ -480,6 +480,7 @@ extern char	   *pg_cloud_clustername;
  * keeping only one partition open at a time.
  */
 extern bool gp_parquet_insert_sort;
+extern bool gp_parquet_enable_dictionary;
 
 #if USE_EMAIL
 extern char  *gp_email_smtp_server;
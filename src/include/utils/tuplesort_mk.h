@@ -232,6 +232,20 @@ typedef enum MKLvType
     MKLV_TYPE_TEXT,  /* this level contains text values */
 } MKLvType;
 
+/*
+ * How the datums of a level can be encoded into a binary-comparable
+ * normalized key for the radix sort.
+ */
+typedef enum MKNormKeyType
+{
+    MKNK_NONE,       /* no normalized key, radix sort is not used */
+    MKNK_INT16,      /* int2 */
+    MKNK_INT32,      /* int4, date */
+    MKNK_INT64,      /* int8, timestamp, timestamptz */
+    MKNK_TEXT,       /* text, varchar in C collation, prefix only */
+    MKNK_BPCHAR,     /* char(n) in C collation, prefix only */
+} MKNormKeyType;
+
 typedef struct MKLvContext
 {
 	/* Is the type of datums in this level passed by value instead of reference */
@@ -243,6 +257,9 @@ typedef struct MKLvContext
     /* type of datums in this level, converted to our MKLvType enumeration */
     MKLvType lvtype;
 
+    /* normalized key encoding of this level, see tuplesort_mkradix.c */
+    MKNormKeyType normkeytype;
+
     SortFunctionKind sortfnkind;
     FmgrInfo fmgrinfo;
 
@@ -281,7 +298,8 @@ typedef struct MKContext {
 
 
     /* as calculated by estimateExtraSpace.  This is only valid before we've switched to buildruns mode
-     *   It is only calculate when the fetchForPrep fn is set as well
+     *   It is only calculate when the fetchForPrep fn is set as well, plus the normalized keys
+     *   of the radix sort when it is enabled for the first level
      */
     long estimatedExtraForPrep;
 
@@ -341,6 +359,9 @@ static inline void mk_qsort(MKEntry* a, int n, MKContext *ctxt)
     mk_qsort_impl(a, 0, n-1, 0, true, ctxt, false);
 }
 
+/* MK radix sort on normalized keys of the first level, see tuplesort_mkradix.c */
+extern void mk_radixsort(MKEntry *a, int n, MKContext *ctxt);
+
 /* MK Heap stuff */
 typedef bool (*MKFlagPtrReader) (void *ctxt, MKEntry *e);
 typedef struct MKHeapReader
@@ -16,6 +16,9 @@
  * limitations under the License.
  */
 
+#include <cstdio>
+#include <string>
+
 #include "gtest/gtest.h"
 
 #include "lib/data_gen.h"
@@ -130,3 +133,134 @@ TEST_F(TestParquet, TestPartition) {
   util.execute("insert into t4(a1,a2) values(generate_series(6,25),'F')");
   util.query("select * from t4", 25);
 }
+
+TEST_F(TestParquet, TestRowGroupStatistics) {
+  SQLUtility util;
+  util.execute("drop table if exists t5");
+  util.execute(
+      "create table t5 (a int, b float8, c timestamp, d text) "
+      "with(appendonly=true, orientation=parquet, pagesize=1024, "
+      "rowgroupsize=4096) distributed by (d)");
+  util.execute(
+      "insert into t5 select i, i * 0.5, '2016-01-01'::timestamp + i * "
+      "interval '1 minute', case when i > 90000 then null else 'x' end "
+      "from generate_series(1, 100000) i");
+  util.execute("insert into t5 values (null, 'NaN', null, null)");
+
+  // row groups skipped by min/max and null counts must not change results
+  util.query("select * from t5 where a < 100", 99);
+  util.query("select * from t5 where a <= 100", 100);
+  util.query("select * from t5 where a = 5000", 1);
+  util.query("select * from t5 where 5000 = a", 1);
+  util.query("select * from t5 where a > 99990", 10);
+  util.query("select * from t5 where a >= 99990", 11);
+  util.query("select * from t5 where a > 100000", 0);
+  util.query("select * from t5 where a::int8 > 99990", 10);
+  util.query("select * from t5 where b < 10", 19);
+  util.query("select * from t5 where a > 99990::int8", 10);
+  util.query("select * from t5 where b > 49999", 3);
+  util.query("select * from t5 where c < '2016-01-01 00:10:00'", 9);
+  util.query("select * from t5 where a is null", 1);
+  util.query("select * from t5 where d is null", 10001);
+  util.query("select * from t5 where d is not null and a > 90000", 0);
+
+  // a grows with the insert order, so all but the first row groups of a
+  // segment file are above 100
+  std::string result = util.getQueryResultSetString(
+      "explain analyze select * from t5 where a < 100");
+  const std::string label = "Row groups skipped by statistics: ";
+  long long skipped = 0, total = 0;
+  for (size_t pos = result.find(label); pos != std::string::npos;
+       pos = result.find(label, pos + 1)) {
+    long long n = 0, m = 0;
+    ASSERT_EQ(2, sscanf(result.c_str() + pos + label.size(), "%lld of %lld.",
+                        &n, &m)) << result;
+    skipped += n;
+    total += m;
+  }
+  EXPECT_GT(skipped, 0) << result;
+  EXPECT_LT(skipped, total) << result;
+  util.execute("drop table t5");
+}
+
+TEST_F(TestParquet, TestDictionaryEncoding) {
+  SQLUtility util;
+  util.execute("drop table if exists t6");
+  util.execute("drop table if exists t6_plain");
+  // low cardinality columns are dictionary encoded, column d outgrows its
+  // dictionary and falls back to plain encoding
+  std::string columns =
+      "(a int, b text, c varchar(10), d text, e float8) "
+      "with(appendonly=true, orientation=parquet, compresstype=snappy, "
+      "pagesize=4096, rowgroupsize=65536) distributed by (a)";
+  std::string values =
+      "select i, case when i % 7 = 0 then null else 'status_' || (i % 5) "
+      "end, (i % 3)::text, md5(i::text), (i % 4) * 0.25 "
+      "from generate_series(1, 20000) i";
+  util.execute("create table t6 " + columns);
+  util.execute("create table t6_plain " + columns);
+  util.execute("set gp_parquet_enable_dictionary = on; insert into t6 " +
+               values);
+  util.execute("set gp_parquet_enable_dictionary = off; insert into t6_plain " +
+               values);
+
+  util.query("select * from t6", 20000);
+  util.query("select * from t6 where b is null", 2857);
+  util.query("select * from t6 where b = 'status_3'", 3429);
+  util.query("select * from t6 except select * from t6_plain", 0);
+  util.query("select * from t6_plain except select * from t6", 0);
+  util.query(
+      "select b, c, count(*), sum(e) from t6 group by b, c order by b, c "
+      "limit 1",
+      "status_0|0|1143|429|\n");
+  util.execute("drop table t6");
+  util.execute("drop table t6_plain");
+}
+
+TEST_F(TestParquet, TestBatchScan) {
+  SQLUtility util;
+  util.execute("drop table if exists t7");
+  util.execute("drop table if exists t7_ao");
+  // small pages so that scan batches stop at page boundaries of columns
+  // with different value widths, geometric columns are decoded row by row
+  std::string columns =
+      "(a int, b int2, c int8, d float4, e date, f timestamp, g bool, "
+      "h macaddr, i numeric, j text, k point, l box, m polygon)";
+  std::string values =
+      "select i, case when i % 3 = 0 then null else (i % 100)::int2 end, "
+      "i * 1000000007, i / 8.0, '2016-01-01'::date + i % 365, "
+      "case when i % 11 = 0 then null "
+      "else '2016-01-01'::timestamp + i * interval '1 second' end, "
+      "i % 5 = 0, ('08:00:2b:01:02:' || lpad(to_hex(i % 256), 2, '0'))::macaddr, "
+      "case when i % 13 = 0 then null else i * 1.5 end, "
+      "case when i % 17 = 0 then null else repeat('x', i % 50) end, "
+      "case when i % 19 = 0 then null else point(i, i * 0.5) end, "
+      "box(point(i, i), point(i + 1, i * 2)), "
+      "case when i % 23 = 0 then null "
+      "else polygon(box(point(0, 0), point(i, i % 7))) end "
+      "from generate_series(1, 30000) i";
+  util.execute("create table t7 " + columns +
+               " with(appendonly=true, orientation=parquet, compresstype=gzip, "
+               "pagesize=2048, rowgroupsize=262144) distributed by (a)");
+  util.execute("create table t7_ao " + columns +
+               " with(appendonly=true) distributed by (a)");
+  util.execute("insert into t7 " + values);
+  util.execute("insert into t7_ao " + values);
+
+  util.query("select * from t7", 30000);
+  util.query("select * from t7 where b is null", 10000);
+  util.query("select * from t7 where f is null and j is null", 160);
+  // geometric types have no equality operator, compare their text
+  std::string compared = "a, b, c, d, e, f, g, h, i, j, k::text, l::text, m::text";
+  util.query("select " + compared + " from t7 except select " + compared +
+             " from t7_ao", 0);
+  util.query("select " + compared + " from t7_ao except select " + compared +
+             " from t7", 0);
+  util.query("select count(distinct h), sum(b), sum(i) from t7",
+             "256|990000|623108079.0|\n");
+  util.query("select count(distinct k::text), count(distinct l::text), "
+             "count(m) from t7",
+             "28422|30000|28696|\n");
+  util.execute("drop table t7");
+  util.execute("drop table t7_ao");
+}
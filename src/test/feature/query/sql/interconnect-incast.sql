@@ -0,0 +1,7 @@
+set gp_interconnect_type=udp;
+set gp_interconnect_fc_method=loss;
+set gp_interconnect_cc_method=dctcp;
+set gp_interconnect_pacing=on;
+show gp_interconnect_cc_method;
+select count(*), count(distinct c1), sum(length(c2)) from incast;
+select c1 % 10 as k, count(*) from incast group by 1 order by 1;
@@ -0,0 +1,9 @@
+set hawq_rm_stmt_nvseg=1;
+set hawq_rm_stmt_vseg_memory='16mb';
+set gp_workfile_type_hashjoin=bfz;
+set gp_workfile_compress_algorithm=lz4;
+show gp_workfile_compress_algorithm;
+select count(*), count(distinct b.c1), sum(length(b.c2)) from spill_build b, spill_probe p where b.c1 = p.c1;
+set gp_workfile_compress_algorithm=snappy;
+show gp_workfile_compress_algorithm;
+select count(*), count(distinct b.c1), sum(length(b.c2)) from spill_build b, spill_probe p where b.c1 = p.c1;
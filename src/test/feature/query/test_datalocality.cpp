@@ -0,0 +1,103 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "lib/sql_util.h"
+
+using hawq::test::SQLUtility;
+using std::string;
+
+class TestDataLocality: public ::testing::Test
+{
+	public:
+		TestDataLocality() {}
+		~TestDataLocality() {}
+};
+
+/*
+ * Block locations of unchanged segment files are served by the metadata
+ * cache, appending to a segment file makes its locations fetched again.
+ */
+TEST_F(TestDataLocality, TestMetadataCacheHit)
+{
+	SQLUtility util;
+	util.execute("drop table if exists t_dl");
+	util.execute("create table t_dl (a int, b text) with (appendonly=true) "
+	             "distributed randomly");
+	util.execute("insert into t_dl select i, 'row_' || i "
+	             "from generate_series(1, 10000) i");
+
+	/* the first query puts the block locations into the cache */
+	util.query("select * from t_dl", 10000);
+	string result = util.getQueryResultSetString(
+	    "explain analyze select count(*) from t_dl");
+	EXPECT_NE(string::npos, result.find("HDFS fetch files: 0"));
+
+	util.execute("insert into t_dl select i, 'row_' || i "
+	             "from generate_series(1, 10000) i");
+	result = util.getQueryResultSetString(
+	    "explain analyze select count(*) from t_dl");
+	EXPECT_EQ(string::npos, result.find("HDFS fetch files: 0"));
+	util.query("select * from t_dl", 20000);
+
+	util.execute("drop table t_dl");
+}
+
+/*
+ * Block locations of the segment files of a table are fetched concurrently
+ * when planning, the plan and the result are the same as fetching them one
+ * file at a time.
+ */
+TEST_F(TestDataLocality, TestParallelFetch)
+{
+	SQLUtility util;
+	util.execute("drop table if exists t_dl_fetch");
+	util.execute("create table t_dl_fetch (a int, b text) with (appendonly=true) "
+	             "distributed randomly");
+	/* one segment file per virtual segment */
+	util.execute("set enforce_virtual_segment_number = 4; "
+	             "insert into t_dl_fetch select i, 'row_' || i "
+	             "from generate_series(1, 10000) i");
+
+	util.execute("set metadata_cache_enable = off");
+	util.execute("set metadata_fetch_max_threads = 0");
+	string result = util.getQueryResultSetString(
+	    "explain analyze select count(*) from t_dl_fetch");
+	EXPECT_NE(string::npos, result.find("HDFS fetch files: 4, "
+	                                    "concurrently fetched files: 0"));
+	string expected = util.getQueryResultSetString(
+	    "select count(*), sum(a), max(b) from t_dl_fetch");
+	EXPECT_EQ("10000|50005000|row_9999|\n", expected);
+
+	/* more threads than files, and more files than threads */
+	const char *threads[] = {"8", "2"};
+	for (size_t i = 0; i < sizeof(threads) / sizeof(threads[0]); i++) {
+		util.execute(string("set metadata_fetch_max_threads = ") + threads[i]);
+		result = util.getQueryResultSetString(
+		    "explain analyze select count(*) from t_dl_fetch");
+		EXPECT_NE(string::npos, result.find("HDFS fetch files: 4, "
+		                                    "concurrently fetched files: 4"))
+		    << threads[i] << " threads";
+		EXPECT_EQ(expected, util.getQueryResultSetString(
+		    "select count(*), sum(a), max(b) from t_dl_fetch"));
+		util.query("select * from t_dl_fetch where a <= 100", 100);
+	}
+
+	util.execute("drop table t_dl_fetch");
+}
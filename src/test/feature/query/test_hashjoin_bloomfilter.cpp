@@ -15,6 +15,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <cstdio>
+
 #include "gtest/gtest.h"
 #include "lib/command.h"
 #include "lib/hawq_config.h"
@@ -31,6 +33,23 @@ class TestHashJoinBloomFilter: public ::testing::Test
         ~TestHashJoinBloomFilter() {}
 };
 
+// sum the row group counts of all the parquet scans in an explain analyze
+static void countSkippedRowGroups(const string &plan, long long *skipped, long long *total)
+{
+    const string label = "Row groups skipped by statistics: ";
+    *skipped = 0;
+    *total = 0;
+    for (size_t pos = plan.find(label); pos != string::npos;
+         pos = plan.find(label, pos + 1))
+    {
+        long long n = 0, m = 0;
+        ASSERT_EQ(2, sscanf(plan.c_str() + pos + label.size(), "%lld of %lld.", &n, &m))
+            << plan;
+        *skipped += n;
+        *total += m;
+    }
+}
+
 TEST_F(TestHashJoinBloomFilter, BasicTest)
 {
     SQLUtility util;
@@ -48,3 +67,71 @@ TEST_F(TestHashJoinBloomFilter, BasicTest)
     util.execute("drop table dim;");
     util.execute("drop table fact;");
 }
+
+TEST_F(TestHashJoinBloomFilter, BatchProbeTest)
+{
+    SQLUtility util;
+    util.execute("drop table if exists fact;");
+    util.execute("create table fact(c1 int, c2 int, c3 int) WITH(appendonly=true, ORIENTATION=parquet) distributed by (c3);");
+    util.execute("insert into fact select case when i % 7 = 0 then null else i % 5000 end, i % 3, i from generate_series(1, 300000) i;");
+    util.execute("drop table if exists dim;");
+    util.execute("create table dim(c1 int, c2 int, c3 int) distributed by (c1);");
+    util.execute("insert into dim select i * 17, i % 3, i from generate_series(1, 200) i;");
+    util.execute("insert into dim values(null, 1, 0);");
+
+    // the runtime filter probes whole scan batches of the parquet table, the
+    // result must be the same as without it
+    string query = "select count(*), sum(fact.c3) from fact, dim "
+                   "where fact.c1 = dim.c1 and fact.c2 = dim.c2 and dim.c3 < 150;";
+    string expected = util.getQueryResultSetString("set hawq_hashjoin_bloomfilter=false; " + query);
+    string result = util.getQueryResultSetString("set hawq_hashjoin_bloomfilter=true; "
+                                                 "set hawq_hashjoin_bloomfilter_ratio=1.0; " + query);
+    EXPECT_EQ(expected, result);
+    util.execute("drop table dim;");
+    util.execute("drop table fact;");
+}
+
+TEST_F(TestHashJoinBloomFilter, RowGroupSkipTest)
+{
+    SQLUtility util;
+    util.execute("drop table if exists fact;");
+    util.execute("create table fact(c1 int, c2 int) WITH(appendonly=true, ORIENTATION=parquet, "
+                 "pagesize=1024, rowgroupsize=4096) distributed by (c1);");
+    util.execute("insert into fact select i, i % 10 from generate_series(1, 100000) i;");
+    util.execute("insert into fact values(null, 1);");
+    util.execute("drop table if exists dim;");
+    util.execute("create table dim(c1 int, c2 int) distributed by (c1);");
+    util.execute("insert into dim values(10, 1), (20, 2), (50000, 3), (99999, 4), (null, 5);");
+
+    // row groups outside of the min/max of the inner keys or holding none of
+    // the inner key values are skipped, the result must not change
+    string query = "select count(*), sum(fact.c2) from fact, dim where fact.c1 = dim.c1;";
+    string expected = util.getQueryResultSetString("set hawq_hashjoin_bloomfilter=false; " + query);
+    EXPECT_EQ("4|9|\n", expected);
+    string guc = "set hawq_hashjoin_bloomfilter=true; set hawq_hashjoin_bloomfilter_ratio=1.0; ";
+    EXPECT_EQ(expected, util.getQueryResultSetString(guc + query));
+    EXPECT_EQ(expected, util.getQueryResultSetString(
+        guc + "set hawq_hashjoin_runtimefilter_max_values=0; " + query));
+    EXPECT_EQ(expected, util.getQueryResultSetString(
+        guc + "set hawq_hashjoin_runtimefilter_max_values=2; " + query));
+
+    // fact is sorted on c1 and dim holds four keys, so most row groups of
+    // every segment hold none of them
+    string result = util.getQueryResultSetString(
+        guc + "explain analyze " + query);
+    long long skipped = 0, total = 0;
+    countSkippedRowGroups(result, &skipped, &total);
+    EXPECT_GT(skipped, 0) << result;
+    EXPECT_LT(skipped, total) << result;
+
+    // the keys span the whole table, with only their min/max kept the row
+    // groups between them are read
+    string minmax = util.getQueryResultSetString(
+        guc + "set hawq_hashjoin_runtimefilter_max_values=2; explain analyze " + query);
+    long long minmaxSkipped = 0, minmaxTotal = 0;
+    countSkippedRowGroups(minmax, &minmaxSkipped, &minmaxTotal);
+    EXPECT_EQ(total, minmaxTotal) << minmax;
+    EXPECT_LT(minmaxSkipped, skipped) << minmax;
+    util.execute("drop table dim;");
+    util.execute("drop table fact;");
+}
@@ -0,0 +1,64 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "gtest/gtest.h"
+
+#include "lib/sql_util.h"
+
+using hawq::test::SQLUtility;
+using std::string;
+
+class TestInterconnectIncast: public ::testing::Test
+{
+	public:
+		TestInterconnectIncast() {}
+		~TestInterconnectIncast() {}
+};
+
+/*
+ * All the segments send their tuples to the single receiver of the gather
+ * motion at the same time, which overflows the receiver's queues with the
+ * UDP interconnect and drives the congestion control into retransmits.
+ * Every congestion control and pacing setting must deliver the same tuples.
+ */
+TEST_F(TestInterconnectIncast, CongestionControl)
+{
+	SQLUtility util;
+	util.execute("drop table if exists incast;");
+	util.execute("create table incast(c1 int, c2 text) distributed by (c1);");
+	util.execute("insert into incast select i, repeat('x', 100) || i from generate_series(1, 50000) i;");
+
+	const char *settings[] = {
+		"set gp_interconnect_cc_method=reno; set gp_interconnect_pacing=off;",
+		"set gp_interconnect_cc_method=dctcp; set gp_interconnect_pacing=off;",
+		"set gp_interconnect_cc_method=reno; set gp_interconnect_pacing=on;",
+		"set gp_interconnect_cc_method=dctcp; set gp_interconnect_pacing=on;"
+	};
+	const string guc = "set gp_interconnect_type=udp; set gp_interconnect_fc_method=loss; ";
+	/* the limit keeps the aggregate on the master, above the gather motion */
+	const string query = "select count(*), count(distinct c1), sum(length(c2)) "
+		"from (select c1, c2 from incast limit 1000000) t;";
+
+	for (size_t i = 0; i < sizeof(settings) / sizeof(settings[0]); i++)
+		EXPECT_EQ("50000|50000|5238894|\n",
+		          util.getQueryResultSetString(guc + settings[i] + query)) << settings[i];
+
+	util.execSQLFile("query/sql/interconnect-incast.sql",
+	                 "query/ans/interconnect-incast.ans");
+	util.execute("drop table incast;");
+}
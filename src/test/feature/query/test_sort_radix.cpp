@@ -0,0 +1,92 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "lib/sql_util.h"
+
+using hawq::test::SQLUtility;
+using std::string;
+
+class TestSortRadix: public ::testing::Test
+{
+	public:
+		TestSortRadix() {}
+		~TestSortRadix() {}
+};
+
+/*
+ * ORDER BY on each key type the radix sort handles gives the same rows with
+ * gp_enable_mk_radix_sort on and off.  Every order ends in the unique column c
+ * so that the expected order is total.
+ */
+TEST_F(TestSortRadix, BasicTest)
+{
+	SQLUtility util;
+	util.execute("drop table if exists sort_radix;");
+	util.execute("create table sort_radix(a int2, b int4, c int8, d date, e timestamp, "
+		"f text, g char(12)) distributed randomly;");
+	util.execute("insert into sort_radix select (i % 500 - 250)::int2, "
+		"case when i % 97 = 0 then null else (i * 7919) % 20011 - 10000 end, "
+		"(i::int8 * 104729) % 1000003 - 500000, date '2000-01-01' + i % 3000, "
+		"timestamp '2000-01-01' + (i % 5000) * interval '17 minutes', "
+		"case when i % 89 = 0 then null else 'prefix_' || (i % 1000)::text end, "
+		"(i % 300)::text from generate_series(1, 50000) i;");
+
+	const char *orders[] = {
+		"a, b, c", "b, c", "b desc, c", "c", "c desc", "d, a desc, c",
+		"e desc, c", "f, c", "f desc, c", "g, c",
+	};
+	for (size_t i = 0; i < sizeof(orders) / sizeof(orders[0]); i++)
+	{
+		string query = string("select * from sort_radix order by ") + orders[i] + ";";
+		string expected = util.getQueryResultSetString("set gp_enable_mk_radix_sort=off; " + query);
+		string result = util.getQueryResultSetString("set gp_enable_mk_radix_sort=on; " + query);
+		EXPECT_EQ(expected, result) << "order by " << orders[i];
+	}
+
+	util.execute("drop table sort_radix;");
+}
+
+/*
+ * Radix sorts large enough to be split across gp_mk_sort_parallel_workers
+ * threads give the same rows as the single threaded sort.
+ */
+TEST_F(TestSortRadix, ParallelTest)
+{
+	SQLUtility util;
+	util.execute("drop table if exists sort_radix_par;");
+	util.execute("create table sort_radix_par(a int8, b text) distributed randomly;");
+	util.execute("insert into sort_radix_par select (i::int8 * 7919) % 2000003, i::text "
+		"from generate_series(1, 2000000) i;");
+
+	const char *orders[] = {"a", "a desc", "b"};
+	const string settings = "set statement_mem='512MB'; set gp_mk_sort_parallel_workers=";
+	for (size_t i = 0; i < sizeof(orders) / sizeof(orders[0]); i++)
+	{
+		string query = string("select a, b, row_number() over (order by ") + orders[i] +
+			") from sort_radix_par order by 3 limit 10 offset 1000000;";
+		string expected = util.getQueryResultSetString(settings + "0; " + query);
+		string result = util.getQueryResultSetString(settings + "4; " + query);
+		EXPECT_EQ(expected, result) << "order by " << orders[i];
+	}
+
+	util.execute("drop table sort_radix_par;");
+}
@@ -0,0 +1,86 @@
+/*
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#include "gtest/gtest.h"
+
+#include "lib/sql_util.h"
+
+using hawq::test::SQLUtility;
+using std::string;
+
+class TestWorkfileCompress: public ::testing::Test
+{
+	public:
+		TestWorkfileCompress() {}
+		~TestWorkfileCompress() {}
+};
+
+TEST_F(TestWorkfileCompress, BasicTest)
+{
+	SQLUtility util;
+	util.execute("drop table if exists spill_build;");
+	util.execute("drop table if exists spill_probe;");
+	util.execute("create table spill_build(c1 int, c2 text) distributed randomly;");
+	util.execute("create table spill_probe(c1 int, c2 text) distributed randomly;");
+	util.execute("insert into spill_build select i, repeat(md5(i::text), 4) from generate_series(1, 100000) i;");
+	util.execute("insert into spill_probe select i % 100000 + 1, md5(i::text) from generate_series(1, 200000) i;");
+	util.execSQLFile("query/sql/workfile-compress.sql",
+	                 "query/ans/workfile-compress.ans");
+	util.execute("drop table spill_build;");
+	util.execute("drop table spill_probe;");
+}
+
+/*
+ * Force a hash join to spill with each workfile compression algorithm, the
+ * results must be the same as without compression.
+ */
+TEST_F(TestWorkfileCompress, HashJoinSpill)
+{
+	SQLUtility util;
+	util.execute("drop table if exists spill_build;");
+	util.execute("drop table if exists spill_probe;");
+	util.execute("create table spill_build(c1 int, c2 text) distributed randomly;");
+	util.execute("create table spill_probe(c1 int, c2 text) distributed randomly;");
+	util.execute("insert into spill_build select i, repeat(md5(i::text), 8) from generate_series(1, 50000) i;");
+	util.execute("insert into spill_probe select i % 50000 + 1, md5(i::text) from generate_series(1, 100000) i;");
+
+	const char *algorithms[] = {"none", "zlib", "lz4", "snappy"};
+	const string settings = "set hawq_rm_stmt_nvseg=1; set hawq_rm_stmt_vseg_memory='16mb'; "
+		"set gp_workfile_type_hashjoin=bfz; set gp_workfile_compress_algorithm=";
+	const string query = "select count(*), count(distinct b.c1), sum(length(b.c2)), "
+		"sum(length(p.c2)) from spill_build b, spill_probe p where b.c1 = p.c1;";
+
+	/* make sure the join does spill, otherwise nothing is compressed */
+	string plan = util.getQueryResultSetString(settings + "none; explain analyze " + query);
+	size_t pos = plan.find("Workfile: (");
+	ASSERT_NE(string::npos, pos) << plan;
+	EXPECT_GT(atoi(plan.c_str() + pos + strlen("Workfile: (")), 0) << plan;
+
+	string expected = util.getQueryResultSetString(settings + "none; " + query);
+	EXPECT_EQ("100000|50000|25600000|3200000|\n", expected);
+	for (size_t i = 1; i < sizeof(algorithms) / sizeof(algorithms[0]); i++)
+		EXPECT_EQ(expected, util.getQueryResultSetString(settings + algorithms[i] + "; " + query))
+			<< algorithms[i];
+
+	util.execute("drop table spill_build;");
+	util.execute("drop table spill_probe;");
+}
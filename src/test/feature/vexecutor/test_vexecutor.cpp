@@ -220,4 +220,35 @@ TEST_F(TestVexecutor, vagg)
 	util.execute("drop table if exists test_float8");
 };
 
+/*
+ * Gather a table with the row executor and with vectorized motions shipping
+ * TupleBatches, with and without compression, and check the results match.
+ */
+TEST_F(TestVexecutor, motionCompressResult)
+{
+	hawq::test::SQLUtility util;
+
+	util.execute("drop table if exists test_motion");
+	util.execute("create table test_motion(a int4, b int8, c float8) "
+				 "WITH (appendonly = true, orientation = PARQUET) DISTRIBUTED RANDOMLY;");
+	util.execute("insert into test_motion select i, i % 100, i / 7 from generate_series(1, 100000) i;");
+
+	util.execSQLFile("vexecutor/sql/create_type.sql");
+
+	const char *settings[] = {
+		"SET vectorized_executor_enable to off;",
+		"SET vectorized_executor_enable to on; SET vectorized_motion_compress to off;",
+		"SET vectorized_executor_enable to on; SET vectorized_motion_compress to on;"
+	};
+	const std::string query = "SET gp_enable_multiphase_agg to off; "
+		"select count(*), sum(a), sum(b), sum(c) from (select a, b, c from test_motion) t;";
+
+	std::string expected = util.getQueryResultSetString(settings[0] + query);
+	EXPECT_EQ("100000|5000050000|4950000|714250000|\n", expected);
+	for (size_t i = 1; i < sizeof(settings) / sizeof(settings[0]); i++)
+		EXPECT_EQ(expected, util.getQueryResultSetString(settings[i] + query)) << settings[i];
 
+	util.execSQLFile("vexecutor/sql/drop_type.sql");
+
+	util.execute("drop table test_motion");
+};
@@ -0,0 +1,164 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+'''
+datalocality_bench.py [options] tablename
+
+Time the split to virtual segment allocation of the planner on a synthetic
+block layout, without touching HDFS.
+
+The script generates a fake metadata cache file which places every block of
+every segment file of the given append only table on random hosts, and the
+/tmp/aoseg.result file which tells the planner how many segment files the
+table has. It then plans a scan of the table with debug_fake_datalocality on,
+which runs the allocation and aborts the query, and reports the allocation
+time and the data locality ratio written to /tmp/cdbdatalocality.result.
+
+Options:
+    -d database: database to connect to
+    -f files: number of segment files (default 64)
+    -b blocks: number of blocks per segment file (default 16)
+    -s block size: HDFS block size in bytes (default 134217728)
+    -r replicas: number of replicas of each block (default 3)
+    -n rounds: number of runs, each with a new layout (default 3)
+    -S seed: random seed (default 0)
+    -o output: the fake metadata cache file (default /tmp/datalocality_bench.meta)
+'''
+
+import os
+import random
+import re
+import subprocess
+import sys
+from optparse import OptionParser
+
+AOSEG_FILE = '/tmp/aoseg.result'
+RESULT_FILE = '/tmp/cdbdatalocality.result'
+
+
+def psql(database, sql):
+    cmd = ['psql', '-X', '-A', '-t', '-q', '-d', database, '-c', sql]
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    out, err = proc.communicate()
+    return proc.returncode, out.decode(), err.decode()
+
+
+def query(database, sql):
+    rc, out, err = psql(database, sql)
+    if rc != 0:
+        sys.exit('query failed: %s\n%s' % (sql, err))
+    return [line.split('|') for line in out.splitlines() if line]
+
+
+def table_base_path(database, table):
+    '''
+    The HDFS directory of the relation, the same as relpath() in the backend.
+    '''
+    rows = query(database, '''
+        select c.oid, c.relstorage, fe.fselocation, t.oid, d.oid, c.relfilenode
+        from pg_class c, pg_database d, pg_tablespace t, pg_filespace_entry fe
+        where c.oid = '%s'::regclass
+          and d.datname = current_database()
+          and t.oid = case when c.reltablespace = 0 then d.dattablespace
+                           else c.reltablespace end
+          and fe.fsefsoid = t.spcfsoid''' % table)
+    if not rows:
+        sys.exit('cannot find the location of table %s' % table)
+    reloid, relstorage, location, spcoid, dboid, relfilenode = rows[0]
+    if relstorage != 'a':
+        sys.exit('table %s is not an append only row table' % table)
+    return int(reloid), '%s/%s/%s/%s' % (location, spcoid, dboid, relfilenode)
+
+
+def segment_hosts(database):
+    rows = query(database, '''
+        select distinct hostname from gp_segment_configuration
+        where role = 'p' order by 1''')
+    return [row[0] for row in rows]
+
+
+def write_layout(options, reloid, basepath, hosts):
+    replicas = min(options.replicas, len(hosts))
+    with open(options.output, 'w') as f:
+        for segno in range(1, options.files + 1):
+            f.write('filename:%s/%d\n' % (basepath, segno))
+            f.write('fileSize:%d\n' % (options.blocks * options.block_size))
+            f.write('blockSize:%d\n' % options.block_size)
+            for _ in range(options.blocks):
+                f.write(','.join(random.sample(hosts, replicas)) + '\n')
+    with open(AOSEG_FILE, 'w') as f:
+        f.write('%d %d\n' % (reloid, options.files))
+
+
+def run_once(options, table):
+    if os.path.exists(RESULT_FILE):
+        os.remove(RESULT_FILE)
+    sql = ("set metadata_cache_enable = on; "
+           "set debug_fake_datalocality = on; "
+           "set metadata_cache_testfile = '%s'; "
+           "explain select count(*) from %s;" % (options.output, table))
+    rc, out, err = psql(options.database, sql)
+    if 'Abort fake data locality' not in err:
+        sys.exit('unexpected result of the fake allocation:\n%s%s' % (out, err))
+
+    with open(RESULT_FILE) as f:
+        result = f.read()
+    time_us = re.search(r'The time of run_allocation_algorithm is : (\d+) us', result)
+    ratio = re.search(r'datalocality ratio is:([0-9.]+)', result)
+    if not time_us or not ratio:
+        sys.exit('cannot parse %s' % RESULT_FILE)
+    return int(time_us.group(1)), float(ratio.group(1))
+
+
+def main():
+    parser = OptionParser(usage=__doc__)
+    parser.add_option('-d', dest='database', default=os.environ.get('PGDATABASE', 'postgres'))
+    parser.add_option('-f', dest='files', type='int', default=64)
+    parser.add_option('-b', dest='blocks', type='int', default=16)
+    parser.add_option('-s', dest='block_size', type='int', default=134217728)
+    parser.add_option('-r', dest='replicas', type='int', default=3)
+    parser.add_option('-n', dest='rounds', type='int', default=3)
+    parser.add_option('-S', dest='seed', type='int', default=0)
+    parser.add_option('-o', dest='output', default='/tmp/datalocality_bench.meta')
+    options, args = parser.parse_args()
+    if len(args) != 1:
+        parser.error('a table name is required')
+    table = args[0]
+
+    random.seed(options.seed)
+    reloid, basepath = table_base_path(options.database, table)
+    hosts = segment_hosts(options.database)
+    if not hosts:
+        sys.exit('no segment host found')
+
+    print('table %s: %d files x %d blocks on %d hosts, %d replicas' %
+          (table, options.files, options.blocks, len(hosts),
+           min(options.replicas, len(hosts))))
+    times = []
+    for i in range(options.rounds):
+        write_layout(options, reloid, basepath, hosts)
+        time_us, ratio = run_once(options, table)
+        times.append(time_us)
+        print('round %d: allocation %d us, data locality ratio %.3f' % (i + 1, time_us, ratio))
+    times.sort()
+    print('median allocation time: %d us' % times[len(times) // 2])
+
+
+if __name__ == '__main__':
+    main()
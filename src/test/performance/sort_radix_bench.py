@@ -0,0 +1,121 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+'''
+sort_radix_bench.py [options]
+
+Time an in-memory sort with the normalized key radix sort and with mkqsort.
+
+The script creates the sort_radix_bench table with a random int8 column c1
+and a text column c2, sorts it on each of them with gp_enable_mk_radix_sort
+off and on, checks that both return the same result and reports the median
+elapsed time of each. The table is dropped at the end unless -k is given.
+
+Options:
+    -d database: database to connect to
+    -r rows: number of rows (default 10000000)
+    -m memory: statement_mem of the sorts (default 2GB)
+    -w workers: gp_mk_sort_parallel_workers (default 0)
+    -n rounds: number of runs of each sort (default 3)
+    -k: keep the table
+'''
+
+import os
+import subprocess
+import sys
+import time
+from optparse import OptionParser
+
+KEYS = ['c1', 'c2']
+
+
+def psql(database, sql):
+    cmd = ['psql', '-X', '-A', '-t', '-q', '-d', database, '-c', sql]
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    out, err = proc.communicate()
+    return proc.returncode, out.decode(), err.decode()
+
+
+def execute(database, sql):
+    rc, out, err = psql(database, sql)
+    if rc != 0:
+        sys.exit('query failed: %s\n%s' % (sql, err))
+    return out
+
+
+def create_table(options):
+    execute(options.database, '''
+        drop table if exists sort_radix_bench;
+        create table sort_radix_bench(c1 int8, c2 text) distributed randomly;
+        insert into sort_radix_bench select (random() * 1e12)::int8, md5(i::text)
+            from generate_series(1, %d) i;''' % options.rows)
+
+
+def run_once(options, key, radix):
+    sql = ("set statement_mem = '%s'; "
+           "set gp_mk_sort_parallel_workers = %d; "
+           "set gp_enable_mk_radix_sort = %s; "
+           "select count(*), min(k), max(k) from "
+           "(select %s as k from sort_radix_bench order by %s offset 1) t;" %
+           (options.memory, options.workers, 'on' if radix else 'off', key, key))
+    start = time.time()
+    result = execute(options.database, sql).strip()
+    return int((time.time() - start) * 1000), result
+
+
+def median(times):
+    times.sort()
+    return times[len(times) // 2]
+
+
+def main():
+    parser = OptionParser(usage=__doc__)
+    parser.add_option('-d', dest='database', default=os.environ.get('PGDATABASE', 'postgres'))
+    parser.add_option('-r', dest='rows', type='int', default=10000000)
+    parser.add_option('-m', dest='memory', default='2GB')
+    parser.add_option('-w', dest='workers', type='int', default=0)
+    parser.add_option('-n', dest='rounds', type='int', default=3)
+    parser.add_option('-k', dest='keep', action='store_true', default=False)
+    options, args = parser.parse_args()
+    if args:
+        parser.error('unexpected arguments: %s' % ' '.join(args))
+
+    print('sort_radix_bench: %d rows, statement_mem %s, %d workers' %
+          (options.rows, options.memory, options.workers))
+    create_table(options)
+
+    for key in KEYS:
+        times = {False: [], True: []}
+        results = set()
+        for _ in range(options.rounds):
+            for radix in (False, True):
+                time_ms, result = run_once(options, key, radix)
+                times[radix].append(time_ms)
+                results.add(result)
+        if len(results) != 1:
+            sys.exit('order by %s returns different results: %s' % (key, sorted(results)))
+        print('order by %s: mkqsort median %d ms, radix median %d ms' %
+              (key, median(times[False]), median(times[True])))
+
+    if not options.keep:
+        execute(options.database, 'drop table sort_radix_bench;')
+
+
+if __name__ == '__main__':
+    main()
@@ -0,0 +1,132 @@
+#!/usr/bin/env python
+# -*- coding: utf-8 -*-
+# Licensed to the Apache Software Foundation (ASF) under one
+# or more contributor license agreements.  See the NOTICE file
+# distributed with this work for additional information
+# regarding copyright ownership.  The ASF licenses this file
+# to you under the Apache License, Version 2.0 (the
+# "License"); you may not use this file except in compliance
+# with the License.  You may obtain a copy of the License at
+#
+#   http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing,
+# software distributed under the License is distributed on an
+# "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+# KIND, either express or implied.  See the License for the
+# specific language governing permissions and limitations
+# under the License.
+
+'''
+workfile_compress_bench.py [options]
+
+Time a spilling hash join with each workfile compression algorithm.
+
+The script creates the spill_bench_build and spill_bench_probe tables, runs
+the same join with gp_workfile_compress_algorithm set to none, zlib, lz4 and
+snappy, checks that every algorithm returns the same result and reports the
+median elapsed time of each algorithm. The tables are dropped at the end
+unless -k is given.
+
+Options:
+    -d database: database to connect to
+    -r rows: number of rows of the build side (default 2000000)
+    -w width: number of md5 strings in each build row (default 8)
+    -s nvseg: number of virtual segments (default 2)
+    -m memory: memory of each virtual segment (default 64mb)
+    -n rounds: number of runs of each algorithm (default 3)
+    -k: keep the tables
+'''
+
+import os
+import subprocess
+import sys
+import time
+from optparse import OptionParser
+
+ALGORITHMS = ['none', 'zlib', 'lz4', 'snappy']
+
+
+def psql(database, sql):
+    cmd = ['psql', '-X', '-A', '-t', '-q', '-d', database, '-c', sql]
+    proc = subprocess.Popen(cmd, stdout=subprocess.PIPE, stderr=subprocess.PIPE)
+    out, err = proc.communicate()
+    return proc.returncode, out.decode(), err.decode()
+
+
+def execute(database, sql):
+    rc, out, err = psql(database, sql)
+    if rc != 0:
+        sys.exit('query failed: %s\n%s' % (sql, err))
+    return out
+
+
+def create_tables(options):
+    execute(options.database, '''
+        drop table if exists spill_bench_build;
+        drop table if exists spill_bench_probe;
+        create table spill_bench_build(c1 int, c2 text) distributed randomly;
+        create table spill_bench_probe(c1 int, c2 text) distributed randomly;
+        insert into spill_bench_build
+            select i, repeat(md5(i::text), %d) from generate_series(1, %d) i;
+        insert into spill_bench_probe
+            select i %% %d + 1, md5(i::text) from generate_series(1, %d) i;''' %
+        (options.width, options.rows, options.rows, 2 * options.rows))
+
+
+def drop_tables(options):
+    execute(options.database, '''
+        drop table spill_bench_build;
+        drop table spill_bench_probe;''')
+
+
+def run_once(options, algorithm):
+    sql = ("set hawq_rm_stmt_nvseg = %d; "
+           "set hawq_rm_stmt_vseg_memory = '%s'; "
+           "set gp_workfile_type_hashjoin = bfz; "
+           "set gp_workfile_compress_algorithm = %s; "
+           "select count(*), sum(length(b.c2)) "
+           "from spill_bench_build b, spill_bench_probe p where b.c1 = p.c1;" %
+           (options.nvseg, options.memory, algorithm))
+    start = time.time()
+    result = execute(options.database, sql).strip()
+    return int((time.time() - start) * 1000), result
+
+
+def main():
+    parser = OptionParser(usage=__doc__)
+    parser.add_option('-d', dest='database', default=os.environ.get('PGDATABASE', 'postgres'))
+    parser.add_option('-r', dest='rows', type='int', default=2000000)
+    parser.add_option('-w', dest='width', type='int', default=8)
+    parser.add_option('-s', dest='nvseg', type='int', default=2)
+    parser.add_option('-m', dest='memory', default='64mb')
+    parser.add_option('-n', dest='rounds', type='int', default=3)
+    parser.add_option('-k', dest='keep', action='store_true', default=False)
+    options, args = parser.parse_args()
+    if args:
+        parser.error('unexpected arguments: %s' % ' '.join(args))
+
+    print('build side %d rows x %d bytes, %d vsegs with %s each' %
+          (options.rows, 32 * options.width, options.nvseg, options.memory))
+    create_tables(options)
+
+    expected = None
+    for algorithm in ALGORITHMS:
+        times = []
+        for _ in range(options.rounds):
+            time_ms, result = run_once(options, algorithm)
+            if expected is None:
+                expected = result
+            elif result != expected:
+                sys.exit('%s returns %s, expected %s' % (algorithm, result, expected))
+            times.append(time_ms)
+        times.sort()
+        print('%-8s median %d ms, min %d ms, max %d ms' %
+              (algorithm, times[len(times) // 2], times[0], times[-1]))
+
+    if not options.keep:
+        drop_tables(options)
+
+
+if __name__ == '__main__':
+    main()